@@ -55,9 +55,9 @@ Urt_SETUP_t gUrt1Setup = {
 	.stickParityEn = 0,
 	.loopback = 0,
 	//----------- FIFO ------------
-	.fifoEn = 0,
+	.fifoEn = 1,	// 16-byte Rx FIFO drained by Rx interrupt into ring buffer
 	.fifoIntTrigger = ENUM_UART_FCR_RFTRIG_BYTE8,
-	.fifoDmaMode = 0,
+	.fifoDmaMode = 1,	// Tx DMA request while Tx FIFO has space
 	//--------- Interrupt -----------
 	.rxBufFullIntEn = 1, // Enabled
 	.txIntEn = 0,
@@ -65,7 +65,7 @@ Urt_SETUP_t gUrt1Setup = {
 	.modemIntEn = 0,
 	//---------- Dma ------------
 	.rxDmaEn = 0,
-	.txDmaEn = 0,
+	.txDmaEn = 1,	// Bulk Tx (IIO buffer data) is transferred by DMA
 };
 
 
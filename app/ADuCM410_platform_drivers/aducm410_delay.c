@@ -15,47 +15,58 @@
 /******************************************************************************/
 
 #include "delay.h"
-#include "GptLib.h"
+#include "ADuCM410.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
-/* Default system clock frequency in Hz */
-#define SYSTEM_CLOCK	160000000
-
-/* Clock prescaler used for generating timer based usec delay */
-#define CLOCK_PRESCALER	16
+#define USEC_PER_MSEC	1000
+#define USEC_PER_SEC	1000000
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
 /**
- * @brief Generate microseconds delay using general timer0
+ * @brief Generate microseconds delay using the SysTick timer.
  * @param usecs - Delay in microseconds.
  * @return None.
- * @note  The delay is based on the default system clock frequency of 160Mhz
- *        The delay may not be correct if using system frequenct other than
- *        160Mhz
+ * @note  The SysTick (configured for system tick in aducm410_system_init())
+ *        is free running, so the elapsed core clock cycles are counted across
+ *        its reloads, for any length of delay. The delay is based on the
+ *        current core clock frequency (SystemCoreClock). It can only be
+ *        longer than requested if preempted for more than a SysTick period.
  */
 void udelay(uint32_t usecs)
 {
-	uint16_t reload;
+	uint32_t cycles_per_usec = SystemCoreClock / USEC_PER_SEC;
+	uint32_t reload = SysTick->LOAD + 1;
+	uint32_t last = SysTick->VAL;
+	uint32_t cycles = 0;
+	uint32_t elapsed_usecs;
+	uint32_t now;
 
-	reload = usecs * (SYSTEM_CLOCK  / 1000000 / CLOCK_PRESCALER);
+	/* SysTick is not yet running (delay before system init), use a rough
+	 * loop count (few core clock cycles per iteration) instead */
+	if (!(SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)) {
+		for (volatile uint32_t i = 0; i < (usecs * (cycles_per_usec / 4)); i++);
+		return;
+	}
 
-	pADI_GPT0->CON &= (~BITM_TMR_CON_ENABLE);	// disable timer0
-	pADI_GPT0->LD = reload;						// reload the timer0value
+	while (usecs) {
+		/* SysTick counts down from LOAD to 0 */
+		now = SysTick->VAL;
+		cycles += (now <= last) ? (last - now) : (last + reload - now);
+		last = now;
 
-	/* config and enable timer0 */
-	pADI_GPT0->CON = ((ENUM_TMR_CON_CLK_HCLK << BITP_TMR_CON_CLK) | \
-			  ENUM_TMR_CON_PRE_DIV16 |\
-			  BITM_TMR_CON_ENABLE |\
-			  (ENUM_TMR_CON_MOD_PERIODIC << BITP_TMR_CON_MOD));
+		elapsed_usecs = cycles / cycles_per_usec;
+		if (elapsed_usecs >= usecs)
+			break;
 
-	while (!(pADI_GPT0->STA & BITM_TMR_STA_TMOUT));
-	pADI_GPT0->CLRI = 1;	// clear timeout status flag
+		usecs -= elapsed_usecs;
+		cycles -= elapsed_usecs * cycles_per_usec;
+	}
 }
 
 /**
@@ -65,9 +76,6 @@ void udelay(uint32_t usecs)
  */
 void mdelay(uint32_t msecs)
 {
-	if (msecs) {
-		// NOTE: using a for loop, to limit hardware usage requirements
-		// The value X * msecs is based on default eval board clock/config
-		for(volatile uint32_t i = 0; i < (13400 * msecs); i++);
-	}
+	while (msecs--)
+		udelay(USEC_PER_MSEC);
 }
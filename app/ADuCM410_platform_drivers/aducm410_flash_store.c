@@ -0,0 +1,458 @@
+/***************************************************************************//**
+ * @file  aducm410_flash_store.c
+ * @brief Implementation of wear levelled data store in ADuCM410 flash
+ * @details The first two pages of the reserved region are logs of 64-bit
+ *          entries, used in turn (ping-pong). An entry is appended to the
+ *          active log on every store:
+ *              [63:56] magic, [55:48] data page, [47:32] length,
+ *              [31:0] flash signature (FEESIG) of the data page
+ *          The first word of a log page holds its generation, the active log
+ *          is the one with the latest generation. When the active log is
+ *          full, the entry is logged into the other (erased) log page with
+ *          the next generation first, and only then the full log is erased,
+ *          so a logged block is never lost by a reset/power loss.
+ *          The data block is programmed into the data page following the one
+ *          of the last entry, so that the page erases are spread over all the
+ *          data pages and the latest valid block is never erased by a store.
+ *          On load, the logs are scanned backwards (newest first) and the
+ *          first entry whose data page signature (recomputed by the flash
+ *          controller) matches is used, so a block interrupted by a
+ *          reset/power loss is skipped
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include "ADuCM410.h"
+#include "FeeLib.h"
+
+#include "aducm410_flash_store.h"
+#include "delay.h"
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Log pages and data pages */
+#define FLASH_STORE_LOG_PAGES		2
+#define FLASH_STORE_LOG_ADDR(log)	(FLASH_STORE_START + \
+					 (log) * FLASH_STORE_PAGE_SIZE)
+#define FLASH_STORE_DATA_PAGES		(FLASH_STORE_PAGES - FLASH_STORE_LOG_PAGES)
+#define FLASH_STORE_DATA_ADDR(page)	(FLASH_STORE_START + \
+					 ((page) + FLASH_STORE_LOG_PAGES) * FLASH_STORE_PAGE_SIZE)
+
+/* Log entries following the log header (flash is programmed in 64-bit words) */
+#define FLASH_STORE_LOG_ENTRIES		(FLASH_STORE_PAGE_SIZE / sizeof(uint64_t) - 1)
+#define FLASH_STORE_LOG_MAGIC		0x5A
+#define FLASH_STORE_ERASED			0xFFFFFFFFFFFFFFFFull
+
+/* Log header: [63:56] magic, [31:0] generation */
+#define FLASH_STORE_HDR_MAGIC		0xA5
+#define FLASH_STORE_HDR(gen)		(((uint64_t)FLASH_STORE_HDR_MAGIC << 56) | (gen))
+#define FLASH_STORE_HDR_VALID(hdr)	((uint8_t)((hdr) >> 56) == FLASH_STORE_HDR_MAGIC)
+#define FLASH_STORE_HDR_GEN(hdr)	((uint32_t)(hdr))
+
+#define FLASH_STORE_ENTRY(page, len, sig)	(((uint64_t)FLASH_STORE_LOG_MAGIC << 56) | \
+		((uint64_t)(page) << 48) | ((uint64_t)(len) << 32) | (sig))
+#define FLASH_STORE_ENTRY_MAGIC(entry)	((uint8_t)((entry) >> 56))
+#define FLASH_STORE_ENTRY_PAGE(entry)	((uint8_t)((entry) >> 48))
+#define FLASH_STORE_ENTRY_LEN(entry)	((uint16_t)((entry) >> 32))
+#define FLASH_STORE_ENTRY_SIG(entry)	((uint32_t)(entry))
+
+/* Max time for a flash command to complete (page erase is the longest) */
+#define FLASH_STORE_TIMEOUT_USEC	100000
+
+#if (FLASH_STORE_PAGES < (FLASH_STORE_LOG_PAGES + 2))
+#error "Flash store needs 2 log pages and at least 2 data pages"
+#endif
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief	Wait for the flash command in progress to complete
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t aducm410_flash_store_wait(void)
+{
+	uint32_t status;
+
+	for (uint32_t timeout = FLASH_STORE_TIMEOUT_USEC; timeout; timeout--) {
+		status = FeeSta();
+		if (!(status & BITM_FLASH_FEESTA_CMDBUSY)) {
+			if (status & (BITM_FLASH_FEESTA_CMDFAIL |
+				      BITM_FLASH_FEESTA_ECCERRCMD)) {
+				return -EIO;
+			}
+
+			return SUCCESS;
+		}
+
+		udelay(1);
+	}
+
+	return -ETIMEDOUT;
+}
+
+/**
+ * @brief	Erase a flash page
+ * @param	addr[in] - Page address
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t aducm410_flash_store_erase_page(uint32_t addr)
+{
+	if (!FeePErs(addr)) {
+		return -EBUSY;
+	}
+
+	return aducm410_flash_store_wait();
+}
+
+/**
+ * @brief	Program a 64-bit flash word
+ * @param	addr[in] - Word address (8 byte aligned, erased)
+ * @param	word[in] - Word to be programmed
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t aducm410_flash_store_program(uint32_t addr, uint64_t word)
+{
+	if (!FeeWr(addr, word)) {
+		return -EBUSY;
+	}
+
+	return aducm410_flash_store_wait();
+}
+
+/**
+ * @brief	Compute the flash signature of a page
+ * @param	addr[in] - Page address
+ * @param	sig[out] - Flash signature
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t aducm410_flash_store_sign(uint32_t addr, uint32_t *sig)
+{
+	int32_t ret;
+
+	if (!FeeSign(addr, addr)) {
+		return -EBUSY;
+	}
+
+	ret = aducm410_flash_store_wait();
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	*sig = FeeSig();
+
+	return SUCCESS;
+}
+
+/**
+ * @brief	Get the log page
+ * @param	log[in] - Log page number
+ * @return	Log page (header followed by the entries)
+ */
+static const volatile uint64_t *aducm410_flash_store_log(uint32_t log)
+{
+	return (const volatile uint64_t *)FLASH_STORE_LOG_ADDR(log);
+}
+
+/**
+ * @brief	Get the active log page (latest generation)
+ * @return	Active log page number, FLASH_STORE_LOG_PAGES if no log is valid
+ */
+static uint32_t aducm410_flash_store_active_log(void)
+{
+	uint64_t hdr0 = aducm410_flash_store_log(0)[0];
+	uint64_t hdr1 = aducm410_flash_store_log(1)[0];
+
+	if (!FLASH_STORE_HDR_VALID(hdr0)) {
+		return FLASH_STORE_HDR_VALID(hdr1) ? 1 : FLASH_STORE_LOG_PAGES;
+	}
+
+	if (FLASH_STORE_HDR_VALID(hdr1) &&
+	    (int32_t)(FLASH_STORE_HDR_GEN(hdr1) - FLASH_STORE_HDR_GEN(hdr0)) > 0) {
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief	Get the number of entries in a log page
+ * @param	log[in] - Log page number
+ * @return	Number of entries (index of the first erased entry)
+ */
+static uint32_t aducm410_flash_store_log_entries(uint32_t log)
+{
+	const volatile uint64_t *entry = aducm410_flash_store_log(log) + 1;
+	uint32_t entries = 0;
+
+	if (!FLASH_STORE_HDR_VALID(aducm410_flash_store_log(log)[0])) {
+		return 0;
+	}
+
+	while (entries < FLASH_STORE_LOG_ENTRIES &&
+	       entry[entries] != FLASH_STORE_ERASED) {
+		entries++;
+	}
+
+	return entries;
+}
+
+/**
+ * @brief	Check if a page is erased
+ * @param	addr[in] - Page address
+ * @return	true if all the page words are erased, else false
+ */
+static bool aducm410_flash_store_is_erased(uint32_t addr)
+{
+	const volatile uint64_t *word = (const volatile uint64_t *)addr;
+
+	for (uint32_t i = 0; i < FLASH_STORE_PAGE_SIZE / sizeof(uint64_t); i++) {
+		if (word[i] != FLASH_STORE_ERASED) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Get the last logged entry
+ * @param	active[in] - Active log page number
+ * @param	entry[out] - Last entry
+ * @return	true if an entry is logged, else false
+ * @note	The active log is empty only if a store was interrupted after
+ *			starting it, the other log then still holds the last entry
+ */
+static bool aducm410_flash_store_last_entry(uint32_t active, uint64_t *entry)
+{
+	uint32_t entries;
+
+	for (uint32_t i = 0; i < FLASH_STORE_LOG_PAGES; i++) {
+		entries = aducm410_flash_store_log_entries(active);
+		if (entries) {
+			*entry = aducm410_flash_store_log(active)[entries];
+			return true;
+		}
+
+		active = (active + 1) % FLASH_STORE_LOG_PAGES;
+	}
+
+	return false;
+}
+
+/**
+ * @brief	Store a data block into flash
+ * @param	data[in] - Data block
+ * @param	len[in] - Length of data block in bytes
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ * @note	The previously stored block is kept until the new one is logged,
+ *			and a log page is erased only once its entries are superseded
+ */
+int32_t aducm410_flash_store_write(const void *data, uint32_t len)
+{
+	const uint8_t *pdata = data;
+	uint32_t active;
+	uint32_t other;
+	uint32_t entries;
+	uint32_t gen = 0;
+	uint32_t page = 0;
+	uint32_t addr;
+	uint32_t sig;
+	uint64_t entry;
+	uint64_t word;
+	int32_t ret;
+
+	if (!data || !len || len > FLASH_STORE_MAX_SIZE) {
+		return -EINVAL;
+	}
+
+	active = aducm410_flash_store_active_log();
+	if (active == FLASH_STORE_LOG_PAGES) {
+		/* No log yet, started below as if log 0 was full */
+		active = 0;
+		entries = FLASH_STORE_LOG_ENTRIES;
+	} else {
+		gen = FLASH_STORE_HDR_GEN(aducm410_flash_store_log(active)[0]);
+		entries = aducm410_flash_store_log_entries(active);
+
+		/* Next data page after the last logged one */
+		if (aducm410_flash_store_last_entry(active, &entry)) {
+			page = (FLASH_STORE_ENTRY_PAGE(entry) + 1) % FLASH_STORE_DATA_PAGES;
+		}
+	}
+
+	addr = FLASH_STORE_DATA_ADDR(page);
+	ret = aducm410_flash_store_erase_page(addr);
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	/* Program the block (tail of last word left erased) */
+	for (uint32_t offset = 0; offset < len; offset += sizeof(word)) {
+		word = FLASH_STORE_ERASED;
+		memcpy(&word, &pdata[offset],
+		       (len - offset) < sizeof(word) ? (len - offset) : sizeof(word));
+
+		if (word != FLASH_STORE_ERASED) {
+			ret = aducm410_flash_store_program(addr + offset, word);
+			if (ret != SUCCESS) {
+				return ret;
+			}
+		}
+	}
+
+	if (memcmp((const void *)addr, data, len)) {
+		return -EIO;
+	}
+
+	ret = aducm410_flash_store_sign(addr, &sig);
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	entry = FLASH_STORE_ENTRY(page, len, sig);
+	other = (active + 1) % FLASH_STORE_LOG_PAGES;
+
+	if (entries < FLASH_STORE_LOG_ENTRIES) {
+		ret = aducm410_flash_store_program(FLASH_STORE_LOG_ADDR(active) +
+						   (entries + 1) * sizeof(uint64_t), entry);
+		if (ret != SUCCESS) {
+			return ret;
+		}
+
+		/* Other log is superseded, complete its erase if interrupted */
+		if (!aducm410_flash_store_is_erased(FLASH_STORE_LOG_ADDR(other))) {
+			return aducm410_flash_store_erase_page(FLASH_STORE_LOG_ADDR(other));
+		}
+
+		return SUCCESS;
+	}
+
+	/* Active log full (or no log yet), log into the other one first */
+	if (!aducm410_flash_store_is_erased(FLASH_STORE_LOG_ADDR(other))) {
+		ret = aducm410_flash_store_erase_page(FLASH_STORE_LOG_ADDR(other));
+		if (ret != SUCCESS) {
+			return ret;
+		}
+	}
+
+	ret = aducm410_flash_store_program(FLASH_STORE_LOG_ADDR(other),
+					   FLASH_STORE_HDR(gen + 1));
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	ret = aducm410_flash_store_program(FLASH_STORE_LOG_ADDR(other) +
+					   sizeof(uint64_t), entry);
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	/* Full log is superseded only now */
+	if (!aducm410_flash_store_is_erased(FLASH_STORE_LOG_ADDR(active))) {
+		return aducm410_flash_store_erase_page(FLASH_STORE_LOG_ADDR(active));
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief	Load the latest valid data block from flash
+ * @param	data[out] - Data block
+ * @param	max_len[in] - Size of data buffer in bytes
+ * @param	len[out] - Length of data block in bytes
+ * @return	SUCCESS in case of success, -ENOENT if no valid block is stored,
+ *			negative error code otherwise.
+ */
+int32_t aducm410_flash_store_read(void *data, uint32_t max_len,
+				  uint32_t *len)
+{
+	const volatile uint64_t *log;
+	uint32_t log_page;
+	uint32_t entries;
+	uint32_t checked = 0;
+	uint32_t sig;
+	uint64_t entry;
+	int32_t ret;
+
+	if (!data || !len) {
+		return -EINVAL;
+	}
+
+	log_page = aducm410_flash_store_active_log();
+	if (log_page == FLASH_STORE_LOG_PAGES) {
+		return -ENOENT;
+	}
+
+	/* Active log first, then the other (older) one. Only the pages of last
+	 * FLASH_STORE_DATA_PAGES entries can be intact */
+	for (uint32_t i = 0; i < FLASH_STORE_LOG_PAGES; i++) {
+		log = aducm410_flash_store_log(log_page) + 1;
+		entries = aducm410_flash_store_log_entries(log_page);
+
+		while (entries-- && checked < FLASH_STORE_DATA_PAGES) {
+			entry = log[entries];
+			if (FLASH_STORE_ENTRY_MAGIC(entry) != FLASH_STORE_LOG_MAGIC ||
+			    FLASH_STORE_ENTRY_PAGE(entry) >= FLASH_STORE_DATA_PAGES ||
+			    !FLASH_STORE_ENTRY_LEN(entry) ||
+			    FLASH_STORE_ENTRY_LEN(entry) > FLASH_STORE_MAX_SIZE) {
+				continue;
+			}
+
+			checked++;
+			ret = aducm410_flash_store_sign(FLASH_STORE_DATA_ADDR(
+								FLASH_STORE_ENTRY_PAGE(entry)), &sig);
+			if (ret != SUCCESS || sig != FLASH_STORE_ENTRY_SIG(entry)) {
+				continue;
+			}
+
+			if (FLASH_STORE_ENTRY_LEN(entry) > max_len) {
+				return -ENOMEM;
+			}
+
+			*len = FLASH_STORE_ENTRY_LEN(entry);
+			memcpy(data, (const void *)FLASH_STORE_DATA_ADDR(
+				       FLASH_STORE_ENTRY_PAGE(entry)), *len);
+
+			return SUCCESS;
+		}
+
+		log_page = (log_page + 1) % FLASH_STORE_LOG_PAGES;
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * @brief	Discard the stored data block
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ * @note	Only the log pages are erased, the data pages are erased when reused
+ */
+int32_t aducm410_flash_store_erase(void)
+{
+	int32_t ret;
+
+	for (uint32_t log = 0; log < FLASH_STORE_LOG_PAGES; log++) {
+		ret = aducm410_flash_store_erase_page(FLASH_STORE_LOG_ADDR(log));
+		if (ret != SUCCESS) {
+			return ret;
+		}
+	}
+
+	return SUCCESS;
+}
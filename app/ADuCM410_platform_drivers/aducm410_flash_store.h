@@ -0,0 +1,53 @@
+/***************************************************************************//**
+ *   @file     aducm410_flash_store.h
+ *   @brief:   Header for wear levelled data store in ADuCM410 flash
+ *   @details: A data block (e.g. serialized configuration) is kept in a
+ *             flash region reserved in the linker file (ADuCM410flash.icf).
+ *             Every store programs the block into the next data page of the
+ *             region and appends its flash signature to the active one of two
+ *             log pages, so that the latest block is found and verified on
+ *             load
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef ADUCM410_FLASH_STORE_H
+#define ADUCM410_FLASH_STORE_H
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Flash page size */
+#define FLASH_STORE_PAGE_SIZE		0x2000
+
+/* Reserved flash region (must match FLASH_STORE_START/FLASH_STORE_SIZE in
+ * ADuCM410flash.icf). Two log pages followed by the data pages. The last page
+ * of the flash blocks (protection and FA keys) must be kept out of it */
+#define FLASH_STORE_START			0x36000
+#define FLASH_STORE_PAGES			4
+
+/* Max size of the stored data block */
+#define FLASH_STORE_MAX_SIZE		FLASH_STORE_PAGE_SIZE
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+int32_t aducm410_flash_store_write(const void *data, uint32_t len);
+int32_t aducm410_flash_store_read(void *data, uint32_t max_len,
+				  uint32_t *len);
+int32_t aducm410_flash_store_erase(void);
+
+#endif /* ADUCM410_FLASH_STORE_H */
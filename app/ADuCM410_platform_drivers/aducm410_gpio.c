@@ -20,7 +20,18 @@
 
 #include "gpio.h"
 #include "aducm410_gpio.h"
+#include "gpio_fast.h"
 #include "error.h"
+#include "desc_pool.h"
+
+/******************************************************************************/
+/********************** Variables and User defined data types *****************/
+/******************************************************************************/
+
+/* Static pools of gpio descriptors */
+DESC_POOL_DEFINE(gpio_desc_pool, gpio_desc, GPIO_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(aducm410_gpio_desc_pool, aducm410_gpio_desc,
+		 GPIO_DESC_POOL_SIZE);
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -39,15 +50,16 @@ int32_t gpio_get(struct gpio_desc **desc, const struct gpio_init_param *param)
 	}
 
 	/* Create a new gpio descriptor */
-	gpio_desc *new_gpio = (gpio_desc *)calloc(1, sizeof(gpio_desc)) ;
+	gpio_desc *new_gpio = (gpio_desc *)desc_pool_alloc(&gpio_desc_pool);
 	if (!new_gpio) {
 		return FAILURE;
 	}
 
 	/* Create a new aducm410 gpio descriptor for platform specific parameters */
-	aducm410_gpio_desc *aducm410_new_desc = (aducm410_gpio_desc *)calloc(1,
-						sizeof(aducm410_gpio_desc)) ;
+	aducm410_gpio_desc *aducm410_new_desc = (aducm410_gpio_desc *)desc_pool_alloc(
+			&aducm410_gpio_desc_pool);
 	if (!aducm410_new_desc) {
+		desc_pool_free(&gpio_desc_pool, new_gpio);
 		return FAILURE;
 	}
 
@@ -104,12 +116,10 @@ int32_t gpio_remove(struct gpio_desc *desc)
 	}
 
 	/* Free the aducm410 gpio descriptor */
-	if ((aducm410_gpio_desc *)(desc->extra)) {
-		free((aducm410_gpio_desc *)(desc->extra));
-	}
+	desc_pool_free(&aducm410_gpio_desc_pool, desc->extra);
 
 	/* Free the gpio descriptor */
-	free(desc);
+	desc_pool_free(&gpio_desc_pool, desc);
 
 	return SUCCESS;
 }
@@ -250,9 +260,6 @@ int32_t gpio_set_value(struct gpio_desc *desc, uint8_t value)
 int32_t gpio_get_value(struct gpio_desc *desc, uint8_t *value)
 {
 	aducm410_gpio_desc *aducm410_new_desc;    // pointer to aducm410 gpio desc
-	uint8_t gpio_val;
-	uint8_t bit_shift_cnt = 0;
-	uint8_t mask;
 
 	if (!desc || !desc->extra) {
 		return FAILURE;
@@ -260,18 +267,39 @@ int32_t gpio_get_value(struct gpio_desc *desc, uint8_t *value)
 
 	aducm410_new_desc = (aducm410_gpio_desc *)(desc->extra);
 
-	/* Read the GPIO port */
-	gpio_val = DioRd((ADI_GPIO_TypeDef *)aducm410_new_desc->gpio_port);
+	/* Read the GPIO port and extract the pin value */
+	*value = (DioRd((ADI_GPIO_TypeDef *)aducm410_new_desc->gpio_port) &
+		  aducm410_new_desc->pin_mask) ? GPIO_HIGH : GPIO_LOW;
 
-	/* Mask and extract the pin value */
-	mask = aducm410_new_desc->pin_mask;
-	while (mask != 0x1) {
-		bit_shift_cnt++;
-		mask >>= 1;
+	return SUCCESS;
+}
+
+/**
+ * @brief Cache the port registers and mask of GPIO for fast access.
+ * @param pin - The fast GPIO pin.
+ * @param desc - The GPIO descriptor (configured with gpio_get() and
+ *               gpio_direction_input/output()).
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t gpio_fast_get(struct gpio_fast_pin *pin, struct gpio_desc *desc)
+{
+	if (!pin || !desc || !desc->extra) {
+		return FAILURE;
 	}
 
-	/* Get the pin value (shifted to LSB) from GPIO port */
-	*value = (gpio_val >> bit_shift_cnt) & 0x1;
+	pin->port = (ADI_GPIO_TypeDef *)((aducm410_gpio_desc *)(desc->extra))->gpio_port;
+	pin->mask = (uint8_t)((aducm410_gpio_desc *)(desc->extra))->pin_mask;
 
 	return SUCCESS;
 }
+
+/**
+ * @brief Convert the time to core clock cycles for gpio_fast_delay_cycles().
+ * @param ns - Time in nsec.
+ * @return Number of core clock cycles (rounded up).
+ */
+uint32_t gpio_fast_ns_to_cycles(uint32_t ns)
+{
+	return (uint32_t)(((uint64_t)ns * SystemCoreClock + 999999999ull) /
+			  1000000000ull);
+}
@@ -22,6 +22,7 @@
 #include "aducm410_irq.h"
 #include "aducm410_uart.h"
 #include "error.h"
+#include "desc_pool.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -29,32 +30,32 @@
 
 #define	BIT(x)	(1 << x)
 
+/* Ticker timer (GPT1) clock frequency in Hz for HCLK (160Mhz) source */
+#define TICKER_TIMER_CLOCK		160000000
+
+/* Max reload value of the 16-bit ticker timer */
+#define TICKER_TIMER_MAX_LOAD	0xffff
+
+/* Number of external interrupts (EXTINT0..EXTINT9, mapped to IDs 1..10) */
+#define EXT_INT_COUNT			(EXTERNAL_INT_ID10 - EXTERNAL_INT_ID1 + 1)
+
+/* Check if the IRQ ID is an external interrupt ID */
+#define IS_EXT_INT_ID(id)		((id) < EXT_INT_COUNT)
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
-/**
-* @struct aducm410_irq_callback_desc
-* @brief Structure holding the callback functions for aducm410 irqs
-* @note  The callback functions are mapped with 'irq_id' structure
-*/
-typedef struct {
-	struct callback_desc callback_ext_int_id1;
-	struct callback_desc callback_ext_int_id2;
-	struct callback_desc callback_ext_int_id3;
-	struct callback_desc callback_ext_int_id4;
-	struct callback_desc callback_ext_int_id5;
-	struct callback_desc callback_ext_int_id6;
-	struct callback_desc callback_ext_int_id7;
-	struct callback_desc callback_ext_int_id8;
-	struct callback_desc callback_ext_int_id9;
-} aducm410_irq_callback_desc;
-
-/* ADuCM410 callback function pointer typedef */
-typedef void(*aducm410_callback_func)(void);
-
-/* ADuCM410 irq callback structure variable */
-static aducm410_irq_callback_desc aducm410_irq_callbacks;
+/* ADuCM410 irq callbacks, indexed by 'irq_id' */
+static struct callback_desc aducm410_irq_callbacks[NB_INTERRUPTS];
+
+/* ADuCM410 external interrupt fast (direct) handlers, indexed by 'irq_id' */
+static volatile aducm410_irq_fast_handler aducm410_irq_fast_handlers[EXT_INT_COUNT];
+
+/* Static pools of irq controller descriptors */
+DESC_POOL_DEFINE(irq_desc_pool, struct irq_ctrl_desc, IRQ_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(aducm410_irq_desc_pool, aducm410_irq_desc,
+		 IRQ_DESC_POOL_SIZE);
 
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
@@ -65,138 +66,132 @@ static aducm410_irq_callback_desc aducm410_irq_callbacks;
 /******************************************************************************/
 
 /**
- * @brief	ADuCM410 callback function for external interrupt ID1 event (EXTINT0)
+ * @brief	Dispatch the external interrupt event
+ * @param	irq_id[in] - External interrupt ID (EXTINTn is 'irq_id' n)
  * @return	none
+ * @note	The EICLR flags are write-1-to-clear, so flag is cleared by a plain
+ *			write, without reading back the register. A fast handler, when
+ *			registered, is invoked directly in place of the callback
  */
-void Ext_Int0_Handler(void)
+static inline void aducm410_ext_int_dispatch(uint32_t irq_id)
 {
+	aducm410_irq_fast_handler fast_handler = aducm410_irq_fast_handlers[irq_id];
+	struct callback_desc *callback = &aducm410_irq_callbacks[irq_id];
+
 	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(0);
+	pADI_ALLON->EICLR = BIT(irq_id);
 
-	if (aducm410_irq_callbacks.callback_ext_int_id1.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id1.callback(
-			aducm410_irq_callbacks.callback_ext_int_id1.ctx, EXTERNAL_INT_ID1, NULL);
+	if (fast_handler) {
+		fast_handler();
+	} else if (callback->callback) {
+		callback->callback(callback->ctx, irq_id, NULL);
 	}
 }
 
 /**
- * @brief	ADuCM410 callback function for external interrupt ID2 event (EXTINT1)
+ * @brief	ADuCM410 external interrupt handlers (EXTINT0..EXTINT9)
  * @return	none
  */
-void Ext_Int1_Handler(void)
+void Ext_Int0_Handler(void)
 {
-	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(1);
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID1);
+}
 
-	if (aducm410_irq_callbacks.callback_ext_int_id2.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id2.callback(
-			aducm410_irq_callbacks.callback_ext_int_id2.ctx, EXTERNAL_INT_ID2, NULL);
-	}
+void Ext_Int1_Handler(void)
+{
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID2);
 }
 
-/**
- * @brief	ADuCM410 callback function for external interrupt ID3 event (EXTINT2)
- * @return	none
- */
 void Ext_Int2_Handler(void)
 {
-	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(2);
-
-	if (aducm410_irq_callbacks.callback_ext_int_id3.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id3.callback(
-			aducm410_irq_callbacks.callback_ext_int_id3.ctx, EXTERNAL_INT_ID3, NULL);
-	}
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID3);
 }
 
-/**
- * @brief	ADuCM410 callback function for external interrupt ID4 event (EXTINT3)
- * @return	none
- */
 void Ext_Int3_Handler(void)
 {
-	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(3);
-
-	if (aducm410_irq_callbacks.callback_ext_int_id4.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id4.callback(
-			aducm410_irq_callbacks.callback_ext_int_id4.ctx, EXTERNAL_INT_ID4, NULL);
-	}
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID4);
 }
 
-/**
- * @brief	ADuCM410 callback function for external interrupt ID5 event (EXTINT4)
- * @return	none
- */
 void Ext_Int4_Handler(void)
 {
-	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(4);
-
-	if (aducm410_irq_callbacks.callback_ext_int_id5.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id5.callback(
-			aducm410_irq_callbacks.callback_ext_int_id5.ctx, EXTERNAL_INT_ID5, NULL);
-	}
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID5);
 }
 
-/**
- * @brief	ADuCM410 callback function for external interrupt ID6 event (EXTINT5)
- * @return	none
- */
 void Ext_Int5_Handler(void)
 {
-	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(5);
-
-	if (aducm410_irq_callbacks.callback_ext_int_id6.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id6.callback(
-			aducm410_irq_callbacks.callback_ext_int_id6.ctx, EXTERNAL_INT_ID6, NULL);
-	}
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID6);
 }
 
-/**
- * @brief	ADuCM410 callback function for external interrupt ID7 event (EXTINT6)
- * @return	none
- */
 void Ext_Int6_Handler(void)
 {
-	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(6);
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID7);
+}
 
-	if (aducm410_irq_callbacks.callback_ext_int_id7.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id7.callback(
-			aducm410_irq_callbacks.callback_ext_int_id7.ctx, EXTERNAL_INT_ID7, NULL);
-	}
+void Ext_Int7_Handler(void)
+{
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID8);
+}
+
+void Ext_Int8_Handler(void)
+{
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID9);
+}
+
+void Ext_Int9_Handler(void)
+{
+	aducm410_ext_int_dispatch(EXTERNAL_INT_ID10);
 }
 
 /**
- * @brief	ADuCM410 callback function for external interrupt ID8 event (EXTINT7)
+ * @brief	ADuCM410 callback function for ticker ID event (GPT1 timeout)
  * @return	none
  */
-void Ext_Int7_Handler(void)
+void GP_Tmr1_Int_Handler(void)
 {
+	struct callback_desc *callback = &aducm410_irq_callbacks[TICKER_INT_ID];
+
 	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(7);
+	pADI_GPT1->CLRI = BITM_TMR_CLRI_TMOUT;
 
-	if (aducm410_irq_callbacks.callback_ext_int_id8.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id8.callback(
-			aducm410_irq_callbacks.callback_ext_int_id8.ctx, EXTERNAL_INT_ID8, NULL);
+	if (callback->callback) {
+		callback->callback(callback->ctx, TICKER_INT_ID, NULL);
 	}
 }
 
 /**
- * @brief	ADuCM410 callback function for external interrupt ID9 event (EXTINT8)
- * @return	none
+ * @brief	Start the ticker timer (GPT1) in periodic mode
+ * @param	period_usec[in] - Ticker period in usec
+ * @return	SUCCESS in case of success, FAILURE otherwise.
+ * @note	HCLK/16 (10Mhz) is used for periods up to ~6.5msec and HCLK/256
+ *			(625Khz) for longer periods (up to ~104msec)
  */
-void Ext_Int8_Handler(void)
+static int32_t aducm410_ticker_start(uint32_t period_usec)
 {
-	/* Clear interrupt flag */
-	pADI_ALLON->EICLR |= BIT(8);
+	uint32_t prescaler = ENUM_TMR_CON_PRE_DIV16;
+	uint32_t load;
+
+	load = period_usec * (TICKER_TIMER_CLOCK / 1000000 / 16);
+	if (load > TICKER_TIMER_MAX_LOAD) {
+		prescaler = ENUM_TMR_CON_PRE_DIV256;
+		load = (uint32_t)(((uint64_t)period_usec * TICKER_TIMER_CLOCK) /
+				  (1000000ull * 256));
+	}
 
-	if (aducm410_irq_callbacks.callback_ext_int_id9.callback) {
-		aducm410_irq_callbacks.callback_ext_int_id9.callback(
-			aducm410_irq_callbacks.callback_ext_int_id9.ctx, EXTERNAL_INT_ID9, NULL);
+	if (!load || load > TICKER_TIMER_MAX_LOAD) {
+		return FAILURE;
 	}
+
+	pADI_GPT1->CON &= (~BITM_TMR_CON_ENABLE);	// disable timer1
+	pADI_GPT1->LD = (uint16_t)load;				// reload the timer1 value
+	pADI_GPT1->CLRI = BITM_TMR_CLRI_TMOUT;
+
+	/* config and enable timer1 */
+	pADI_GPT1->CON = ((ENUM_TMR_CON_CLK_HCLK << BITP_TMR_CON_CLK) | \
+			  prescaler |\
+			  BITM_TMR_CON_ENABLE |\
+			  (ENUM_TMR_CON_MOD_PERIODIC << BITP_TMR_CON_MOD));
+
+	return SUCCESS;
 }
 
 /**
@@ -215,8 +210,8 @@ int32_t irq_ctrl_init(struct irq_ctrl_desc **desc,
 	}
 
 	/* Create a new descriptor for generic parameters */
-	struct irq_ctrl_desc *new_desc = (struct irq_ctrl_desc *)calloc(1,
-					 sizeof(struct irq_ctrl_desc));
+	struct irq_ctrl_desc *new_desc = (struct irq_ctrl_desc *)desc_pool_alloc(
+			&irq_desc_pool);
 	if (!new_desc) {
 		return FAILURE;
 	}
@@ -225,49 +220,23 @@ int32_t irq_ctrl_init(struct irq_ctrl_desc **desc,
 	ext_int_mode = ((aducm410_irq_init_param *)(param->extra))->int_mode;
 
 	/* Create a new descriptor for platform specific parameters */
-	aducm410_irq_desc *aducm410_new_desc = (aducm410_irq_desc *)calloc(1,
-					       sizeof(aducm410_irq_desc));
+	aducm410_irq_desc *aducm410_new_desc = (aducm410_irq_desc *)desc_pool_alloc(
+			&aducm410_irq_desc_pool);
+	if (!aducm410_new_desc) {
+		desc_pool_free(&irq_desc_pool, new_desc);
+		return FAILURE;
+	}
 
 	new_desc->extra = (aducm410_irq_desc *)aducm410_new_desc;
-
-	switch (new_desc->irq_ctrl_id) {
-	case EXTERNAL_INT_ID1:
-		EiCfg(EXTINT0, INT_EN, ext_int_mode);
-		break;
-
-	case EXTERNAL_INT_ID2:
-		EiCfg(EXTINT1, INT_EN, ext_int_mode);
-		break;
-
-	case EXTERNAL_INT_ID3:
-		EiCfg(EXTINT2, INT_EN, ext_int_mode);
-		break;
-
-	case EXTERNAL_INT_ID4:
-		EiCfg(EXTINT3, INT_EN, ext_int_mode);
-		break;
-
-	case EXTERNAL_INT_ID5:
-		EiCfg(EXTINT4, INT_EN, ext_int_mode);
-		break;
-
-	case EXTERNAL_INT_ID6:
-		EiCfg(EXTINT5, INT_EN, ext_int_mode);
-		break;
-
-	case EXTERNAL_INT_ID7:
-		EiCfg(EXTINT6, INT_EN, ext_int_mode);
-		break;
-
-	case EXTERNAL_INT_ID8:
-		EiCfg(EXTINT7, INT_EN, ext_int_mode);
-		break;
-
-	case EXTERNAL_INT_ID9:
-		EiCfg(EXTINT8, INT_EN, ext_int_mode);
-		break;
-
-	default:
+	aducm410_new_desc->ticker_period_usec = ((aducm410_irq_init_param *)(
+			param->extra))->ticker_period_usec;
+
+	/* Ticker timer is configured and started on enabling an interrupt */
+	if (IS_EXT_INT_ID(new_desc->irq_ctrl_id)) {
+		EiCfg(EXTINT0 + new_desc->irq_ctrl_id, INT_EN, ext_int_mode);
+	} else if (new_desc->irq_ctrl_id != TICKER_INT_ID) {
+		desc_pool_free(&aducm410_irq_desc_pool, aducm410_new_desc);
+		desc_pool_free(&irq_desc_pool, new_desc);
 		return FAILURE;
 	}
 
@@ -287,11 +256,8 @@ int32_t irq_ctrl_remove(struct irq_ctrl_desc *desc)
 		return FAILURE;
 	}
 
-	if ((aducm410_irq_desc *)desc->extra) {
-		free((aducm410_irq_desc *)desc->extra);
-	}
-
-	free(desc);
+	desc_pool_free(&aducm410_irq_desc_pool, desc->extra);
+	desc_pool_free(&irq_desc_pool, desc);
 
 	return SUCCESS;
 }
@@ -309,44 +275,15 @@ int32_t irq_enable(struct irq_ctrl_desc *desc, uint32_t irq_id)
 		return FAILURE;
 	}
 
-	switch (desc->irq_ctrl_id) {
-	case EXTERNAL_INT_ID1:
-		NVIC_EnableIRQ(EINT0_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID2:
-		NVIC_EnableIRQ(EINT1_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID3:
-		NVIC_EnableIRQ(EINT2_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID4:
-		NVIC_EnableIRQ(EINT3_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID5:
-		NVIC_EnableIRQ(EINT4_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID6:
-		NVIC_EnableIRQ(EINT5_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID7:
-		NVIC_EnableIRQ(EINT6_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID8:
-		NVIC_EnableIRQ(EINT7_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID9:
-		NVIC_EnableIRQ(EINT8_IRQn);
-		break;
-
-	default:
+	if (IS_EXT_INT_ID(desc->irq_ctrl_id)) {
+		NVIC_EnableIRQ((IRQn_Type)(EINT0_IRQn + desc->irq_ctrl_id));
+	} else if (desc->irq_ctrl_id == TICKER_INT_ID) {
+		if (aducm410_ticker_start(((aducm410_irq_desc *)(
+						   desc->extra))->ticker_period_usec) != SUCCESS) {
+			return FAILURE;
+		}
+		NVIC_EnableIRQ(GPT1_IRQn);
+	} else {
 		return FAILURE;
 	}
 
@@ -365,44 +302,13 @@ int32_t irq_disable(struct irq_ctrl_desc *desc, uint32_t irq_id)
 		return FAILURE;
 	}
 
-	switch (desc->irq_ctrl_id) {
-	case EXTERNAL_INT_ID1:
-		NVIC_DisableIRQ(EINT0_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID2:
-		NVIC_DisableIRQ(EINT1_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID3:
-		NVIC_DisableIRQ(EINT2_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID4:
-		NVIC_DisableIRQ(EINT3_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID5:
-		NVIC_DisableIRQ(EINT4_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID6:
-		NVIC_DisableIRQ(EINT5_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID7:
-		NVIC_DisableIRQ(EINT6_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID8:
-		NVIC_DisableIRQ(EINT7_IRQn);
-		break;
-
-	case EXTERNAL_INT_ID9:
-		NVIC_DisableIRQ(EINT8_IRQn);
-		break;
-
-	default:
+	if (IS_EXT_INT_ID(desc->irq_ctrl_id)) {
+		NVIC_DisableIRQ((IRQn_Type)(EINT0_IRQn + desc->irq_ctrl_id));
+	} else if (desc->irq_ctrl_id == TICKER_INT_ID) {
+		NVIC_DisableIRQ(GPT1_IRQn);
+		pADI_GPT1->CON &= (~BITM_TMR_CON_ENABLE);	// disable timer1
+		pADI_GPT1->CLRI = BITM_TMR_CLRI_TMOUT;
+	} else {
 		return FAILURE;
 	}
 
@@ -425,56 +331,13 @@ int32_t irq_register_callback(struct irq_ctrl_desc *desc,
 		return FAILURE;
 	}
 
-	switch (irq_id) {
-	case EXTERNAL_INT_ID1:
-		aducm410_irq_callbacks.callback_ext_int_id1.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id1.ctx = callback_desc->ctx;
-		break;
-
-	case EXTERNAL_INT_ID2:
-		aducm410_irq_callbacks.callback_ext_int_id2.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id2.ctx = callback_desc->ctx;
-		break;
-
-	case EXTERNAL_INT_ID3:
-		aducm410_irq_callbacks.callback_ext_int_id3.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id3.ctx = callback_desc->ctx;
-		break;
-
-	case EXTERNAL_INT_ID4:
-		aducm410_irq_callbacks.callback_ext_int_id4.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id4.ctx = callback_desc->ctx;
-		break;
-
-	case EXTERNAL_INT_ID5:
-		aducm410_irq_callbacks.callback_ext_int_id5.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id5.ctx = callback_desc->ctx;
-		break;
-
-	case EXTERNAL_INT_ID6:
-		aducm410_irq_callbacks.callback_ext_int_id6.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id6.ctx = callback_desc->ctx;
-		break;
-
-	case EXTERNAL_INT_ID7:
-		aducm410_irq_callbacks.callback_ext_int_id7.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id7.ctx = callback_desc->ctx;
-		break;
-
-	case EXTERNAL_INT_ID8:
-		aducm410_irq_callbacks.callback_ext_int_id8.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id8.ctx = callback_desc->ctx;
-		break;
-
-	case EXTERNAL_INT_ID9:
-		aducm410_irq_callbacks.callback_ext_int_id9.callback = callback_desc->callback;
-		aducm410_irq_callbacks.callback_ext_int_id9.ctx = callback_desc->ctx;
-		break;
-
-	default:
+	if (irq_id >= NB_INTERRUPTS) {
 		return FAILURE;
 	}
 
+	aducm410_irq_callbacks[irq_id].callback = callback_desc->callback;
+	aducm410_irq_callbacks[irq_id].ctx = callback_desc->ctx;
+
 	return SUCCESS;
 }
 
@@ -490,46 +353,34 @@ int32_t irq_unregister(struct irq_ctrl_desc *desc, uint32_t irq_id)
 		return FAILURE;
 	}
 
-	switch (irq_id) {
-	case  EXTERNAL_INT_ID1:
-		aducm410_irq_callbacks.callback_ext_int_id1.callback = NULL;
-		break;
-
-	case EXTERNAL_INT_ID2:
-		aducm410_irq_callbacks.callback_ext_int_id2.callback = NULL;
-		break;
-
-	case EXTERNAL_INT_ID3:
-		aducm410_irq_callbacks.callback_ext_int_id3.callback = NULL;
-		break;
-
-	case EXTERNAL_INT_ID4:
-		aducm410_irq_callbacks.callback_ext_int_id4.callback = NULL;
-		break;
-
-	case EXTERNAL_INT_ID5:
-		aducm410_irq_callbacks.callback_ext_int_id5.callback = NULL;
-		break;
-
-	case EXTERNAL_INT_ID6:
-		aducm410_irq_callbacks.callback_ext_int_id6.callback = NULL;
-		break;
-
-	case EXTERNAL_INT_ID7:
-		aducm410_irq_callbacks.callback_ext_int_id7.callback = NULL;
-		break;
+	if (irq_id >= NB_INTERRUPTS) {
+		return FAILURE;
+	}
 
-	case EXTERNAL_INT_ID8:
-		aducm410_irq_callbacks.callback_ext_int_id8.callback = NULL;
-		break;
+	aducm410_irq_callbacks[irq_id].callback = NULL;
 
-	case EXTERNAL_INT_ID9:
-		aducm410_irq_callbacks.callback_ext_int_id9.callback = NULL;
-		break;
+	return SUCCESS;
+}
 
-	default:
+/**
+ * @brief	Register a fast (direct) handler for an external interrupt
+ * @param	irq_id[in] - External interrupt ID
+ * @param	handler[in] - Fast handler, NULL to unregister it
+ * @return	SUCCESS in case of success, FAILURE otherwise.
+ * @note	The fast handler is invoked straight from the interrupt vector
+ *			(after clearing the interrupt flag), in place of the callback
+ *			registered with irq_register_callback(). This saves the callback
+ *			descriptor lookup and argument passing on latency critical
+ *			interrupts (e.g. ADC conversion complete)
+ */
+int32_t aducm410_irq_register_fast_handler(uint32_t irq_id,
+		aducm410_irq_fast_handler handler)
+{
+	if (!IS_EXT_INT_ID(irq_id)) {
 		return FAILURE;
 	}
 
+	aducm410_irq_fast_handlers[irq_id] = handler;
+
 	return SUCCESS;
 }
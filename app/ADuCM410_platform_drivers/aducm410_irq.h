@@ -52,6 +52,8 @@ enum irq_id {
 	EXTERNAL_INT_ID9,
 	/** External interrupt ID10 (EXTINT9) */
 	EXTERNAL_INT_ID10,
+	/** Ticker (periodic timer) interrupt ID (GPT1) */
+	TICKER_INT_ID,
 	/* Number of available interrupts */
 	NB_INTERRUPTS
 };
@@ -62,6 +64,7 @@ enum irq_id {
  */
 typedef struct {
 	uint32_t int_mode;          // Interrupt mode (falling/rising etc)
+	uint32_t ticker_period_usec;	// Time period in usec for ticker event
 } aducm410_irq_init_param;
 
 /**
@@ -69,7 +72,18 @@ typedef struct {
  * @brief Structure holding the platform descriptor for Interrupt Request.
  */
 typedef struct {
+	uint32_t ticker_period_usec;	// Time period in usec for ticker event
 	void *extra;
 } aducm410_irq_desc;
 
+/* ADuCM410 external interrupt fast (direct) handler */
+typedef void (*aducm410_irq_fast_handler)(void);
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+int32_t aducm410_irq_register_fast_handler(uint32_t irq_id,
+		aducm410_irq_fast_handler handler);
+
 #endif // IRQ_EXTRA_H_
@@ -0,0 +1,234 @@
+/***************************************************************************//**
+ * @file  aducm410_pla_trigger.c
+ * @brief Implementation of PLA generated conversion trigger on ADuCM410
+ * @details GPT0 clocks the PLA block 0 at twice the sampling rate. Element 12
+ *          is a flip-flop (routed to P1.6/CONVST) toggling on every clock
+ *          while element 13 (PLA_DIN bit) is set, and settling high (idle)
+ *          when cleared:
+ *              ELEM12 <= !(ELEM12 & ELEM13), ELEM13 = DIN13
+ *          PLA IRQ0 fires on rising edge of element 12, i.e. at end of every
+ *          CONVST low pulse (half a period after the conversion start)
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include "ADuCM410.h"
+#include "DioLib.h"
+#include "PlaLib.h"
+
+#include "aducm410_pla_trigger.h"
+#include "delay.h"
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+#define	BIT(x)	(1 << x)
+
+/* PLA element driving the CONVST pin (PLA12_OUT is on P1.6) and PLA element
+ * gating the pulse train (from PLA_DIN) */
+#define PLA_CONVST_ELEM			12
+#define PLA_ENABLE_ELEM			13
+
+#define PLA_CONVST_PORT			pADI_GPIO1
+#define PLA_CONVST_PIN			PIN6
+
+/* CONVST element: registered NAND of own output and enable element */
+#define PLA_CONVST_ELEM_CFG		((LOGIC_A_NAND_B << BITP_PLA_PLA_ELEM_N__TBL) | \
+		(1 << BITP_PLA_PLA_ELEM_N__MUX2) | \
+		(INA_ELEM12 << BITP_PLA_PLA_ELEM_N__MUX0) | \
+		(0 << BITP_PLA_PLA_ELEM_N__MUX3) | \
+		((INB_ELEM13 - INB_ELEM1) << BITP_PLA_PLA_ELEM_N__MUX1) | \
+		ENUM_PLA_PLA_ELEM_N__MUX4_FF)
+
+/* Enable element: combinational copy of its PLA_DIN bit */
+#define PLA_ENABLE_ELEM_CFG		((LOGIC_A << BITP_PLA_PLA_ELEM_N__TBL) | \
+		(0 << BITP_PLA_PLA_ELEM_N__MUX2) | \
+		ENUM_PLA_PLA_ELEM_N__MUX4_BYPASS)
+
+/* PLA clock timer (GPT0) frequency in Hz for HCLK (160Mhz) source divided by 4 */
+#define PLA_TIMER_CLOCK			40000000
+
+/* Max reload value of the 16-bit PLA clock timer */
+#define PLA_TIMER_MAX_LOAD		0xffff
+
+/* Max time for CONVST to settle high after gating off (> half of max period) */
+#define PLA_IDLE_TIMEOUT_USEC	2000
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/* Conversion interrupt handler */
+static volatile aducm410_irq_fast_handler pla_trigger_handler;
+
+/* Pulse train status */
+static volatile bool pla_trigger_running;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief	ADuCM410 PLA IRQ0 handler (CONVST rising edge)
+ * @return	none
+ */
+void PLA0_Int_Handler(void)
+{
+	if (pla_trigger_handler) {
+		pla_trigger_handler();
+	}
+}
+
+/**
+ * @brief	Wait for the CONVST element to settle high (idle)
+ * @return	SUCCESS in case of success, FAILURE otherwise.
+ * @note	The PLA clock timer must be running
+ */
+static int32_t aducm410_pla_trigger_wait_idle(void)
+{
+	for (uint32_t timeout = PLA_IDLE_TIMEOUT_USEC; timeout; timeout--) {
+		if (pADI_PLA->PLA_DOUT0 & BIT(PLA_CONVST_ELEM)) {
+			return SUCCESS;
+		}
+
+		udelay(1);
+	}
+
+	return FAILURE;
+}
+
+/**
+ * @brief	Set the CONVST pulse train period
+ * @param	period_ns[in] - Conversion period in nsec
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ * @note	The PLA toggles CONVST on every timer (GPT0) timeout, so the
+ *			timer runs at half of the period (25nsec resolution)
+ */
+int32_t aducm410_pla_trigger_set_period(uint32_t period_ns)
+{
+	uint32_t load;
+
+	if (pla_trigger_running) {
+		return -EBUSY;
+	}
+
+	load = (uint32_t)(((uint64_t)period_ns * PLA_TIMER_CLOCK) /
+			  (2 * 1000000000ull));
+	if (!load || load > PLA_TIMER_MAX_LOAD) {
+		return -EINVAL;
+	}
+
+	pADI_GPT0->CON &= (~BITM_TMR_CON_ENABLE);	// disable timer0
+	pADI_GPT0->LD = (uint16_t)load;				// reload the timer0 value
+	pADI_GPT0->CLRI = BITM_TMR_CLRI_TMOUT;
+
+	/* config and enable timer0 (free running clock of PLA block 0) */
+	pADI_GPT0->CON = ((ENUM_TMR_CON_CLK_HCLK << BITP_TMR_CON_CLK) | \
+			  ENUM_TMR_CON_PRE_DIV1OR4 |\
+			  BITM_TMR_CON_ENABLE |\
+			  (ENUM_TMR_CON_MOD_PERIODIC << BITP_TMR_CON_MOD));
+
+	return SUCCESS;
+}
+
+/**
+ * @brief	Get the CONVST pulse train period
+ * @return	Conversion period in core clock cycles
+ * @note	Timer (GPT0) timeout period is (LD + 1) timer clocks
+ */
+uint32_t aducm410_pla_trigger_get_cycles(void)
+{
+	return 2 * (pADI_GPT0->LD + 1) * (SystemCoreClock / PLA_TIMER_CLOCK);
+}
+
+/**
+ * @brief	Initialize the PLA generated conversion trigger
+ * @param	period_ns[in] - Conversion period in nsec
+ * @param	handler[in] - Conversion interrupt handler
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ * @note	The CONVST pin is handed over to the PLA only while the pulse
+ *			train is running (refer aducm410_pla_trigger_start())
+ */
+int32_t aducm410_pla_trigger_init(uint32_t period_ns,
+				  aducm410_irq_fast_handler handler)
+{
+	int32_t ret;
+
+	if (!handler) {
+		return -EINVAL;
+	}
+
+	NVIC_DisableIRQ(PLA0_IRQn);
+	pla_trigger_running = false;
+	pla_trigger_handler = handler;
+
+	/* Pulse train gated off */
+	PlaDin(0);
+	PlaConfig(PLA_ENABLE_ELEM, PLA_ENABLE_ELEM_CFG);
+	PlaConfig(PLA_CONVST_ELEM, PLA_CONVST_ELEM_CFG);
+
+	/* Block 0 clocked by timer0, block 1 clock left unchanged */
+	PlaClkCfg((pADI_PLA->PLA_CLK & BITM_PLA_PLA_CLK_BLOCK1) >>
+		  BITP_PLA_PLA_CLK_BLOCK1, ENUM_PLA_PLA_CLK_BLOCK0_T0);
+
+	/* IRQ0 on rising edge of CONVST element */
+	PlaIntCfg(0, 1, PLA_CONVST_ELEM);
+	pADI_PLA->PLA_IRQTYPE = (pADI_PLA->PLA_IRQTYPE &
+				 ~BITM_PLA_PLA_IRQTYPE_IRQ0_TYPE) |
+				(ENUM_PLA_PLA_IRQTYPE_IRQ0_TYPE_RISING_EDGE <<
+				 BITP_PLA_PLA_IRQTYPE_IRQ0_TYPE);
+
+	ret = aducm410_pla_trigger_set_period(period_ns);
+	if (ret != SUCCESS) {
+		return ret;
+	}
+
+	return aducm410_pla_trigger_wait_idle();
+}
+
+/**
+ * @brief	Start the CONVST pulse train and conversion interrupt
+ * @return	none
+ * @note	First conversion starts on the next timer timeout (within half
+ *			a period)
+ */
+void aducm410_pla_trigger_start(void)
+{
+	NVIC_ClearPendingIRQ(PLA0_IRQn);
+	NVIC_EnableIRQ(PLA0_IRQn);
+	pla_trigger_running = true;
+
+	/* Hand over CONVST pin (idle high) to PLA and ungate the pulse train */
+	DioCfgPin(PLA_CONVST_PORT, PLA_CONVST_PIN, P1_6_PLA12_OUT);
+	PlaDin(BIT(PLA_ENABLE_ELEM));
+}
+
+/**
+ * @brief	Stop the CONVST pulse train and conversion interrupt
+ * @return	none
+ * @note	The CONVST pin is returned to GPIO once the pulse in progress (if
+ *			any) is complete
+ */
+void aducm410_pla_trigger_stop(void)
+{
+	PlaDin(0);
+	(void)aducm410_pla_trigger_wait_idle();
+
+	DioCfgPin(PLA_CONVST_PORT, PLA_CONVST_PIN, P1_6_GPIO);
+
+	NVIC_DisableIRQ(PLA0_IRQn);
+	NVIC_ClearPendingIRQ(PLA0_IRQn);
+	pla_trigger_running = false;
+}
@@ -0,0 +1,39 @@
+/***************************************************************************//**
+ *   @file     aducm410_pla_trigger.h
+ *   @brief:   Header for PLA generated conversion trigger on ADuCM410
+ *   @details: The PLA (clocked by GPT0) drives the CONVST pin with a 50% duty
+ *             pulse train at the sampling rate and raises the conversion
+ *             interrupt on every CONVST rising edge, so that the conversion
+ *             timing is set by hardware, independent of the CPU load
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef ADUCM410_PLA_TRIGGER_H
+#define ADUCM410_PLA_TRIGGER_H
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "aducm410_irq.h"
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+int32_t aducm410_pla_trigger_init(uint32_t period_ns,
+				  aducm410_irq_fast_handler handler);
+int32_t aducm410_pla_trigger_set_period(uint32_t period_ns);
+uint32_t aducm410_pla_trigger_get_cycles(void);
+void aducm410_pla_trigger_start(void);
+void aducm410_pla_trigger_stop(void);
+
+#endif /* ADUCM410_PLA_TRIGGER_H */
@@ -20,6 +20,7 @@
 #include "pwm.h"
 #include "aducm410_pwm.h"
 #include "error.h"
+#include "desc_pool.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -34,10 +35,60 @@
 /********************** Variables and User Defined Data Types *****************/
 /******************************************************************************/
 
+/* Static pools of PWM descriptors */
+DESC_POOL_DEFINE(pwm_desc_pool, struct pwm_desc, PWM_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(aducm410_pwm_desc_pool, aducm410_pwm_desc, PWM_DESC_POOL_SIZE);
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * @brief	Program the PWM period and duty cycle of ADuCM410 PWM pair
+ * @param	desc[in] - PWM descriptor
+ * @param	period_ns[in] - PWM period in nsec
+ * @param	duty_cycle_ns[in] - PWM duty cycle (high time) in nsec
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+static int32_t aducm410_pwm_set_time(struct pwm_desc *desc, uint32_t period_ns,
+				     uint32_t duty_cycle_ns)
+{
+	unsigned int pwm_period;
+	unsigned int pwm_pulse_width;
+	float duty_cycle_percentage;
+	aducm410_pwm_desc *extra_pwm_desc;
+
+	if (!desc || !desc->extra || !period_ns || duty_cycle_ns > period_ns)
+		return -EINVAL;
+
+	extra_pwm_desc = (aducm410_pwm_desc *)desc->extra;
+
+	/* Calculate the PWM period */
+	if (extra_pwm_desc->pwm_frequency > 0) {
+		pwm_period = (uint32_t)(((float)period_ns / 1000000000) *
+					(extra_pwm_desc->pwm_frequency)) - 1;
+
+		if (pwm_period > PWM_DEFAULT_PERIOD)
+			pwm_period = PWM_DEFAULT_PERIOD;
+	} else {
+		pwm_period = PWM_DEFAULT_PERIOD;
+	}
+
+	/* Calculate the percentage duty cycle and pwm width */
+	duty_cycle_percentage = ((float)duty_cycle_ns / period_ns) * 100;
+	pwm_pulse_width = (uint32_t)((pwm_period * duty_cycle_percentage) / 100);
+
+	/* Set the PWM period and duty cycle (both low and high inputs have same duty cycle) */
+	if (PwmTime(extra_pwm_desc->pwm_pair, pwm_period, pwm_pulse_width,
+		    pwm_pulse_width) == 0)
+		return FAILURE;
+
+	desc->period_ns = period_ns;
+	desc->duty_cycle_ns = duty_cycle_ns;
+
+	return SUCCESS;
+}
+
 /**
  * @brief	Initialized the PWM interface
  * @param	desc[in, out] - Pointer where the configured instance is stored
@@ -48,34 +99,29 @@ int32_t pwm_init(struct pwm_desc **desc,
 		 const struct pwm_init_param *param)
 {
 	int pwm_pair;
-	unsigned int pwm_clock_divider, divider_val;
+	unsigned int pwm_clock_divider;
 	unsigned int pwm_int_enable;
-	unsigned int pwm_period;
-	unsigned int pwm_pulse_width;
-	float pwm_frequency;
-	float duty_cycle_percentage;
 	aducm410_pwm_init_param *extra_pwm_init_param;
 
 	if (!desc || !param)
 		return -EINVAL;
 
-	/* Allocate a dynamic memory for PWM descriptor */
-	struct pwm_desc *new_pwm_desc = (struct pwm_desc *)calloc(1,
-					sizeof(struct pwm_desc));
+	/* Allocate PWM descriptor from the static pool */
+	struct pwm_desc *new_pwm_desc = (struct pwm_desc *)desc_pool_alloc(
+						&pwm_desc_pool);
 	if (!new_pwm_desc)
 		return -ENOMEM;
 
 	new_pwm_desc->id = param->id;
-	new_pwm_desc->period_ns = param->period_ns;
-	new_pwm_desc->duty_cycle_ns = param->duty_cycle_ns;
 	new_pwm_desc->phase_ns = param->phase_ns;
 
-	/* Allocate a dynamic memory for ADuCM410 platform PWM descriptor */
-	aducm410_pwm_desc *extra_pwm_desc = (aducm410_pwm_desc *)calloc(1,
-					    sizeof(aducm410_pwm_desc));
+	/* Allocate ADuCM410 platform PWM descriptor from the static pool */
+	aducm410_pwm_desc *extra_pwm_desc = (aducm410_pwm_desc *)desc_pool_alloc(
+			&aducm410_pwm_desc_pool);
 	if (!extra_pwm_desc)
 		goto extra_pwm_desc_err;
 
+	new_pwm_desc->extra = extra_pwm_desc;
 	extra_pwm_init_param = (aducm410_pwm_init_param *)param->extra;
 
 	/* Get the PWM clock divider */
@@ -113,7 +159,7 @@ int32_t pwm_init(struct pwm_desc **desc,
 		break;
 
 	default:
-		goto extra_pwm_desc_err;
+		goto pwm_init_err;
 	}
 
 	/* Get the PWM channel pair */
@@ -139,7 +185,7 @@ int32_t pwm_init(struct pwm_desc **desc,
 		break;
 
 	default:
-		goto extra_pwm_desc_err;
+		goto pwm_init_err;
 	}
 
 	/* Get the PWM interrupt enable status */
@@ -149,32 +195,32 @@ int32_t pwm_init(struct pwm_desc **desc,
 		pwm_int_enable = 0;
 	}
 
-	/* Calculate the PWM period */
+	/* Store the PWM pair and prescaled clock frequency, needed to reprogram
+	 * the period/duty cycle at runtime */
+	extra_pwm_desc->pwm_pair = pwm_pair;
 	if (extra_pwm_init_param->pwm_clock_freq > 0) {
-		pwm_frequency = extra_pwm_init_param->pwm_clock_freq / (2 <<
-				extra_pwm_init_param->clk_divider);
-		pwm_period = (uint32_t)(((float)param->period_ns / 1000000000) *
-					(pwm_frequency)) - 1;
-
-		if (pwm_period > PWM_DEFAULT_PERIOD)
-			pwm_period = PWM_DEFAULT_PERIOD;
+		extra_pwm_desc->pwm_frequency = extra_pwm_init_param->pwm_clock_freq / (2 <<
+						extra_pwm_init_param->clk_divider);
 	} else {
-		pwm_period = PWM_DEFAULT_PERIOD;
+		extra_pwm_desc->pwm_frequency = 0;
 	}
 
-	/* Calculate the percentage duty cycle and pwm width */
-	duty_cycle_percentage = ((float)param->duty_cycle_ns / param->period_ns) * 100;
-	pwm_pulse_width = (uint32_t)((pwm_period * duty_cycle_percentage) / 100);
-
 	/* Initialize the ADuCM410 PWM interface */
 	PwmInit(pwm_clock_divider, pwm_int_enable, 0, 0);
 
-	/* Set the PWM period and duty cycle (both low and high inputs have same duty cycle) */
-	if (PwmTime(pwm_pair, pwm_period, pwm_pulse_width, pwm_pulse_width) != 0)
-		return SUCCESS;
+	/* Set the PWM period and duty cycle */
+	if (aducm410_pwm_set_time(new_pwm_desc, param->period_ns,
+				  param->duty_cycle_ns) != SUCCESS)
+		goto pwm_init_err;
 
+	*desc = new_pwm_desc;
+
+	return SUCCESS;
+
+pwm_init_err:
+	desc_pool_free(&aducm410_pwm_desc_pool, extra_pwm_desc);
 extra_pwm_desc_err:
-	free(new_pwm_desc);
+	desc_pool_free(&pwm_desc_pool, new_pwm_desc);
 
 	return FAILURE;
 }
@@ -189,10 +235,8 @@ int32_t pwm_remove(struct pwm_desc *desc)
 	if (!desc)
 		return -EINVAL;
 
-	if ((struct aducm410_pwm_desc *)desc->extra)
-		free((struct aducm410_pwm_desc *)desc->extra);
-
-	free(desc);
+	desc_pool_free(&aducm410_pwm_desc_pool, desc->extra);
+	desc_pool_free(&pwm_desc_pool, desc);
 	return SUCCESS;
 }
 
@@ -219,3 +263,66 @@ int32_t pwm_disable(struct pwm_desc *desc)
 	PwmGo(0, 0);
 	return SUCCESS;
 }
+
+/**
+ * @brief	Set the PWM period (duty cycle ratio is retained)
+ * @param	desc[in, out] - PWM descriptor
+ * @param	period_ns[in] - PWM period in nsec
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t pwm_set_period(struct pwm_desc *desc, uint32_t period_ns)
+{
+	uint32_t duty_cycle_ns;
+
+	if (!desc || !desc->period_ns)
+		return -EINVAL;
+
+	duty_cycle_ns = (uint32_t)(((uint64_t)desc->duty_cycle_ns * period_ns) /
+				   desc->period_ns);
+
+	return aducm410_pwm_set_time(desc, period_ns, duty_cycle_ns);
+}
+
+/**
+ * @brief	Get the PWM period
+ * @param	desc[in] - PWM descriptor
+ * @param	period_ns[out] - PWM period in nsec
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t pwm_get_period(struct pwm_desc *desc, uint32_t *period_ns)
+{
+	if (!desc || !period_ns)
+		return -EINVAL;
+
+	*period_ns = desc->period_ns;
+	return SUCCESS;
+}
+
+/**
+ * @brief	Set the PWM duty cycle
+ * @param	desc[in, out] - PWM descriptor
+ * @param	duty_cycle_ns[in] - PWM duty cycle (high time) in nsec
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t pwm_set_duty_cycle(struct pwm_desc *desc, uint32_t duty_cycle_ns)
+{
+	if (!desc)
+		return -EINVAL;
+
+	return aducm410_pwm_set_time(desc, desc->period_ns, duty_cycle_ns);
+}
+
+/**
+ * @brief	Get the PWM duty cycle
+ * @param	desc[in] - PWM descriptor
+ * @param	duty_cycle_ns[out] - PWM duty cycle (high time) in nsec
+ * @return	SUCCESS in case of success, negative error code otherwise.
+ */
+int32_t pwm_get_duty_cycle(struct pwm_desc *desc, uint32_t *duty_cycle_ns)
+{
+	if (!desc || !duty_cycle_ns)
+		return -EINVAL;
+
+	*duty_cycle_ns = desc->duty_cycle_ns;
+	return SUCCESS;
+}
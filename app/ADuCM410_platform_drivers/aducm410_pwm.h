@@ -66,6 +66,8 @@ typedef struct  {
  * @brief Structure holding the platform descriptor for PWM.
  */
 typedef struct {
+	int pwm_pair;				// PWM channel pair
+	float pwm_frequency;		// PWM clock frequency (after prescaling)
 	void *extra;
 } aducm410_pwm_desc;
 
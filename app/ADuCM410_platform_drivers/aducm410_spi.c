@@ -21,6 +21,7 @@
 #include "spi.h"
 #include "aducm410_spi.h"
 #include "error.h"
+#include "desc_pool.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -32,6 +33,10 @@
 /********************** Variables and User defined data types *****************/
 /******************************************************************************/
 
+/* Static pools of SPI descriptors */
+DESC_POOL_DEFINE(spi_desc_pool, spi_desc, SPI_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(aducm410_spi_desc_pool, aducm410_spi_desc, SPI_DESC_POOL_SIZE);
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -54,7 +59,7 @@ int32_t spi_init(struct spi_desc **desc,
 	}
 
 	/* Allocate memory to a new spi descriptor */
-	spi_desc *new_desc = (spi_desc *)calloc(1, sizeof(spi_desc));
+	spi_desc *new_desc = (spi_desc *)desc_pool_alloc(&spi_desc_pool);
 	if (!new_desc) {
 		return FAILURE;
 	}
@@ -64,10 +69,11 @@ int32_t spi_init(struct spi_desc **desc,
 	new_desc->max_speed_hz = param->max_speed_hz;
 
 	/* Allocate memory to a new aducm410 spi descriptor */
-	aducm410_spi_desc *aducm410_new_desc = (aducm410_spi_desc *)calloc(1,
-					       sizeof(aducm410_spi_desc));
+	aducm410_spi_desc *aducm410_new_desc = (aducm410_spi_desc *)desc_pool_alloc(
+			&aducm410_spi_desc_pool);
 
 	if (!aducm410_new_desc) {
+		desc_pool_free(&spi_desc_pool, new_desc);
 		return FAILURE;
 	}
 
@@ -102,12 +108,10 @@ int32_t spi_remove(struct spi_desc *desc)
 	}
 
 	/* Free the aducm410 extra descriptor object */
-	if ((aducm410_spi_desc *)(desc->extra)) {
-		free((aducm410_spi_desc *)(desc->extra));
-	}
+	desc_pool_free(&aducm410_spi_desc_pool, desc->extra);
 
 	/* Free the SPI descriptor object */
-	free(desc);
+	desc_pool_free(&spi_desc_pool, desc);
 
 	return SUCCESS;
 }
@@ -15,18 +15,296 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "UrtLib.h"
+#include "DmaLib.h"
 
 #include "uart.h"
 #include "aducm410_uart.h"
 #include "error.h"
 #include "gpio.h"
 #include "aducm410_gpio.h"
+#include "app_profile.h"
+#include "desc_pool.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Number of UART ports on ADuCM410 */
+#define UART_PORT_COUNT		2
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* UART descriptors for the Rx interrupt handlers (indexed by UART port) */
+static aducm410_uart_desc *aducm410_uart_rx_desc[UART_PORT_COUNT];
+
+/* UART descriptors for the DMA Tx interrupt handlers (indexed by UART port) */
+static aducm410_uart_desc *aducm410_uart_tx_dma_desc[UART_PORT_COUNT];
+
+/* DMA descriptor table base is set once for all the DMA channels */
+static bool dma_base_ready;
+
+/* Static pools of UART descriptors */
+DESC_POOL_DEFINE(uart_desc_pool, struct uart_desc, UART_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(aducm410_uart_desc_pool, aducm410_uart_desc,
+		 UART_DESC_POOL_SIZE);
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Move all the received characters from UART Rx FIFO into ring buffer.
+ * @param uart_desc - aducm410 UART descriptor.
+ * @return none
+ * @note Characters are dropped (and counted) when ring buffer is full.
+ */
+static void aducm410_uart_rx_handler(aducm410_uart_desc *uart_desc)
+{
+	ADI_UART_TypeDef *uart_port;
+	uint16_t head;
+	uint8_t rx_data;
+
+	if (!uart_desc) {
+		return;
+	}
+
+	uart_port = (ADI_UART_TypeDef *)uart_desc->uart_port;
+	head = uart_desc->rx_head;
+
+	/* Drain Rx FIFO (this also clears the Rx full/timeout interrupt) */
+	while (uart_port->LSR & BITM_UART_LSR_DR) {
+		rx_data = (uint8_t)UrtRx(uart_port);
+
+		if (((head + 1) & (UART_RX_BUFFER_SIZE - 1)) == uart_desc->rx_tail) {
+			uart_desc->rx_overflow++;
+			continue;
+		}
+
+		uart_desc->rx_buffer[head] = rx_data;
+		head = (head + 1) & (UART_RX_BUFFER_SIZE - 1);
+	}
+
+	uart_desc->rx_head = head;
+}
+
+/**
+ * @brief UART0 interrupt handler.
+ * @return none
+ */
+void UART0_Int_Handler(void)
+{
+	aducm410_uart_rx_handler(aducm410_uart_rx_desc[0]);
+}
+
+/**
+ * @brief UART1 interrupt handler.
+ * @return none
+ */
+void UART1_Int_Handler(void)
+{
+	aducm410_uart_rx_handler(aducm410_uart_rx_desc[1]);
+}
+
+/**
+ * @brief Get the DMA Tx channel of UART port.
+ * @param uart_desc - aducm410 UART descriptor.
+ * @return DMA channel number.
+ */
+static uint32_t aducm410_uart_dma_tx_chan(aducm410_uart_desc *uart_desc)
+{
+	return (uart_desc->uart_port == pADI_UART0) ? UART0TX_C : UART1TX_C;
+}
+
+/**
+ * @brief Get the DMA Tx interrupt of UART port.
+ * @param uart_desc - aducm410 UART descriptor.
+ * @return DMA Tx interrupt number.
+ */
+static IRQn_Type aducm410_uart_dma_tx_irqn(aducm410_uart_desc *uart_desc)
+{
+	return (uart_desc->uart_port == pADI_UART0) ? DMA_UART0_TX_IRQn :
+	       DMA_UART1_TX_IRQn;
+}
+
+/**
+ * @brief Hand over the Tx buffer being sent to DMA.
+ * @param uart_desc - aducm410 UART descriptor.
+ * @return none
+ */
+static void aducm410_uart_dma_tx_go(aducm410_uart_desc *uart_desc)
+{
+	uint32_t chan = aducm410_uart_dma_tx_chan(uart_desc);
+	uint8_t indx = uart_desc->tx_rd_indx;
+
+	DmaPeripheralStructSetup(chan,
+				 DMA_BASIC | DMA_SIZE_BYTE | DMA_SRCINC_BYTE | DMA_DSTINC_NO);
+	DmaStructPtrOutSetup(chan, uart_desc->tx_length[indx],
+			     uart_desc->tx_buffer[indx]);
+	DmaGo(chan, uart_desc->tx_length[indx], DMA_BASIC);
+
+	/* Unmask the UART DMA request and enable the channel */
+	DmaClr(DMA_CHAN_BIT(chan), 0, DMA_CHAN_BIT(chan), 0);
+	DmaSet(0, DMA_CHAN_BIT(chan), 0, 0);
+}
+
+/**
+ * @brief Copy the data into the free Tx buffer and queue it for DMA transmit.
+ * @param uart_desc - aducm410 UART descriptor.
+ * @param data - Pointer to data.
+ * @param bytes_number - Number of bytes to transmit.
+ * @param wait - true to wait for a free Tx buffer, else false.
+ * @return Number of bytes queued.
+ * @note The two Tx buffers are sent in turn: while DMA sends one buffer, the
+ *       next data is copied into the other one, so that the caller owns its
+ *       data buffer again once the data is queued.
+ */
+static uint32_t aducm410_uart_dma_tx_queue(aducm410_uart_desc *uart_desc,
+		const uint8_t *data, uint32_t bytes_number, bool wait)
+{
+	IRQn_Type irqn = aducm410_uart_dma_tx_irqn(uart_desc);
+	uint32_t queued = 0;
+	uint32_t chunk;
+	uint8_t indx;
+
+	while (queued < bytes_number) {
+		indx = uart_desc->tx_wr_indx;
+
+		/* Buffer is freed by DMA ISR once it is sent */
+		if (uart_desc->tx_length[indx]) {
+			if (!wait) {
+				break;
+			}
+
+			continue;
+		}
+
+		chunk = bytes_number - queued;
+		if (chunk > UART_TX_BUFFER_SIZE) {
+			chunk = UART_TX_BUFFER_SIZE;
+		}
+
+		memcpy(uart_desc->tx_buffer[indx], &data[queued], chunk);
+		uart_desc->tx_wr_indx = indx ^ 1;
+		queued += chunk;
+
+		NVIC_DisableIRQ(irqn);
+		uart_desc->tx_length[indx] = (uint16_t)chunk;
+
+		/* Buffers are sent in order, so an idle DMA resumes from this one */
+		if (!uart_desc->tx_dma_busy) {
+			uart_desc->tx_dma_busy = true;
+			aducm410_uart_dma_tx_go(uart_desc);
+		}
+		NVIC_EnableIRQ(irqn);
+	}
+
+	return queued;
+}
+
+/**
+ * @brief DMA Tx done interrupt handler of UART port.
+ * @param uart_desc - aducm410 UART descriptor.
+ * @return none
+ */
+static void aducm410_uart_dma_tx_handler(aducm410_uart_desc *uart_desc)
+{
+	uint8_t indx;
+
+	if (!uart_desc || !uart_desc->tx_dma_busy) {
+		return;
+	}
+
+	/* Free the buffer sent and continue with the other one, if queued */
+	indx = uart_desc->tx_rd_indx;
+	uart_desc->tx_length[indx] = 0;
+	indx ^= 1;
+	uart_desc->tx_rd_indx = indx;
+
+	if (uart_desc->tx_length[indx]) {
+		aducm410_uart_dma_tx_go(uart_desc);
+	} else {
+		uart_desc->tx_dma_busy = false;
+	}
+}
+
+/**
+ * @brief DMA UART0 Tx interrupt handler.
+ * @return none
+ */
+void DMA_UART0_TX_Int_Handler(void)
+{
+	aducm410_uart_dma_tx_handler(aducm410_uart_tx_dma_desc[0]);
+}
+
+/**
+ * @brief DMA UART1 Tx interrupt handler.
+ * @return none
+ */
+void DMA_UART1_TX_Int_Handler(void)
+{
+	aducm410_uart_dma_tx_handler(aducm410_uart_tx_dma_desc[1]);
+}
+
+/**
+ * @brief Copy the received characters from ring buffer.
+ * @param uart_desc - aducm410 UART descriptor.
+ * @param data - Pointer to buffer where data will be copied.
+ * @param bytes_number - Max number of bytes to copy.
+ * @return Number of bytes copied.
+ */
+static uint32_t aducm410_uart_rx_copy(aducm410_uart_desc *uart_desc,
+				      uint8_t *data, uint32_t bytes_number)
+{
+	uint16_t tail = uart_desc->rx_tail;
+	uint32_t cnt = 0;
+
+	while ((cnt < bytes_number) && (tail != uart_desc->rx_head)) {
+		data[cnt++] = uart_desc->rx_buffer[tail];
+		tail = (tail + 1) & (UART_RX_BUFFER_SIZE - 1);
+	}
+
+	uart_desc->rx_tail = tail;
+
+	return cnt;
+}
+
+/**
+ * @brief Return a character back to the head of Rx ring buffer.
+ *
+ * The character is returned again by next read, so that a received character
+ * can be peeked before handing over the Rx stream to another reader.
+ * @param desc - Instance of UART.
+ * @param data - Character to push back.
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t aducm410_uart_push_back(struct uart_desc *desc, uint8_t data)
+{
+	aducm410_uart_desc *uart_desc;
+	uint16_t tail;
+
+	if (!desc) {
+		return FAILURE;
+	}
+
+	uart_desc = (aducm410_uart_desc *)desc->extra;
+	tail = (uart_desc->rx_tail - 1) & (UART_RX_BUFFER_SIZE - 1);
+
+	/* Slot before the tail is free unless the ring is full */
+	if (tail == uart_desc->rx_head) {
+		return FAILURE;
+	}
+
+	uart_desc->rx_buffer[tail] = data;
+	uart_desc->rx_tail = tail;
+
+	return SUCCESS;
+}
+
 /**
  * @brief Read data from UART device.
  * @param desc - Instance of UART.
@@ -36,25 +314,18 @@
  */
 int32_t uart_read(struct uart_desc *desc, uint8_t *data, uint32_t bytes_number)
 {
-	ADI_UART_TypeDef *uart_port;		// pointer to UART port
-	uint16_t uart_rx_status;              // UART Rx status
+	aducm410_uart_desc *uart_desc;
+	uint32_t cnt = 0;
 
 	if (!desc || !data) {
 		return FAILURE;
 	}
 
-	uart_port = (ADI_UART_TypeDef *)(((aducm410_uart_desc *)(
-			desc->extra))->uart_port);
-
-	for (size_t i = 0; i < bytes_number; i++) {
-		/* Block until new character is received into Rx buffer */
-		do {
-			uart_rx_status = uart_port->IIR;
-		} while (((uart_rx_status & BITM_UART_IIR_STAT) >> BITP_UART_IIR_STAT) !=
-			 ENUM_UART_IIR_STAT_RXFULLINT);
+	uart_desc = (aducm410_uart_desc *)desc->extra;
 
-		/* Read the character from Rx buffer */
-		data[i] = UrtRx(uart_port);
+	/* Block until requested number of characters are received into ring buffer */
+	while (cnt < bytes_number) {
+		cnt += aducm410_uart_rx_copy(uart_desc, &data[cnt], bytes_number - cnt);
 	}
 
 	return bytes_number;
@@ -67,10 +338,14 @@ int32_t uart_read(struct uart_desc *desc, uint8_t *data, uint32_t bytes_number)
  * @param data - Pointer to buffer containing data.
  * @param bytes_number - Number of bytes to read.
  * @return SUCCESS in case of success, FAILURE otherwise.
+ * @note Bulk writes are copied into the DMA Tx buffers (when enabled) and
+ *       the function returns once the data is queued, the last (up to two)
+ *       buffers are sent in background while the caller continues.
  */
 int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
 		   uint32_t bytes_number)
 {
+	aducm410_uart_desc *uart_desc;
 	ADI_UART_TypeDef *uart_port;	      // pointer to UART port
 	uint16_t uart_tx_status;            // UART Tx status
 
@@ -78,8 +353,20 @@ int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
 		return FAILURE;
 	}
 
-	uart_port = (ADI_UART_TypeDef *)(((aducm410_uart_desc *)(
-			desc->extra))->uart_port);
+	uart_desc = (aducm410_uart_desc *)desc->extra;
+	uart_port = (ADI_UART_TypeDef *)uart_desc->uart_port;
+
+	PROFILE_START(PROFILE_UART_WRITE);
+
+	if (uart_desc->tx_dma_en && (bytes_number >= UART_DMA_MIN_TX_BYTES)) {
+		(void)aducm410_uart_dma_tx_queue(uart_desc, data, bytes_number, true);
+
+		PROFILE_STOP(PROFILE_UART_WRITE);
+		return bytes_number;
+	}
+
+	/* Keep the characters in order with any ongoing DMA transmit */
+	while (uart_desc->tx_dma_busy);
 
 	for (size_t i = 0; i < bytes_number; i++) {
 		/* Block until previous character transfered out of Tx buffer */
@@ -91,41 +378,61 @@ int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
 		UrtTx(uart_port, data[i]);
 	}
 
+	PROFILE_STOP(PROFILE_UART_WRITE);
 	return bytes_number;
 }
 
 
 /**
- * @brief Submit reading buffer to the UART driver.
+ * @brief Submit writting buffer to the UART driver.
  *
- * Buffer is used until bytes_number bytes are read.
+ * Data is copied into the free DMA Tx buffers (as much as fits) and sent
+ * over the UART by DMA, the function returns imediatly.
  * @param desc:	Descriptor of the UART device
- * @param data:	Buffer where data will be read
- * @param bytes_number:	Number of bytes to be read.
- * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ * @param data:	Buffer with the data to be written
+ * @param bytes_number:	Number of bytes to be written.
+ * @return Number of bytes written in case of success, \ref FAILURE otherwise.
  */
-int32_t uart_read_nonblocking(struct uart_desc *desc,
-			      uint8_t *data,
-			      uint32_t bytes_number)
+int32_t uart_write_nonblocking(struct uart_desc *desc,
+			       const uint8_t *data,
+			       uint32_t bytes_number)
 {
-	ADI_UART_TypeDef *uart_port;		// pointer to UART port
+	aducm410_uart_desc *uart_desc;
 
 	if (!desc || !data) {
 		return FAILURE;
 	}
 
-	uart_port = (ADI_UART_TypeDef *)(((aducm410_uart_desc *)(
-			desc->extra))->uart_port);
+	uart_desc = (aducm410_uart_desc *)desc->extra;
 
-	for (size_t i = 0; i < bytes_number; i++) {
-		/* Read assuming that new character has been received into Rx buffer.
-		  *Note: The current implementation is suited to read single
-		  charcter only. For more than one characters non-blocking read
-		  a FIFO mechanism must to be implemented */
-		data[i] = UrtRx(uart_port);
+	if (!uart_desc->tx_dma_en) {
+		return uart_write(desc, data, bytes_number);
 	}
 
-	return bytes_number;
+	return aducm410_uart_dma_tx_queue(uart_desc, data, bytes_number, false);
+}
+
+
+/**
+ * @brief Read the data already received by the UART driver.
+ *
+ * Returns without waiting, with up to bytes_number bytes from Rx ring buffer.
+ * @param desc:	Descriptor of the UART device
+ * @param data:	Buffer where data will be read
+ * @param bytes_number:	Max number of bytes to be read.
+ * @return Number of bytes read in case of success, \ref FAILURE otherwise.
+ */
+int32_t uart_read_nonblocking(struct uart_desc *desc,
+			      uint8_t *data,
+			      uint32_t bytes_number)
+{
+	if (!desc || !data) {
+		return FAILURE;
+	}
+
+	/* Copy only the characters already received into ring buffer */
+	return aducm410_uart_rx_copy((aducm410_uart_desc *)desc->extra, data,
+				     bytes_number);
 }
 
 
@@ -138,14 +445,15 @@ int32_t uart_read_nonblocking(struct uart_desc *desc,
 int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 {
 	aducm410_uart_desc *aducm410_new_desc;  // Pointer to aducm410 uart descriptor
+	Urt_SETUP_t *uart_setup;
 
 	if (!desc || !param) {
 		return FAILURE;
 	}
 
 	/* Create a new UART description for the device */
-	struct uart_desc *new_desc = (struct uart_desc *)calloc(1,
-				     sizeof(struct uart_desc));
+	struct uart_desc *new_desc = (struct uart_desc *)desc_pool_alloc(
+					     &uart_desc_pool);
 	if (!new_desc) {
 		return FAILURE;
 	}
@@ -153,20 +461,50 @@ int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 	new_desc->baud_rate = param->baud_rate;
 
 	/* Create a new aducm410 UART descriptor for platform specific parameters */
-	aducm410_new_desc = (aducm410_uart_desc *)calloc(1, sizeof(aducm410_uart_desc));
+	aducm410_new_desc = (aducm410_uart_desc *)desc_pool_alloc(
+				    &aducm410_uart_desc_pool);
 	if (!aducm410_new_desc) {
+		desc_pool_free(&uart_desc_pool, new_desc);
 		return FAILURE;
 	}
 
 	aducm410_new_desc->uart_port = ((aducm410_uart_init_param *)(
 						param->extra))->uart_port;
+	uart_setup = (Urt_SETUP_t *)(((aducm410_uart_init_param *)(
+					      param->extra))->uart_setup);
+	aducm410_new_desc->tx_dma_en = (uart_setup->txDmaEn != 0);
 
 	/* Configure a UART peripheral */
-	UrtSetup((ADI_UART_TypeDef *)aducm410_new_desc->uart_port,
-		 (Urt_SETUP_t *)(((aducm410_uart_init_param *)(param->extra))->uart_setup));
+	UrtSetup((ADI_UART_TypeDef *)aducm410_new_desc->uart_port, uart_setup);
+
+	/* Set up the (shared) DMA descriptor table for DMA transmit */
+	if (aducm410_new_desc->tx_dma_en && !dma_base_ready) {
+		DmaBase();
+		dma_base_ready = true;
+	}
 
 	new_desc->extra = (aducm410_uart_desc *)aducm410_new_desc;
 
+	/* Receive the characters into ring buffer from Rx interrupt */
+	if (aducm410_new_desc->uart_port == pADI_UART0) {
+		aducm410_uart_rx_desc[0] = aducm410_new_desc;
+		NVIC_EnableIRQ(UART0_IRQn);
+	} else {
+		aducm410_uart_rx_desc[1] = aducm410_new_desc;
+		NVIC_EnableIRQ(UART1_IRQn);
+	}
+
+	/* Chain the DMA transmit chunks and signal completion from DMA interrupt */
+	if (aducm410_new_desc->tx_dma_en) {
+		if (aducm410_new_desc->uart_port == pADI_UART0) {
+			aducm410_uart_tx_dma_desc[0] = aducm410_new_desc;
+			NVIC_EnableIRQ(DMA_UART0_TX_IRQn);
+		} else {
+			aducm410_uart_tx_dma_desc[1] = aducm410_new_desc;
+			NVIC_EnableIRQ(DMA_UART1_TX_IRQn);
+		}
+	}
+
 	*desc = new_desc;
 
 	return SUCCESS;
@@ -186,11 +524,26 @@ int32_t uart_remove(struct uart_desc *desc)
 
 	/* Free the aducm410 UART descriptor */
 	if ((aducm410_uart_desc *)(desc->extra)) {
-		free((aducm410_uart_desc *)(desc->extra));
+		/* Let any ongoing DMA transmit complete */
+		while (((aducm410_uart_desc *)(desc->extra))->tx_dma_busy);
+
+		if (((aducm410_uart_desc *)(desc->extra))->uart_port == pADI_UART0) {
+			NVIC_DisableIRQ(UART0_IRQn);
+			NVIC_DisableIRQ(DMA_UART0_TX_IRQn);
+			aducm410_uart_rx_desc[0] = NULL;
+			aducm410_uart_tx_dma_desc[0] = NULL;
+		} else {
+			NVIC_DisableIRQ(UART1_IRQn);
+			NVIC_DisableIRQ(DMA_UART1_TX_IRQn);
+			aducm410_uart_rx_desc[1] = NULL;
+			aducm410_uart_tx_dma_desc[1] = NULL;
+		}
+
+		desc_pool_free(&aducm410_uart_desc_pool, desc->extra);
 	}
 
 	/* Free the UART device descriptor */
-	free(desc);
+	desc_pool_free(&uart_desc_pool, desc);
 
 	return SUCCESS;
 }
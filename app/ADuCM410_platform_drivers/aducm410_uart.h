@@ -18,15 +18,29 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
+/* Size of the UART receive ring buffer (must be power of 2) */
+#define UART_RX_BUFFER_SIZE		256
+
+/* Size of each of the two DMA transmit (ping-pong) buffers. A DMA basic
+ * cycle moves at most 1024 bytes, so a buffer is sent in a single cycle */
+#define UART_TX_BUFFER_SIZE		512
+
+/* Min length of write transferred by DMA (shorter writes use CPU) */
+#define UART_DMA_MIN_TX_BYTES		16
+
 /******************************************************************************/
 /********************** Variables and User defined data types *****************/
 /******************************************************************************/
 
+struct uart_desc;
+
 /**
  * @struct aducm410_uart_init_param
  * @brief Structure holding the UART init parameters for aducm410 platform.
@@ -44,11 +58,23 @@ typedef struct {
  */
 typedef struct {
 	void *uart_port; 		// UART port (memory mapped register address)
+	uint8_t rx_buffer[UART_RX_BUFFER_SIZE];	// Receive ring buffer
+	volatile uint16_t rx_head;		// Ring write index (updated by Rx ISR)
+	volatile uint16_t rx_tail;		// Ring read index (updated by uart_read)
+	volatile uint32_t rx_overflow;	// Count of bytes dropped on ring full
+	bool tx_dma_en;			// DMA transmit enabled (txDmaEn of UART setup)
+	uint8_t tx_buffer[2][UART_TX_BUFFER_SIZE];	// DMA transmit buffers
+	volatile uint16_t tx_length[2];	// Bytes queued in buffer (0 = buffer free)
+	uint8_t tx_wr_indx;			// Next buffer to be filled
+	volatile uint8_t tx_rd_indx;	// Buffer being sent (updated by DMA ISR)
+	volatile bool tx_dma_busy;		// DMA transmit in progress
 } aducm410_uart_desc;
 
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
 
+int32_t aducm410_uart_push_back(struct uart_desc *desc, uint8_t data);
+
 
 #endif /* UART_EXTRA_H */
@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ *   @file     gpio_fast.h
+ *   @brief:   Fast GPIO pin access for ADuCM410 platform
+ *   @details: The port registers and pin mask of an already configured GPIO
+ *             are cached once, so that the pin is set/cleared with a single
+ *             store to the port SET/CLR register and read with a single
+ *             masked load, for timing critical pulses (e.g. CONVST, LDAC)
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef GPIO_FAST_H
+#define GPIO_FAST_H
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ADuCM410.h"
+#include "gpio.h"
+
+/******************************************************************************/
+/********************** Variables and User defined data types *****************/
+/******************************************************************************/
+
+/**
+* @struct gpio_fast_pin
+* @brief Cached port registers and mask of a GPIO pin.
+*/
+struct gpio_fast_pin {
+	ADI_GPIO_TypeDef *port;		// GPIO port (memory mapped registers)
+	uint8_t mask;				// GPIO pin mask
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+int32_t gpio_fast_get(struct gpio_fast_pin *pin, struct gpio_desc *desc);
+uint32_t gpio_fast_ns_to_cycles(uint32_t ns);
+
+/**
+ * @brief Drive the fast GPIO pin high.
+ * @param pin - The fast GPIO pin.
+ * @return None.
+ */
+static inline void gpio_fast_set(struct gpio_fast_pin *pin)
+{
+	pin->port->SET = pin->mask;
+}
+
+/**
+ * @brief Drive the fast GPIO pin low.
+ * @param pin - The fast GPIO pin.
+ * @return None.
+ */
+static inline void gpio_fast_clear(struct gpio_fast_pin *pin)
+{
+	pin->port->CLR = pin->mask;
+}
+
+/**
+ * @brief Read the fast GPIO pin.
+ * @param pin - The fast GPIO pin.
+ * @return true if pin is high, else false.
+ */
+static inline bool gpio_fast_read(struct gpio_fast_pin *pin)
+{
+	return (pin->port->IN & pin->mask) != 0;
+}
+
+/**
+ * @brief Busy wait for at least the given number of core clock cycles.
+ * @param cycles - Number of core clock cycles (refer gpio_fast_ns_to_cycles()).
+ * @return None.
+ * @note Every loop iteration takes more than one cycle, so the wait is
+ *       never shorter than requested.
+ */
+static inline void gpio_fast_delay_cycles(uint32_t cycles)
+{
+	for (volatile uint32_t i = cycles; i; i--) {
+	}
+}
+
+#endif /* GPIO_FAST_H */
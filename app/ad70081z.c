@@ -51,9 +51,36 @@
 #include "delay.h"
 #include "ad70081z.h"
 #include "crc.h"
+#include "app_profile.h"
+#include "desc_pool.h"
 
 DECLARE_CRC8_TABLE(ad70081z_crc8);
 
+/* Number of device instances (static descriptor pool size) */
+#define AD70081Z_MAX_DEVICES		1
+
+DESC_POOL_DEFINE(ad70081z_dev_pool, struct ad70081z_dev, AD70081Z_MAX_DEVICES);
+
+/* Max time for the device to become ready after a reset (t_RESETBH_BUSYL) */
+#define AD70081Z_RESET_TIMEOUT_US	20000
+
+/* Interface status polling interval while waiting for device ready */
+#define AD70081Z_READY_POLL_US		50
+
+/* Min width of LDAC and CONVST pulses (t_LDAC_PW, t_CONVST_PW). The
+ * preliminary datasheet has no figure for these, so this is a conservative
+ * bound rather than a datasheet limit. The pulse is held for at least this
+ * long (rounded up to whole core clock cycles by gpio_fast_ns_to_cycles()) */
+#define AD70081Z_PULSE_MIN_NS		20
+
+/* Init progress messages, suppressed in production startup as every message
+ * costs milliseconds on the IIO UART */
+#if defined(PRODUCTION_STARTUP)
+#define ad70081z_log(...)
+#else
+#define ad70081z_log(...)		printf(__VA_ARGS__)
+#endif
+
 static inline bool is_addr_valid(struct ad70081z_dev *dev, uint32_t reg_addr)
 {
 	uint8_t reg_size = AD70081Z_TRANSF_LEN(reg_addr);
@@ -88,6 +115,32 @@ static inline bool is_big_endian()
 	return (bool) *(uint8_t *) &a;
 }
 
+/**
+ * @brief Register access SPI transaction.
+ *
+ * The transaction is flagged in the device structure for its duration so
+ * that interrupt context users of the device (DAC update ticker) can defer
+ * instead of interleaving with it (refer ad70081z_spi_is_busy()).
+ *
+ * @param dev - The device structure.
+ * @param buf - The transaction buffer (MOSI data in, MISO data out).
+ * @param sz - The transaction size in bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ad70081z_spi_xfer(struct ad70081z_dev *dev, uint8_t *buf,
+			     uint16_t sz)
+{
+	int ret;
+
+	dev->spi_busy++;
+	PROFILE_START(PROFILE_SPI_XFER);
+	ret = spi_write_and_read(dev->spi_desc, buf, sz);
+	PROFILE_STOP(PROFILE_SPI_XFER);
+	dev->spi_busy--;
+
+	return ret;
+}
+
 /**
  * @brief Read device register over SPI.
  *
@@ -150,7 +203,7 @@ int ad70081z_spi_reg_read(struct ad70081z_dev *dev,
 		sz = i;
 	}
 
-	ret = spi_write_and_read(dev->spi_desc, buf, sz);
+	ret = ad70081z_spi_xfer(dev, buf, sz);
 	if (ret)
 		return ret;
 
@@ -173,6 +226,36 @@ int ad70081z_spi_reg_read(struct ad70081z_dev *dev,
 	return ret;
 }
 
+/**
+ * @brief Keep the cached register values coherent with a register write.
+ *
+ * The cached registers may also be written by raw register accesses (debug
+ * register write, fast path command), so every byte written is checked.
+ *
+ * @param dev - The device structure.
+ * @param reg_addr - The register address.
+ * @param reg_data - The register data.
+ */
+static void ad70081z_update_reg_cache(struct ad70081z_dev *dev,
+				      uint32_t reg_addr,
+				      uint32_t reg_data)
+{
+	uint8_t reg_size = AD70081Z_TRANSF_LEN(reg_addr);
+	uint32_t addr = AD70081Z_ADDR(reg_addr);
+	uint32_t cache_addr = AD70081Z_ADDR(AD70081Z_I_ADC_IN_HI_Z);
+	uint8_t shift;
+
+	// register LSB is at the lowest address
+	for (uint8_t i = 0; i < reg_size; i++) {
+		if (addr + i < cache_addr || addr + i > cache_addr + 1)
+			continue;
+
+		shift = 8 * (addr + i - cache_addr);
+		dev->iadc_in_hi_z &= ~(0xFF << shift);
+		dev->iadc_in_hi_z |= ((reg_data >> (8 * i)) & 0xFF) << shift;
+	}
+}
+
 /**
  * @brief Write device register over SPI.
  *
@@ -240,13 +323,16 @@ int ad70081z_spi_reg_write(struct ad70081z_dev *dev,
 		sz = i;
 	}
 
-	ret = spi_write_and_read(dev->spi_desc, buf, sz);
+	ret = ad70081z_spi_xfer(dev, buf, sz);
 
 	if (dev->dev_spi_settings.crc_enabled) {
 		if (ocrc != buf[sz - 1])
 			return -EBADMSG;
 	}
 
+	if (!ret)
+		ad70081z_update_reg_cache(dev, reg_addr, reg_data);
+
 	return ret;
 }
 
@@ -266,14 +352,134 @@ int ad70081z_spi_reg_write_mask(struct ad70081z_dev *dev,
 	uint32_t regval;
 	int ret;
 
+	if (!dev)
+		return -EINVAL;
+
+	// keep the device busy across the read-modify-write
+	dev->spi_busy++;
+
 	ret = ad70081z_spi_reg_read(dev, reg_addr, &regval);
-	if(ret)
-		return ret;
+	if (!ret) {
+		regval &= ~mask;
+		regval |= data;
+
+		ret = ad70081z_spi_reg_write(dev, reg_addr, regval);
+	}
+
+	dev->spi_busy--;
+
+	return ret;
+}
+
+/**
+ * @brief Check if the device SPI can't be used for register access now.
+ *
+ * This is meant for interrupt context users of the device, which must
+ * not start a transaction while one from the thread context is in progress
+ * or while the device is in a custom (continuous conversion) mode, where
+ * register access is disabled. They should defer their access instead.
+ *
+ * @param dev - The device structure.
+ * @return true if a register transaction is in progress or register access
+ *	   is disabled, false otherwise.
+ */
+bool ad70081z_spi_is_busy(struct ad70081z_dev *dev)
+{
+	if (!dev)
+		return true;
+
+	return (dev->spi_busy != 0) ||
+	       (dev->custom_mode != AD70081Z_REGISTER_ACCESS_MODE);
+}
+
+/**
+ * @brief SPI write to consecutive registers of the same size in a single burst.
+ *
+ * Consecutive registers are written with one SPI transaction using the
+ * address auto-increment/decrement of the device (streaming write). This
+ * avoids the instruction overhead of a transaction per register.
+ *
+ * @param dev - The device structure.
+ * @param first_reg - The first (lowest) register address.
+ * @param reg_data - values that will be set in the registers, in the
+ *		     ascending order of register address.
+ * @param nb_of_regs - number of consecutive registers to be written.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int ad70081z_spi_reg_write_burst(struct ad70081z_dev *dev,
+				 uint32_t first_reg,
+				 const uint16_t *reg_data,
+				 uint8_t nb_of_regs)
+{
+	uint8_t buf[3 + 2 * AD70081Z_VDAC_CH_LIMIT];
+	uint8_t reg_size = AD70081Z_TRANSF_LEN(first_reg);
+	uint8_t ocrc = 0;
+	uint16_t sz;
+	uint16_t i = 0;
+	uint8_t j;
+	uint32_t reg;
+	uint32_t addr;
+	uint32_t data;
+	int ret;
+
+	if (!dev || !reg_data || !nb_of_regs ||
+	    (reg_size * nb_of_regs) > (2 * AD70081Z_VDAC_CH_LIMIT) ||
+	    dev->custom_mode)
+		return -EINVAL;
 
-	regval &= ~mask;
-	regval |= data;
+	if (nb_of_regs == 1)
+		return ad70081z_spi_reg_write(dev, first_reg, reg_data[0]);
 
-	ret = ad70081z_spi_reg_write(dev, reg_addr, regval);
+	// burst starts at the lowest or highest address depending on direction
+	if (dev->dev_spi_settings.addr_ascension)
+		reg = first_reg;
+	else
+		reg = first_reg + reg_size * (nb_of_regs - 1);
+
+	if (!is_addr_valid(dev, reg))
+		return -EINVAL;
+
+	addr = AD70081Z_ADDR(reg);
+	if (!dev->dev_spi_settings.addr_ascension)
+		addr += (reg_size - 1);
+
+	if (dev->dev_spi_settings.short_instruction) {
+		buf[i++] = (uint8_t)(AD70081Z_REG_WRITE_7(addr));
+	} else {
+		buf[i++] = (uint8_t)(AD70081Z_REG_WRITE_15(addr) >> 8);
+		buf[i++] = (uint8_t)(addr);
+	}
+
+	// each register is sent in the same byte order as a single write
+	for (j = 0; j < nb_of_regs; j++) {
+		if (dev->dev_spi_settings.addr_ascension)
+			data = reg_data[j];
+		else
+			data = reg_data[nb_of_regs - 1 - j];
+
+		if (!(dev->endianess ^ dev->dev_spi_settings.addr_ascension))
+			memswap64(&data, reg_size, reg_size);
+		if (dev->endianess)
+			memcpy(&buf[i], (uint8_t *)(&data + 1) - reg_size, reg_size);
+		else
+			memcpy(&buf[i], &data, reg_size);
+		i += reg_size;
+	}
+
+	sz = i;
+
+	if (dev->dev_spi_settings.crc_enabled) {
+		ocrc = crc8(ad70081z_crc8, buf, i, AD70081Z_CRC8_INITIAL_VALUE);
+		buf[i++] = ocrc;
+		sz = i;
+	}
+
+	ret = ad70081z_spi_xfer(dev, buf, sz);
+
+	if (dev->dev_spi_settings.crc_enabled) {
+		if (ocrc != buf[sz - 1])
+			return -EBADMSG;
+	}
 
 	return ret;
 }
@@ -373,6 +579,41 @@ int ad70081z_get_interface_status(struct ad70081z_dev *dev,
 	return ret;
 }
 
+/**
+ * @brief Wait for the device to become ready after a reset.
+ * @param dev - The device structure.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ * @note The interface status is polled instead of waiting the worst case
+ *       reset time. NOT_READY error raised by a polling access is cleared
+ *       (write 1 to clear), so that it reads back 0 once the device is ready.
+ */
+static int ad70081z_wait_ready(struct ad70081z_dev *dev)
+{
+	uint32_t timeout = AD70081Z_RESET_TIMEOUT_US;
+	uint8_t status;
+	int ret;
+
+	while (1) {
+		ret = ad70081z_get_interface_status(dev, &status);
+		if (ret)
+			return ret;
+
+		if (!(status & AD70081Z_INTERFACE_STATUS_A_NOT_READY_ERR_MSK))
+			return SUCCESS;
+
+		if (timeout < AD70081Z_READY_POLL_US)
+			return -ETIMEDOUT;
+
+		ret = ad70081z_spi_reg_write(dev, AD70081Z_INTERFACE_STATUS_A,
+					     AD70081Z_INTERFACE_STATUS_A_NOT_READY_ERR_MSK);
+		if (ret)
+			return ret;
+
+		udelay(AD70081Z_READY_POLL_US);
+		timeout -= AD70081Z_READY_POLL_US;
+	}
+}
+
 /**
  * @brief Performs a software reset.
  * @param dev - The device structure.
@@ -397,10 +638,8 @@ int ad70081z_hardware_reset(struct ad70081z_dev *dev)
 	if (ret)
 		return ret;
 
-	/* Wait t_RESETBH_BUSYL, Figure 4, TODO: adjust value when datasheet is complete. */
-	mdelay(20);
-
-	return SUCCESS;
+	/* Wait t_RESETBH_BUSYL, Figure 4 */
+	return ad70081z_wait_ready(dev);
 }
 
 /**
@@ -423,22 +662,24 @@ int ad70081z_software_reset(struct ad70081z_dev *dev)
 	if (ret)
 		return ret;
 
-	/* Wait t_RESETBH_BUSYL, Figure 4, TODO: adjust value when datasheet is complete. */
-	mdelay(20);
-
-	return SUCCESS;
+	/* Wait t_RESETBH_BUSYL, Figure 4 */
+	return ad70081z_wait_ready(dev);
 }
 
-static int _ad70081z_pulse(struct gpio_desc *gpio, uint32_t delay,
-			   bool inverted)
+/**
+ * @brief Generate active low pulse on fast GPIO pin.
+ * @param dev - The device structure.
+ * @param pin - The fast GPIO pin.
+ * @return None.
+ * @note The pulse is held low for at least AD70081Z_PULSE_MIN_NS, whatever
+ *       the core clock and bus timing are.
+ */
+static inline void _ad70081z_fast_pulse_n(struct ad70081z_dev *dev,
+		struct gpio_fast_pin *pin)
 {
-	int ret;
-
-	ret = gpio_set_value(gpio, inverted ? GPIO_LOW : GPIO_HIGH);
-	if (ret)
-		return ret;
-	udelay(delay);
-	return gpio_set_value(gpio, inverted ? GPIO_HIGH : GPIO_LOW);
+	gpio_fast_clear(pin);
+	gpio_fast_delay_cycles(dev->fast_pulse_cycles);
+	gpio_fast_set(pin);
 }
 
 /**
@@ -448,10 +689,12 @@ static int _ad70081z_pulse(struct gpio_desc *gpio, uint32_t delay,
  */
 int ad70081z_ldac(struct ad70081z_dev *dev)
 {
-	if (!dev)
+	if (!dev || !dev->gpio_ldac_n)
 		return -EINVAL;
 
-	return _ad70081z_pulse(dev->gpio_ldac_n, 1, true);
+	_ad70081z_fast_pulse_n(dev, &dev->fast_ldac_n);
+
+	return SUCCESS;
 }
 
 /**
@@ -461,17 +704,16 @@ int ad70081z_ldac(struct ad70081z_dev *dev)
  */
 int ad70081z_toggle(struct ad70081z_dev *dev)
 {
-	int ret;
-
-	if (!dev)
+	if (!dev || !dev->gpio_tgp)
 		return -EINVAL;
 
-	ret = gpio_set_value(dev->gpio_tgp, !dev->gpio_tgp_state);
-	if (ret)
-		return ret;
+	if (dev->gpio_tgp_state)
+		gpio_fast_clear(&dev->fast_tgp);
+	else
+		gpio_fast_set(&dev->fast_tgp);
 
 	dev->gpio_tgp_state = !dev->gpio_tgp_state;
-	return ret;
+	return SUCCESS;
 }
 
 /**
@@ -486,17 +728,16 @@ int ad70081z_init(struct ad70081z_dev **device,
 {
 	struct ad70081z_dev *dev;
 	uint32_t product_id_l, product_id_h;
+	uint32_t regval;
 	int ret;
 	uint8_t status;
-	enum ad70081z_afe_mux_channel iadc_chn;
 
 	if (!device || !init_param)
 		return -EINVAL;
 
-	// mahesh
-	printf("\r\nInitializing AD70081z...");
-	
-	dev = (struct ad70081z_dev *)calloc(1, sizeof(*dev));
+	ad70081z_log("\r\nInitializing AD70081z...");
+
+	dev = (struct ad70081z_dev *)desc_pool_alloc(&ad70081z_dev_pool);
 	if (!dev)
 		return -ENOMEM;
 
@@ -505,6 +746,8 @@ int ad70081z_init(struct ad70081z_dev **device,
 
 	crc8_populate_msb(ad70081z_crc8, 0x7);
 
+	dev->fast_pulse_cycles = gpio_fast_ns_to_cycles(AD70081Z_PULSE_MIN_NS);
+
 	ret = gpio_get_optional(&dev->gpio_ldac_n, init_param->gpio_ldac_n);
 	if (ret)
 		goto error;
@@ -513,11 +756,14 @@ int ad70081z_init(struct ad70081z_dev **device,
 		ret = gpio_direction_output(dev->gpio_ldac_n, GPIO_HIGH);
 		if (ret)
 			goto error;
+
+		ret = gpio_fast_get(&dev->fast_ldac_n, dev->gpio_ldac_n);
+		if (ret)
+			goto error;
 	}
 
-	// mahesh
-	printf("\r\nLDAC GPIO Init Success...");
-	
+	ad70081z_log("\r\nLDAC GPIO Init Success...");
+
 	ret = gpio_get_optional(&dev->gpio_tgp, init_param->gpio_tgp);
 	if (ret)
 		goto error;
@@ -526,11 +772,14 @@ int ad70081z_init(struct ad70081z_dev **device,
 		ret = gpio_direction_output(dev->gpio_tgp, GPIO_LOW);
 		if (ret)
 			goto error;
+
+		ret = gpio_fast_get(&dev->fast_tgp, dev->gpio_tgp);
+		if (ret)
+			goto error;
 	}
 
-	// mahesh
-	printf("\r\nTGP GPIO Init Success...");
-	
+	ad70081z_log("\r\nTGP GPIO Init Success...");
+
 	ret = gpio_get_optional(&dev->gpio_convst, init_param->gpio_convst);
 	if (ret)
 		goto error;
@@ -539,18 +788,20 @@ int ad70081z_init(struct ad70081z_dev **device,
 		ret = gpio_direction_output(dev->gpio_convst, GPIO_HIGH);
 		if (ret)
 			goto error;
+
+		ret = gpio_fast_get(&dev->fast_convst, dev->gpio_convst);
+		if (ret)
+			goto error;
 	}
 
-	// mahesh
-	printf("\r\nCONVST GPIO Init Success...");
-	
+	ad70081z_log("\r\nCONVST GPIO Init Success...");
+
 	ret = spi_init(&dev->spi_desc, &init_param->spi_init);
 	if (ret)
 		goto error;
 
-	// mahesh
-	printf("\r\nSPI Init Success...");
-	
+	ad70081z_log("\r\nSPI Init Success...");
+
 	ret = gpio_get_optional(&dev->gpio_reset_n, init_param->gpio_reset_n);
 	if (ret)
 		goto error;
@@ -569,9 +820,8 @@ int ad70081z_init(struct ad70081z_dev **device,
 			goto error;
 	}
 
-	// mahesh
-	printf("\r\nAD70081z H/W Reset Success...");
-	
+	ad70081z_log("\r\nAD70081z H/W Reset Success...");
+
 	ret = ad70081z_get_interface_status(dev, &status);
 	if (ret)
 		goto error;
@@ -585,9 +835,8 @@ int ad70081z_init(struct ad70081z_dev **device,
 		goto error;
 	}
 
-	// mahesh
-	printf("\r\nInterface Status Register Read Success...");
-	
+	ad70081z_log("\r\nInterface Status Register Read Success...");
+
 	/* Query product id */
 	ret = ad70081z_spi_reg_read(dev, AD70081Z_PRODUCT_ID_L, &product_id_l);
 	if (ret)
@@ -596,21 +845,19 @@ int ad70081z_init(struct ad70081z_dev **device,
 	if (ret)
 		goto error;
 
-	// mahesh
-	printf("\r\nAD70081Z_PRODUCT_ID_L: %d...", product_id_l);
-	printf("\r\nAD70081Z_PRODUCT_ID_H: %d...", product_id_h);
-	
+	ad70081z_log("\r\nAD70081Z_PRODUCT_ID_L: %d...", product_id_l);
+	ad70081z_log("\r\nAD70081Z_PRODUCT_ID_H: %d...", product_id_h);
+
 	if (product_id_l != AD70081Z_PRODUCT_ID_L_VALUE ||
 	    product_id_h != AD70081Z_PRODUCT_ID_H_VALUE) {
-		printf("unexpected product id (0x%.2X%.2X)\n",
+		printf("unexpected product id (H: 0x%X, L: 0x%X)\n",
 		       (uint16_t)product_id_h, (uint16_t)product_id_l);
 		ret = -EFAULT;
 		goto error;
 	}
 
-	// mahesh
-	printf("\r\nProduct ID Read Success...");
-	
+	ad70081z_log("\r\nProduct ID Read Success...");
+
 	ret = ad70081z_set_device_spi(dev,
 				      &init_param->dev_spi_settings);
 	if (ret)
@@ -622,29 +869,22 @@ int ad70081z_init(struct ad70081z_dev **device,
 	if (init_param->enable_internal_reference)
 		ad70081z_set_reference(dev, true);
 
-	/* Configure the IADC Rsense values */
-	for (iadc_chn = AD70081Z_E10_WPD_IS0; iadc_chn <= AD70081Z_E21_RTAP_IS;
-	     iadc_chn++) {
-		ret = ad70081z_iadc_rsense_config(dev, iadc_chn,
-						  init_param->iadc_rsense[iadc_chn - AD70081Z_E10_WPD_IS0]);
-		if (ret)
-			goto error;
-	}
+	/* Cache the IADC enable register to avoid read-modify-write on updates */
+	ret = ad70081z_spi_reg_read(dev, AD70081Z_I_ADC_IN_HI_Z, &regval);
+	if (ret)
+		goto error;
+	dev->iadc_in_hi_z = (uint16_t)regval;
 
-	/* Configure the IADC input current range values */
-	for (iadc_chn = AD70081Z_E19_TOND_IS0; iadc_chn <= AD70081Z_E19_TOND_IS3;
-	     iadc_chn++) {
-		ret = ad70081z_iadc_config(dev, iadc_chn,
-					   init_param->idac_tond_is_current_range[iadc_chn - AD70081Z_E19_TOND_IS0]);
-		if (ret)
-			goto error;
-	}
+	/* Configure the IADC Rsense and input current range values */
+	ret = ad70081z_iadc_config_all(dev, init_param->iadc_rsense,
+				       init_param->idac_tond_is_current_range);
+	if (ret)
+		goto error;
 
 	*device = dev;
 
-	// mahesh
-	printf("\r\nAD70081z Init Complete...");
-	
+	ad70081z_log("\r\nAD70081z Init Complete...");
+
 	return SUCCESS;
 error:
 	ad70081z_remove(dev);
@@ -672,7 +912,7 @@ void ad70081z_remove(struct ad70081z_dev *dev)
 		gpio_remove(dev->gpio_reset_n);
 	if (dev->gpio_tgp)
 		gpio_remove(dev->gpio_tgp);
-	free(dev);
+	desc_pool_free(&ad70081z_dev_pool, dev);
 }
 
 /**
@@ -805,6 +1045,38 @@ int ad70081z_set_dac_input(struct ad70081z_dev *dev, uint16_t dac_input,
 	return ad70081z_spi_reg_write(dev, reg, dac_input);
 }
 
+/**
+ * @brief Set dac input registers of consecutive channels in a single burst.
+ *
+ * The input registers of consecutive channels are placed at consecutive
+ * addresses, so they are written with one SPI transaction (refer
+ * ad70081z_spi_reg_write_burst()).
+ *
+ * @param dev - The device structure.
+ * @param dac_input - values that will be set in the registers, in the
+ *		      ascending order of channel number.
+ * @param input - INPUT_A or INPUT_B selection.
+ * @param first_ch - the first (lowest) channel to be written.
+ * @param nb_of_ch - number of consecutive channels to be written.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ */
+int ad70081z_set_dac_input_burst(struct ad70081z_dev *dev,
+				 const uint16_t *dac_input,
+				 enum ad70081z_input input,
+				 enum ad70081z_channel first_ch,
+				 uint8_t nb_of_ch)
+{
+	if (!dev || !dac_input || !nb_of_ch ||
+	    (first_ch + nb_of_ch) > AD70081Z_VDAC_CH_LIMIT)
+		return -EINVAL;
+
+	return ad70081z_spi_reg_write_burst(dev,
+					    (input == AD70081Z_INPUT_A ?
+					     AD70081Z_INPUT_A(first_ch) :
+					     AD70081Z_INPUT_B(first_ch)),
+					    dac_input, nb_of_ch);
+}
+
 /**
  * @brief Set IDAC shutdown mask
  * @param dev - The device structure.
@@ -969,8 +1241,8 @@ int ad70081z_adc_convst(struct ad70081z_dev *dev)
 		break;
 	case AD70081Z_ADC_CONTINUOUS_CONVERSION_MODE:
 		if (dev->gpio_convst) {
-			/* TODO: tCONVST_PW is TBD in datasheet. */
-			return _ad70081z_pulse(dev->gpio_convst, 1, true);
+			_ad70081z_fast_pulse_n(dev, &dev->fast_convst);
+			return SUCCESS;
 		} else {
 			/* Do nothing, user likely is tying CSB to CONVST electrically. */
 			return SUCCESS;
@@ -1124,7 +1396,9 @@ int ad70081z_cc_read(struct ad70081z_dev *dev,
 	buf[0] |= field_prep(AD70081Z_ADC_CONFIG_ADC_OSR_MSK, dev->osr);
 	buf[1] = 0;
 
+	PROFILE_START(PROFILE_CC_READ);
 	ret = spi_write_and_read(dev->spi_desc, buf, sizeof(buf));
+	PROFILE_STOP(PROFILE_CC_READ);
 	if (ret)
 		return ret;
 
@@ -1145,14 +1419,46 @@ int ad70081z_cc_read(struct ad70081z_dev *dev,
 int ad70081z_iadc_enable(struct ad70081z_dev *dev,
 			 enum ad70081z_afe_mux_channel ch, bool enable)
 {
-	uint32_t mask;
+	uint8_t mask;
 
 	if (!dev || ch < AD70081Z_E10_WPD_IS0 || ch > AD70081Z_E21_RTAP_IS)
 		return -EINVAL;
 
 	mask = BIT(ch - AD70081Z_E10_WPD_IS0);
-	return ad70081z_spi_reg_write_mask(dev, AD70081Z_I_ADC_IN_HI_Z, mask,
-					   enable ? mask : 0);
+	if (enable)
+		mask |= (uint8_t)dev->iadc_in_hi_z;
+	else
+		mask = (uint8_t)dev->iadc_in_hi_z & ~mask;
+
+	return ad70081z_iadc_enable_mask(dev, mask);
+}
+
+/**
+ * @brief Enable ADC for a set of IADC AFE MUX channels in one transaction.
+ * @param dev - The device structure.
+ * @param mask - IADC channels enable mask (bit 0 = AD70081Z_E10_WPD_IS0,
+ *		 bit 7 = AD70081Z_E21_RTAP_IS). Channels not set are disabled.
+ * @return SUCCESS in case of success, negative error code otherwise.
+ * @note The register is written only if the cached value differs.
+ */
+int ad70081z_iadc_enable_mask(struct ad70081z_dev *dev, uint8_t mask)
+{
+	uint16_t regval;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	regval = (dev->iadc_in_hi_z & 0xFF00) | mask;
+	if (regval == dev->iadc_in_hi_z)
+		return SUCCESS;
+
+	ret = ad70081z_spi_reg_write(dev, AD70081Z_I_ADC_IN_HI_Z, regval);
+	if (ret)
+		return ret;
+
+	dev->iadc_in_hi_z = regval;
+	return ret;
 }
 
 /**
@@ -1226,3 +1532,65 @@ int ad70081z_iadc_rsense_config(struct ad70081z_dev *dev,
 	dev->iadc_rsense[ch - AD70081Z_E10_WPD_IS0] = rsense_val;
 	return ret;
 }
+
+/**
+ * @brief Configure the rsense values and input current ranges of all IADC
+ *        channels.
+ * @param dev - The device structure.
+ * @param rsense - Rsense values of AD70081Z_E10_WPD_IS0 -> AD70081Z_E21_RTAP_IS
+ * @param range - Input current ranges of AD70081Z_E19_TOND_IS0 ->
+ *                AD70081Z_E19_TOND_IS3
+ * @return SUCCESS in case of success, negative error code otherwise.
+ * @note The rsense registers are at consecutive addresses, so they are written
+ *       byte-wise in a single burst, and the current ranges with a single
+ *       read-modify-write (instead of per channel accesses).
+ */
+int ad70081z_iadc_config_all(struct ad70081z_dev *dev, const uint16_t *rsense,
+			     const enum ad70081z_iadc_range *range)
+{
+	uint16_t regs[AD70081Z_ADDR(AD70081Z_I_ADC7_RSENSE) -
+		      AD70081Z_ADDR(AD70081Z_I_ADC0_RSENSE) + 1];
+	uint32_t mask = 0;
+	uint32_t regval = 0;
+	uint8_t i = 0;
+	uint8_t chn;
+	bool wide;
+	int ret;
+
+	if (!dev || !rsense || !range)
+		return -EINVAL;
+
+	/* IS0/IS1 and TTAP/RTAP rsense are 8-bit, TOND_ISx are 16-bit (low byte
+	 * at lower address) */
+	for (chn = 0; chn <= AD70081Z_E21_RTAP_IS - AD70081Z_E10_WPD_IS0; chn++) {
+		wide = (chn >= AD70081Z_E19_TOND_IS0 - AD70081Z_E10_WPD_IS0 &&
+			chn <= AD70081Z_E19_TOND_IS3 - AD70081Z_E10_WPD_IS0);
+
+		regs[i++] = (uint8_t)rsense[chn];
+		if (wide)
+			regs[i++] = (uint8_t)(rsense[chn] >> 8);
+
+		dev->iadc_rsense[chn] = wide ? rsense[chn] : (uint8_t)rsense[chn];
+	}
+
+	ret = ad70081z_spi_reg_write_burst(dev,
+					   AD70081Z_R1B | AD70081Z_ADDR(AD70081Z_I_ADC0_RSENSE),
+					   regs, i);
+	if (ret)
+		return ret;
+
+	for (chn = 0; chn <= AD70081Z_E19_TOND_IS3 - AD70081Z_E19_TOND_IS0; chn++) {
+		mask |= 0x3 << (2 * chn);
+		regval |= field_prep(0x3 << (2 * chn), range[chn]);
+	}
+
+	ret = ad70081z_spi_reg_write_mask(dev, AD70081Z_I_ADC_TOND_INPUT_CURRENT_RANGE,
+					  mask, regval);
+	if (ret)
+		return ret;
+
+	for (chn = 0; chn <= AD70081Z_E19_TOND_IS3 - AD70081Z_E19_TOND_IS0; chn++)
+		dev->idac_current_range[chn] = range[chn];
+
+	return SUCCESS;
+}
@@ -43,6 +43,7 @@
 #include <stdbool.h>
 #include <spi.h>
 #include <gpio.h>
+#include "gpio_fast.h"
 
 #define AD70081Z_R1B				(1ul << 16)
 #define AD70081Z_R2B				(2ul << 16)
@@ -321,6 +322,12 @@ struct ad70081z_dev {
 	gpio_desc				*gpio_tgp;
 	bool					gpio_tgp_state;
 	gpio_desc				*gpio_convst;
+	/* Fast GPIO pins (cached port/mask) for timing critical pulses */
+	struct gpio_fast_pin			fast_ldac_n;
+	struct gpio_fast_pin			fast_tgp;
+	struct gpio_fast_pin			fast_convst;
+	/* Min width of fast GPIO pulses in core clock cycles */
+	uint32_t				fast_pulse_cycles;
 
 	/* Device SPI Settings */
 	struct ad70081z_device_spi_settings	dev_spi_settings;
@@ -333,6 +340,10 @@ struct ad70081z_dev {
 	uint16_t iadc_rsense[8];
 	/* IADC current range values for TOND_ISx channels */
 	enum ad70081z_iadc_range idac_current_range[4];
+	/* Cached I_ADC_IN_HI_Z register value */
+	uint16_t iadc_in_hi_z;
+	/* Register access SPI transactions in progress (nesting count) */
+	volatile uint8_t spi_busy;
 };
 
 struct ad70081z_init_param {
@@ -375,6 +386,11 @@ int ad70081z_spi_reg_write_mask(struct ad70081z_dev *dev,
 				uint32_t reg_addr,
 				uint32_t mask,
 				uint32_t data);
+int ad70081z_spi_reg_write_burst(struct ad70081z_dev *dev,
+				 uint32_t first_reg,
+				 const uint16_t *reg_data,
+				 uint8_t nb_of_regs);
+bool ad70081z_spi_is_busy(struct ad70081z_dev *dev);
 int ad70081z_set_device_spi(struct ad70081z_dev *dev,
 			    const struct ad70081z_device_spi_settings *spi_settings);
 int ad70081z_set_device_config(struct ad70081z_dev *dev,
@@ -394,6 +410,11 @@ int ad70081z_set_dac_value(struct ad70081z_dev *dev, uint16_t dac_value,
 			   enum ad70081z_channel channel);
 int ad70081z_set_dac_input(struct ad70081z_dev *dev, uint16_t dac_input,
 			   enum ad70081z_input input, enum ad70081z_channel channel);
+int ad70081z_set_dac_input_burst(struct ad70081z_dev *dev,
+				 const uint16_t *dac_input,
+				 enum ad70081z_input input,
+				 enum ad70081z_channel first_ch,
+				 uint8_t nb_of_ch);
 int ad70081z_set_idac_shutdown(struct ad70081z_dev *dev,
 			       enum ad70081z_channel chn, bool enable);
 int ad70081z_set_compare(struct ad70081z_dev *dev, bool enable);
@@ -434,9 +455,12 @@ int ad70081z_cc_read(struct ad70081z_dev *dev,
 		     enum ad70081z_afe_mux_channel *nextch, uint16_t *data);
 int ad70081z_iadc_enable(struct ad70081z_dev *dev,
 			 enum ad70081z_afe_mux_channel ch, bool enable);
+int ad70081z_iadc_enable_mask(struct ad70081z_dev *dev, uint8_t mask);
 int ad70081z_iadc_config(struct ad70081z_dev *dev,
 			 enum ad70081z_afe_mux_channel ch, enum ad70081z_iadc_range range);
 int ad70081z_iadc_rsense_config(struct ad70081z_dev *dev,
 				enum ad70081z_afe_mux_channel ch, uint16_t rsense_val);
+int ad70081z_iadc_config_all(struct ad70081z_dev *dev, const uint16_t *rsense,
+			     const enum ad70081z_iadc_range *range);
 
 #endif /* AD70081Z_H_ */
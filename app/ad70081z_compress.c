@@ -0,0 +1,334 @@
+/***************************************************************************//**
+ *   @file    ad70081z_compress.c
+ *   @brief   Compressed ADC data stream for AD70081z IIO application
+ *   @details This module captures the ADC data in fixed size blocks and
+ *            compresses every block (per channel delta, zig-zag and Rice
+ *            coding) into the IIO buffer, so that more samples are delivered
+ *            per byte on bandwidth limited links. Slow moving channels
+ *            compress to a few bits per sample. Blocks that do not compress
+ *            are stored raw. The data is captured back to back while a block
+ *            is compressed, and a block following lost scans is flagged
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include "ad70081z_compress.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_iio.h"
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Max value of Rice parameter (fits in COMPRESS_RICE_K_BITS) */
+#define COMPRESS_RICE_K_MAX		15
+
+/* Compression ratio scale (ratio is reported in units of 1/100) */
+#define COMPRESS_RATIO_SCALE	100
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/*
+ *@struct	bit_writer_t
+ *@details	Structure holding the state of MSB first bit stream writer
+ **/
+typedef struct {
+	uint8_t *buf;			// Stream buffer (cleared before writing)
+	uint32_t max_bits;		// Capacity of stream buffer in bits
+	uint32_t bit_pos;		// Number of bits written
+	bool overflow;			// Stream exceeded the capacity
+} bit_writer_t;
+
+/* Raw (uncompressed) data of a block */
+static uint16_t raw_block[COMPRESS_BLOCK_SCANS * ADC_CHN_COUNT];
+
+/* Compressed stream mode status */
+static bool stream_compression_enabled;
+
+/* Compression ratio achieved for last buffer read */
+static uint32_t stream_compression_ratio = COMPRESS_RATIO_SCALE;
+
+/* Scan index expected for the next block, if continuous with last block */
+static uint32_t next_block_scan_index;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Enable/Disable the compressed stream mode of ADC IIO buffer
+ * @param	enable[in] - true to compress the captured data, else false
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t set_stream_compression(bool enable)
+{
+	stream_compression_enabled = enable;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Get the compressed stream mode status of ADC IIO buffer
+ * @return	true if compressed stream mode is enabled, else false
+ */
+bool is_stream_compression_enabled(void)
+{
+	return stream_compression_enabled;
+}
+
+/*!
+ * @brief	Get the compression ratio achieved for last buffer read
+ * @return	Ratio of captured data size to buffer size (in units of 1/100)
+ */
+uint32_t get_stream_compression_ratio(void)
+{
+	return stream_compression_ratio;
+}
+
+/*!
+ * @brief	Write the bits into bit stream
+ * @param	bw[in,out] - Bit stream writer
+ * @param	val[in] - Bits value (right aligned)
+ * @param	nbits[in] - Number of bits to write (max 32)
+ * @return	none
+ */
+static void put_bits(bit_writer_t *bw, uint32_t val, uint8_t nbits)
+{
+	if (bw->bit_pos + nbits > bw->max_bits) {
+		bw->overflow = true;
+		return;
+	}
+
+	while (nbits--) {
+		if (val & (1ul << nbits))
+			bw->buf[bw->bit_pos >> 3] |= (0x80 >> (bw->bit_pos & 0x7));
+
+		bw->bit_pos++;
+	}
+}
+
+/*!
+ * @brief	Map the signed delta to unsigned (zig-zag) value
+ * @param	delta[in] - Signed delta
+ * @return	Zig-zag value (0, -1, 1, -2, 2... maps to 0, 1, 2, 3, 4...)
+ */
+static uint32_t zigzag_encode(int32_t delta)
+{
+	return ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+}
+
+/*!
+ * @brief	Find the Rice parameter for deltas of a channel
+ * @param	samples[in] - Raw block (interleaved channels)
+ * @param	num_of_scans[in] - Number of samples per channel
+ * @param	num_of_chns[in] - Number of channels
+ * @param	chn[in] - Channel index in block
+ * @return	Rice parameter (k)
+ */
+static uint8_t get_rice_param(const uint16_t *samples, uint8_t num_of_scans,
+			      uint8_t num_of_chns, uint8_t chn)
+{
+	uint32_t sum = 0;
+	uint32_t count = num_of_scans - 1;
+	uint8_t k = 0;
+
+	for (uint8_t scan = 1; scan < num_of_scans; scan++) {
+		sum += zigzag_encode((int32_t)samples[scan * num_of_chns + chn] -
+				     (int32_t)samples[(scan - 1) * num_of_chns + chn]);
+	}
+
+	/* Smallest k with 2^k not less than mean value */
+	while ((k < COMPRESS_RICE_K_MAX) && ((count << k) < sum))
+		k++;
+
+	return k;
+}
+
+/*!
+ * @brief	Compress the raw block
+ * @param	samples[in] - Raw block (interleaved channels)
+ * @param	num_of_scans[in] - Number of samples per channel
+ * @param	num_of_chns[in] - Number of channels
+ * @param	out[out] - Compressed payload
+ * @param	raw_bytes[in] - Size of raw block (max payload size)
+ * @return	Size of compressed payload, 0 if block does not compress
+ */
+static uint32_t compress_block(const uint16_t *samples, uint8_t num_of_scans,
+			       uint8_t num_of_chns, uint8_t *out, uint32_t raw_bytes)
+{
+	bit_writer_t bw = {
+		.buf = out,
+		.max_bits = (raw_bytes - 1) * 8,
+		.bit_pos = 0,
+		.overflow = false
+	};
+	uint32_t val;
+	uint32_t q;
+	uint8_t k;
+
+	memset(out, 0, raw_bytes);
+
+	for (uint8_t chn = 0; chn < num_of_chns && !bw.overflow; chn++) {
+		k = get_rice_param(samples, num_of_scans, num_of_chns, chn);
+
+		put_bits(&bw, k, COMPRESS_RICE_K_BITS);
+		put_bits(&bw, samples[chn], 16);
+
+		for (uint8_t scan = 1; scan < num_of_scans && !bw.overflow; scan++) {
+			val = zigzag_encode((int32_t)samples[scan * num_of_chns + chn] -
+					    (int32_t)samples[(scan - 1) * num_of_chns + chn]);
+			q = val >> k;
+
+			if (q < COMPRESS_RICE_ESCAPE) {
+				/* q ones terminated by a zero, followed by k LSBs */
+				put_bits(&bw, ((1ul << q) - 1) << 1, q + 1);
+				put_bits(&bw, val & ((1ul << k) - 1), k);
+			} else {
+				put_bits(&bw, (1ul << COMPRESS_RICE_ESCAPE) - 1, COMPRESS_RICE_ESCAPE);
+				put_bits(&bw, val, COMPRESS_ZIGZAG_BITS);
+			}
+		}
+	}
+
+	if (bw.overflow)
+		return 0;
+
+	return (bw.bit_pos + 7) >> 3;
+}
+
+/*!
+ * @brief	Capture a block of data and compress it
+ * @param	out[out] - Block output (header and payload)
+ * @param	space[in] - Space available for block output (in bytes)
+ * @param	block_bytes[out] - Size of block output (header and payload)
+ * @param	raw_bytes[out] - Size of captured (uncompressed) data
+ * @param	scan_index[out] - Index of the first scan of block (counted since
+ *			the capture start, including the lost scans)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Block holds up to COMPRESS_BLOCK_SCANS scans, limited to what fits
+ *			into the available space even if block is stored raw
+ */
+int32_t capture_compressed_block(uint8_t *out, uint32_t space,
+				 uint32_t *block_bytes, uint32_t *raw_bytes,
+				 uint32_t *scan_index)
+{
+	uint8_t num_of_chns = get_num_of_active_channels();
+	uint32_t num_of_scans;
+	uint32_t payload;
+	uint8_t flags = 0;
+	int32_t ret;
+
+	if (!out || !block_bytes || !raw_bytes || !scan_index || !num_of_chns
+	    || num_of_chns > ADC_CHN_COUNT)
+		return -EINVAL;
+
+	if (space <= COMPRESS_BLOCK_HEADER_SIZE)
+		return -ENOMEM;
+
+	num_of_scans = (space - COMPRESS_BLOCK_HEADER_SIZE) /
+		       (num_of_chns * sizeof(uint16_t));
+	if (!num_of_scans)
+		return -ENOMEM;
+
+	if (num_of_scans > COMPRESS_BLOCK_SCANS)
+		num_of_scans = COMPRESS_BLOCK_SCANS;
+
+	*raw_bytes = num_of_scans * num_of_chns * sizeof(uint16_t);
+
+	/* Next block is captured (by ISR) while this block is compressed */
+	ret = read_stream_data(raw_block, num_of_scans, scan_index);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	/* First block of capture has no preceding block */
+	if (*scan_index && *scan_index != next_block_scan_index)
+		flags |= COMPRESS_BLOCK_FLAG_GAP;
+	next_block_scan_index = *scan_index + num_of_scans;
+
+	payload = compress_block(raw_block, num_of_scans, num_of_chns,
+				 out + COMPRESS_BLOCK_HEADER_SIZE, *raw_bytes);
+	if (!payload) {
+		memcpy(out + COMPRESS_BLOCK_HEADER_SIZE, raw_block, *raw_bytes);
+		payload = *raw_bytes;
+		flags |= COMPRESS_BLOCK_FLAG_RAW;
+	}
+
+	out[0] = (uint8_t)payload;
+	out[1] = (uint8_t)(payload >> 8);
+	out[2] = (uint8_t)num_of_scans;
+	out[3] = flags;
+
+	*block_bytes = COMPRESS_BLOCK_HEADER_SIZE + payload;
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Capture the data and read the compressed blocks into buffer
+ * @param	pbuf[out] - Pointer to ADC data buffer
+ * @param	nb_of_samples[in] - Number of samples (scans) requested by IIO client
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @details	Blocks are captured and compressed until the buffer size of the
+ *			requested samples is filled, the rest of buffer is zero padded
+ */
+int32_t read_compressed_data(void *pbuf, uint32_t nb_of_samples)
+{
+	uint8_t *pout = pbuf;
+	uint32_t capacity;
+	uint32_t remaining;
+	uint32_t captured_bytes = 0;
+	uint32_t block_bytes;
+	uint32_t raw_bytes;
+	uint32_t scan_index;
+	int32_t ret;
+
+	if (!pbuf)
+		return -EINVAL;
+
+	capacity = nb_of_samples * get_num_of_active_channels() * sizeof(uint16_t);
+	remaining = capacity;
+
+	while (remaining > COMPRESS_BLOCK_HEADER_SIZE) {
+		ret = capture_compressed_block(pout, remaining, &block_bytes, &raw_bytes,
+					       &scan_index);
+		if (ret == -ENOMEM)
+			break;
+
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		pout += block_bytes;
+		remaining -= block_bytes;
+		captured_bytes += raw_bytes;
+	}
+
+	/* Zero header terminates the block sequence */
+	memset(pout, 0, remaining);
+
+	if (capacity) {
+		stream_compression_ratio = (uint32_t)(((uint64_t)captured_bytes *
+						       COMPRESS_RATIO_SCALE) / capacity);
+	}
+
+	return SUCCESS;
+}
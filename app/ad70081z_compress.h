@@ -0,0 +1,66 @@
+/***************************************************************************//**
+ *   @file   ad70081z_compress.h
+ *   @brief  Header for AD70081z compressed ADC data stream
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_COMPRESS_H_
+#define _AD70081Z_COMPRESS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/*
+ * Compressed stream format (must match host side decoder):
+ * The IIO buffer holds a sequence of blocks, terminated by a zero header (or
+ * end of buffer). Every block starts with a 4 byte header:
+ *   payload_bytes(2, LE) | num_of_scans(1) | flags(1)
+ * COMPRESS_BLOCK_FLAG_GAP is set if scans were lost (not captured) between
+ * the previous block of the capture and this block, else the blocks are
+ * continuous (also across buffer reads).
+ * If COMPRESS_BLOCK_FLAG_RAW is set, payload holds the 16-bit (LE) samples
+ * as captured (interleaved channels). Otherwise payload is a MSB first bit
+ * stream holding for every active channel in turn:
+ *   k(4) | first sample(16) | (num_of_scans - 1) Rice coded deltas
+ * Every delta (from previous sample of channel) is zig-zag mapped and Rice
+ * coded with parameter k as: q one bits, a zero bit and k LSBs, where
+ * q = value >> k. If q >= COMPRESS_RICE_ESCAPE, COMPRESS_RICE_ESCAPE one bits
+ * are followed by the 17-bit zig-zag value instead.
+ */
+#define COMPRESS_BLOCK_HEADER_SIZE	4
+#define COMPRESS_BLOCK_FLAG_RAW		0x01
+#define COMPRESS_BLOCK_FLAG_GAP		0x02
+#define COMPRESS_RICE_ESCAPE		16
+#define COMPRESS_RICE_K_BITS		4
+#define COMPRESS_ZIGZAG_BITS		17
+
+/* Max number of scans (samples per channel) in a block */
+#define COMPRESS_BLOCK_SCANS		32
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+int32_t set_stream_compression(bool enable);
+bool is_stream_compression_enabled(void);
+uint32_t get_stream_compression_ratio(void);
+int32_t capture_compressed_block(uint8_t *out, uint32_t space,
+				 uint32_t *block_bytes, uint32_t *raw_bytes,
+				 uint32_t *scan_index);
+int32_t read_compressed_data(void *pbuf, uint32_t nb_of_samples);
+
+#endif /* _AD70081Z_COMPRESS_H_ */
@@ -0,0 +1,462 @@
+/***************************************************************************//**
+ *   @file    ad70081z_config_store.c
+ *   @brief   AD70081z configuration store (save/restore in flash)
+ *   @details The operating point of the device (DAC codes and masks, IADC
+ *            rsense/range, OSR, sampling rate and calibrated max sampling
+ *            rates) is serialized as a list of key/length/value items and
+ *            kept in the wear levelled flash store of the platform. On
+ *            restore, the items are applied in the order they were saved,
+ *            with the consecutive DAC registers written in SPI bursts.
+ *            Items with unknown keys are skipped
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include "ad70081z_config_store.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_iio.h"
+#include "ad70081z.h"
+#include "app_config.h"
+#include "error.h"
+#include "util.h"
+
+#if defined(ENABLE_CONFIG_STORE)
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Stored configuration header */
+#define CONFIG_STORE_MAGIC			0xAD70
+#define CONFIG_STORE_VERSION		1
+
+/* Size of serialized configuration buffer */
+#define CONFIG_STORE_BUF_SIZE		512
+
+/* DAC mask/toggle registers (CMP_MASK0 -> TOGGLE_ENABLE3, 1-byte registers at
+ * consecutive addresses) */
+#define CONFIG_MASK_REGS_FIRST		AD70081Z_CMP_MASK0
+#define CONFIG_MASK_REGS_COUNT		(AD70081Z_ADDR(AD70081Z_TOGGLE_ENABLE3) - \
+					 AD70081Z_ADDR(AD70081Z_CMP_MASK0) + 1)
+
+/* DAC SW LDAC mask registers (SW_LDAC0_MASK -> SW_LDAC3_MASK) */
+#define CONFIG_SW_LDAC_REGS_FIRST	AD70081Z_SW_LDAC0_MASK
+#define CONFIG_SW_LDAC_REGS_COUNT	(AD70081Z_ADDR(AD70081Z_SW_LDAC3_MASK) - \
+					 AD70081Z_ADDR(AD70081Z_SW_LDAC0_MASK) + 1)
+
+/* Number of IADC channels and of TOND_ISx channels with current range */
+#define CONFIG_IADC_CHN_COUNT		(AD70081Z_E21_RTAP_IS - AD70081Z_E10_WPD_IS0 + 1)
+#define CONFIG_IADC_RANGE_COUNT		(AD70081Z_E19_TOND_IS3 - AD70081Z_E19_TOND_IS0 + 1)
+
+/* Number of OSRs */
+#define CONFIG_OSR_COUNT			(AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_64 + 1)
+
+/* Item values are 4 byte aligned */
+#define CONFIG_ITEM_ALIGN(len)		(((len) + 3) & ~3U)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Configuration item keys (values of existing keys must not change) */
+enum config_store_key {
+	CONFIG_KEY_MAX_SAMPLING_RATES = 1,
+	CONFIG_KEY_OSR,
+	CONFIG_KEY_SAMPLING_RATE,
+	CONFIG_KEY_IADC_RANGE,
+	CONFIG_KEY_IADC_RSENSE,
+	CONFIG_KEY_DAC_MASK_REGS,
+	CONFIG_KEY_DAC_SW_LDAC_MASK_REGS,
+	CONFIG_KEY_DAC_INPUT_A,
+	CONFIG_KEY_DAC_INPUT_B,
+	CONFIG_KEY_DAC_DATA
+};
+
+/* Stored configuration header */
+struct config_store_header {
+	uint16_t magic;
+	uint16_t version;
+};
+
+/* Configuration item header (followed by the value) */
+struct config_store_item {
+	uint8_t key;
+	uint8_t reserved;
+	uint16_t len;
+};
+
+/* IADC configuration collected from the stored items, applied at once */
+struct config_store_iadc {
+	uint16_t rsense[CONFIG_IADC_CHN_COUNT];
+	enum ad70081z_iadc_range range[CONFIG_IADC_RANGE_COUNT];
+	bool updated;
+};
+
+/* Serialized configuration (word aligned for the item values) */
+static uint32_t config_store_buf[CONFIG_STORE_BUF_SIZE / sizeof(uint32_t)];
+
+/* Length of serialized configuration */
+static uint32_t config_store_len;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Append an item to the serialized configuration
+ * @param	key[in] - Item key
+ * @param	value[in] - Item value
+ * @param	len[in] - Length of item value in bytes
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t config_store_add_item(enum config_store_key key,
+				     const void *value, uint16_t len)
+{
+	uint8_t *buf = (uint8_t *)config_store_buf;
+	struct config_store_item item = {
+		.key = (uint8_t)key,
+		.len = len
+	};
+
+	if (config_store_len + sizeof(item) + CONFIG_ITEM_ALIGN(len) >
+	    sizeof(config_store_buf))
+		return -ENOMEM;
+
+	memcpy(&buf[config_store_len], &item, sizeof(item));
+	config_store_len += sizeof(item);
+
+	memcpy(&buf[config_store_len], value, len);
+	config_store_len += CONFIG_ITEM_ALIGN(len);
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Read the consecutive device registers of the same size
+ * @param	first_reg[in] - First (lowest) register address
+ * @param	reg_data[out] - Register values
+ * @param	nb_of_regs[in] - Number of registers
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t config_store_read_regs(uint32_t first_reg, uint16_t *reg_data,
+				      uint8_t nb_of_regs)
+{
+	uint32_t reg = first_reg;
+	uint32_t val;
+	int32_t ret;
+
+	for (uint8_t indx = 0; indx < nb_of_regs; indx++) {
+		ret = ad70081z_spi_reg_read(p_ad70081z_dev_inst, reg, &val);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		reg_data[indx] = (uint16_t)val;
+		reg += AD70081Z_TRANSF_LEN(first_reg);
+	}
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Read the device registers and append them as an item
+ * @param	key[in] - Item key
+ * @param	first_reg[in] - First (lowest) register address
+ * @param	nb_of_regs[in] - Number of registers
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t config_store_add_regs(enum config_store_key key,
+				     uint32_t first_reg, uint8_t nb_of_regs)
+{
+	uint16_t reg_data[AD70081Z_VDAC_CH_LIMIT];
+	int32_t ret;
+
+	ret = config_store_read_regs(first_reg, reg_data, nb_of_regs);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	return config_store_add_item(key, reg_data, nb_of_regs * sizeof(uint16_t));
+}
+
+/*!
+ * @brief	Apply an item of the stored configuration
+ * @param	key[in] - Item key
+ * @param	value[in] - Item value (word aligned)
+ * @param	len[in] - Length of item value in bytes
+ * @param	iadc[in,out] - IADC configuration (collected, not applied)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t config_store_apply_item(uint8_t key, const void *value,
+				       uint16_t len, struct config_store_iadc *iadc)
+{
+	const uint8_t *val8 = value;
+	const uint16_t *val16 = value;
+	const uint32_t *val32 = value;
+
+	switch (key) {
+	case CONFIG_KEY_MAX_SAMPLING_RATES:
+		if (len != CONFIG_OSR_COUNT * sizeof(uint32_t))
+			return -EINVAL;
+
+		return set_max_sampling_rates(val32, CONFIG_OSR_COUNT);
+
+	case CONFIG_KEY_OSR:
+		if (len != sizeof(uint8_t) || val8[0] >= CONFIG_OSR_COUNT)
+			return -EINVAL;
+
+		return set_oversampling_ratio((enum ad70081z_adc_config_osr)val8[0]);
+
+	case CONFIG_KEY_SAMPLING_RATE:
+		if (len != sizeof(uint32_t))
+			return -EINVAL;
+
+		return set_sampling_rate(val32[0]);
+
+	case CONFIG_KEY_IADC_RANGE:
+		if (len != CONFIG_IADC_RANGE_COUNT)
+			return -EINVAL;
+
+		for (uint8_t chn = 0; chn < CONFIG_IADC_RANGE_COUNT; chn++) {
+			if (val8[chn] > AD70081Z_IADC_RANGE_5_40uA)
+				return -EINVAL;
+
+			iadc->range[chn] = (enum ad70081z_iadc_range)val8[chn];
+		}
+
+		iadc->updated = true;
+		return SUCCESS;
+
+	case CONFIG_KEY_IADC_RSENSE:
+		if (len != CONFIG_IADC_CHN_COUNT * sizeof(uint16_t))
+			return -EINVAL;
+
+		memcpy(iadc->rsense, val16, sizeof(iadc->rsense));
+
+		iadc->updated = true;
+		return SUCCESS;
+
+	case CONFIG_KEY_DAC_MASK_REGS:
+		if (len != CONFIG_MASK_REGS_COUNT * sizeof(uint16_t))
+			return -EINVAL;
+
+		return ad70081z_spi_reg_write_burst(p_ad70081z_dev_inst,
+						    CONFIG_MASK_REGS_FIRST,
+						    val16, CONFIG_MASK_REGS_COUNT);
+
+	case CONFIG_KEY_DAC_SW_LDAC_MASK_REGS:
+		if (len != CONFIG_SW_LDAC_REGS_COUNT * sizeof(uint16_t))
+			return -EINVAL;
+
+		return ad70081z_spi_reg_write_burst(p_ad70081z_dev_inst,
+						    CONFIG_SW_LDAC_REGS_FIRST,
+						    val16, CONFIG_SW_LDAC_REGS_COUNT);
+
+	case CONFIG_KEY_DAC_INPUT_A:
+	case CONFIG_KEY_DAC_INPUT_B:
+	case CONFIG_KEY_DAC_DATA:
+		if (len != AD70081Z_VDAC_CH_LIMIT * sizeof(uint16_t))
+			return -EINVAL;
+
+		if (key == CONFIG_KEY_DAC_DATA) {
+			return ad70081z_spi_reg_write_burst(p_ad70081z_dev_inst,
+							    AD70081Z_DAC(0),
+							    val16, AD70081Z_VDAC_CH_LIMIT);
+		}
+
+		return ad70081z_set_dac_input_burst(p_ad70081z_dev_inst, val16,
+						    (key == CONFIG_KEY_DAC_INPUT_A ?
+						     AD70081Z_INPUT_A : AD70081Z_INPUT_B),
+						    (enum ad70081z_channel)0,
+						    AD70081Z_VDAC_CH_LIMIT);
+
+	default:
+		/* Item of a newer firmware, skipped */
+		return SUCCESS;
+	}
+}
+
+/*!
+ * @brief	Load the stored configuration into the serialized configuration
+ *			buffer
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t config_store_load(void)
+{
+	struct config_store_header header;
+	int32_t ret;
+
+	ret = aducm410_flash_store_read(config_store_buf, sizeof(config_store_buf),
+					&config_store_len);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	if (config_store_len < sizeof(header))
+		return -EINVAL;
+
+	memcpy(&header, config_store_buf, sizeof(header));
+	if (header.magic != CONFIG_STORE_MAGIC ||
+	    header.version != CONFIG_STORE_VERSION)
+		return -EINVAL;
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Save the current configuration into flash
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t config_store_save(void)
+{
+	struct config_store_header header = {
+		.magic = CONFIG_STORE_MAGIC,
+		.version = CONFIG_STORE_VERSION
+	};
+	uint32_t max_rates[CONFIG_OSR_COUNT];
+	uint32_t rate = get_sampling_rate();
+	uint8_t osr = (uint8_t)p_ad70081z_dev_inst->osr;
+	uint8_t iadc_range[CONFIG_IADC_RANGE_COUNT];
+	int32_t ret;
+
+	memcpy(config_store_buf, &header, sizeof(header));
+	config_store_len = sizeof(header);
+
+	/* Items are applied in this order on restore. Max rates are needed
+	 * before the sampling rate, and the masks before the DAC codes */
+	ret = get_max_sampling_rates(max_rates, CONFIG_OSR_COUNT);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_item(CONFIG_KEY_MAX_SAMPLING_RATES, max_rates,
+				    sizeof(max_rates));
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_item(CONFIG_KEY_OSR, &osr, sizeof(osr));
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_item(CONFIG_KEY_SAMPLING_RATE, &rate, sizeof(rate));
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	for (uint8_t chn = 0; chn < CONFIG_IADC_RANGE_COUNT; chn++) {
+		iadc_range[chn] = (uint8_t)p_ad70081z_dev_inst->idac_current_range[chn];
+	}
+
+	ret = config_store_add_item(CONFIG_KEY_IADC_RANGE, iadc_range,
+				    sizeof(iadc_range));
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_item(CONFIG_KEY_IADC_RSENSE,
+				    p_ad70081z_dev_inst->iadc_rsense,
+				    CONFIG_IADC_CHN_COUNT * sizeof(uint16_t));
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_regs(CONFIG_KEY_DAC_MASK_REGS, CONFIG_MASK_REGS_FIRST,
+				    CONFIG_MASK_REGS_COUNT);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_regs(CONFIG_KEY_DAC_SW_LDAC_MASK_REGS,
+				    CONFIG_SW_LDAC_REGS_FIRST, CONFIG_SW_LDAC_REGS_COUNT);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_regs(CONFIG_KEY_DAC_INPUT_A, AD70081Z_INPUT_A(0),
+				    AD70081Z_VDAC_CH_LIMIT);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_regs(CONFIG_KEY_DAC_INPUT_B, AD70081Z_INPUT_B(0),
+				    AD70081Z_VDAC_CH_LIMIT);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = config_store_add_regs(CONFIG_KEY_DAC_DATA, AD70081Z_DAC(0),
+				    AD70081Z_VDAC_CH_LIMIT);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	return aducm410_flash_store_write(config_store_buf, config_store_len);
+}
+
+/*!
+ * @brief	Restore the configuration saved in flash
+ * @return	SUCCESS in case of success, -ENOENT if no configuration is saved,
+ *			negative error code otherwise
+ */
+int32_t config_store_restore(void)
+{
+	const uint8_t *buf = (const uint8_t *)config_store_buf;
+	struct config_store_item item;
+	struct config_store_iadc iadc;
+	uint32_t offset = sizeof(struct config_store_header);
+	int32_t ret;
+
+	ret = config_store_load();
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	/* Channels missing in the stored items keep their current IADC config */
+	memcpy(iadc.rsense, p_ad70081z_dev_inst->iadc_rsense, sizeof(iadc.rsense));
+	memcpy(iadc.range, p_ad70081z_dev_inst->idac_current_range,
+	       sizeof(iadc.range));
+	iadc.updated = false;
+
+	while (offset + sizeof(item) <= config_store_len) {
+		memcpy(&item, &buf[offset], sizeof(item));
+		offset += sizeof(item);
+
+		if (item.len > config_store_len - offset)
+			return -EINVAL;
+
+		ret = config_store_apply_item(item.key, &buf[offset], item.len, &iadc);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		offset += CONFIG_ITEM_ALIGN(item.len);
+	}
+
+	/* All IADC rsense values and current ranges in a single update */
+	if (iadc.updated)
+		return ad70081z_iadc_config_all(p_ad70081z_dev_inst, iadc.rsense,
+						iadc.range);
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Discard the configuration saved in flash (defaults are used on
+ *			next startup)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t config_store_clear(void)
+{
+	return aducm410_flash_store_erase();
+}
+
+/*!
+ * @brief	Check if a (valid) configuration is saved in flash
+ * @return	true if saved, else false
+ */
+bool is_config_stored(void)
+{
+	return (config_store_load() == SUCCESS);
+}
+
+#endif	// ENABLE_CONFIG_STORE
@@ -0,0 +1,32 @@
+/***************************************************************************//**
+ *   @file   ad70081z_config_store.h
+ *   @brief  Header for AD70081z configuration store (save/restore in flash)
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_CONFIG_STORE_H_
+#define _AD70081Z_CONFIG_STORE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+int32_t config_store_save(void);
+int32_t config_store_restore(void);
+int32_t config_store_clear(void);
+bool is_config_stored(void);
+
+#endif /* _AD70081Z_CONFIG_STORE_H_ */
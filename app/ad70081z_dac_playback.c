@@ -0,0 +1,347 @@
+/***************************************************************************//**
+ *   @file    ad70081z_dac_playback.c
+ *   @brief   DAC buffer playback interface for AD70081z IIO based applications
+ *   @details This module plays out the DAC codes pushed by IIO client through
+ *            output buffer, at a ticker (periodic timer) driven update rate
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "ad70081z_dac_playback.h"
+#include "ad70081z_dac_waveform.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_iio.h"
+#include "app_config.h"
+#include "error.h"
+#include "util.h"
+#include "irq.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Margin (in msec) added to the expected playback time, to avoid stuck into
+ * potential infinite loop in case playback is interrupted or failed in between */
+#define DAC_PLAYBACK_TIMEOUT_MARGIN_MS	(100)
+
+/* Bytes per DAC code in the playback buffer (little endian) */
+#define DAC_BYTES_PER_SAMPLE	(2)
+
+#define USEC_PER_SEC	(1000000ul)
+
+/* Full scale codes of DAC channels */
+#define IDAC_MAX_CODE		(0x3FF)
+#define VDAC12_MAX_CODE		(0xFFF)
+#define VDAC16_MAX_CODE		(0xFFFF)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* DAC data buffer */
+uint8_t dac_data_buffer[DAC_DATA_BUFFER_SIZE] = {0};
+
+/*
+ *@struct	dac_playback_t
+ *@details	Structure holding the DAC buffer playback parameters
+ **/
+typedef struct {
+	volatile bool in_progress;			// Playback status
+	volatile int32_t status;			// Playback error status
+	volatile uint32_t remaining;		// Number of updates (scans) yet to play
+	volatile const uint8_t *pdata;		// Pointer to next code in data buffer
+	uint8_t num_of_active_channels;		// Active channel count
+	uint8_t active_chn[AD70081Z_VDAC_CH_LIMIT];	// Active channel number sequence
+} dac_playback_t;
+
+/* DAC playback parameters */
+static dac_playback_t dac_playback;
+
+/* DAC update (playback) rate in SPS */
+static uint32_t dac_update_rate = DEFAULT_DAC_UPDATE_RATE;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Get the DAC update (playback) rate
+ * @return	DAC update rate in SPS
+ */
+uint32_t get_dac_update_rate(void)
+{
+	return dac_update_rate;
+}
+
+/*!
+ * @brief	Set the DAC update (playback) rate
+ * @param	rate[in] - DAC update rate in SPS
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t set_dac_update_rate(uint32_t rate)
+{
+	if (rate < MIN_DAC_UPDATE_RATE || rate > MAX_DAC_UPDATE_RATE)
+		return -EINVAL;
+
+	if (dac_playback.in_progress || is_dac_waveform_running())
+		return -EBUSY;
+
+	dac_update_rate = rate;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Get the full scale code of DAC channel
+ * @param	chn[in] - DAC channel number
+ * @return	Full scale code
+ */
+uint16_t get_dac_max_code(uint8_t chn)
+{
+	if (chn < AD70081Z_IDAC_CH_LIMIT)
+		return IDAC_MAX_CODE;
+
+	if (chn == AD70081Z_E8_MZDB || chn == AD70081Z_E0_TECC)
+		return VDAC12_MAX_CODE;
+
+	return VDAC16_MAX_CODE;
+}
+
+/*!
+ * @brief	Set the DAC channel to update its output on LDAC event
+ * @param	chn[in] - DAC channel number
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	LDAC pin is used if available, else the software LDAC
+ */
+int32_t enable_dac_ldac_update(uint8_t chn)
+{
+	if (p_ad70081z_dev_inst->gpio_ldac_n) {
+		return ad70081z_set_hw_ldac_mask(p_ad70081z_dev_inst,
+						 (enum ad70081z_channel)chn, true);
+	}
+
+	return ad70081z_set_sw_ldac_mask(p_ad70081z_dev_inst,
+					 (enum ad70081z_channel)chn, true);
+}
+
+/*!
+ * @brief	Load the codes into input A registers and update DAC outputs
+ * @param	chn[in] - DAC channel numbers (in ascending order)
+ * @param	codes[in] - DAC codes for the channels
+ * @param	nb_of_ch[in] - Number of channels
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @details	Each run of consecutive channels is written in a single SPI burst
+ *			and then all channel outputs are updated together through LDAC
+ */
+int32_t update_dac_outputs(const uint8_t *chn, const uint16_t *codes,
+			   uint8_t nb_of_ch)
+{
+	int32_t ret;
+	uint8_t first = 0;
+	uint8_t cnt;
+
+	while (first < nb_of_ch) {
+		cnt = 1;
+		while ((first + cnt) < nb_of_ch && chn[first + cnt] == (chn[first] + cnt)) {
+			cnt++;
+		}
+
+		ret = ad70081z_set_dac_input_burst(p_ad70081z_dev_inst, &codes[first],
+						   AD70081Z_INPUT_A,
+						   (enum ad70081z_channel)chn[first], cnt);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		first += cnt;
+	}
+
+	if (p_ad70081z_dev_inst->gpio_ldac_n)
+		return ad70081z_ldac(p_ad70081z_dev_inst);
+
+	return ad70081z_set_sw_ldac(p_ad70081z_dev_inst, true);
+}
+
+/*!
+ * @brief	Prepare the DAC playback for active channels
+ * @param	ch_mask[in] - Channels to play (bit 'n' selects DAC channel 'n')
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Active channels are set to update their outputs from input A
+ *			register on LDAC event, so that all channels are updated together
+ */
+int32_t prepare_dac_playback(uint32_t ch_mask)
+{
+	int32_t ret;
+
+	if (is_dac_waveform_running())
+		return -EBUSY;
+
+	dac_playback.in_progress = false;
+	dac_playback.num_of_active_channels = 0;
+
+	for (uint8_t chn = 0; chn < AD70081Z_VDAC_CH_LIMIT; chn++) {
+		if (!(ch_mask & BIT(chn)))
+			continue;
+
+		ret = enable_dac_ldac_update(chn);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		dac_playback.active_chn[dac_playback.num_of_active_channels++] = chn;
+	}
+
+	if (!dac_playback.num_of_active_channels)
+		return -EINVAL;
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Play the DAC codes from buffer at the DAC update rate
+ * @param	pbuf[in] - Pointer to DAC data buffer
+ * @param	nb_of_samples[in] - Number of samples (per channel) to play
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Buffer holds the 16-bit little endian codes of all active channels
+ *			for every update, in the ascending order of channel number.
+ *			This function returns after the complete buffer is played
+ */
+int32_t write_dac_playback_data(void *pbuf, uint32_t nb_of_samples)
+{
+	int32_t ret;
+	uint32_t timeout_ms;
+	uint32_t start_time_ms;
+
+	if (!pbuf || !nb_of_samples || !dac_playback.num_of_active_channels)
+		return -EINVAL;
+
+	/* Device can't be accessed by the ticker ISR during an ADC capture */
+	if (is_dac_waveform_running() || is_adc_capture_in_progress())
+		return -EBUSY;
+
+	if ((nb_of_samples * dac_playback.num_of_active_channels * DAC_BYTES_PER_SAMPLE)
+	    > DAC_DATA_BUFFER_SIZE)
+		return -EINVAL;
+
+	ret = set_ticker_period(ticker_int_desc, USEC_PER_SEC / dac_update_rate);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	/* Allow twice the expected playback time */
+	timeout_ms = (uint32_t)(((uint64_t)nb_of_samples * 2000) / dac_update_rate) +
+		     DAC_PLAYBACK_TIMEOUT_MARGIN_MS;
+
+	dac_playback.pdata = (const uint8_t *)pbuf;
+	dac_playback.remaining = nb_of_samples;
+	dac_playback.status = SUCCESS;
+	dac_playback.in_progress = true;
+
+	ret = irq_enable(ticker_int_desc, TICKER_INT_ID);
+	if (IS_ERR_VALUE(ret)) {
+		dac_playback.in_progress = false;
+		return ret;
+	}
+
+	/* Wait for playback to finish */
+	start_time_ms = get_time_ms();
+	while (dac_playback.in_progress
+	       && ((get_time_ms() - start_time_ms) < timeout_ms)) {
+	}
+
+	ret = irq_disable(ticker_int_desc, TICKER_INT_ID);
+
+	if (dac_playback.in_progress) {
+		/* Playback is not complete within timeout */
+		dac_playback.in_progress = false;
+		return FAILURE;
+	}
+
+	if (IS_ERR_VALUE(dac_playback.status))
+		return dac_playback.status;
+
+	return ret;
+}
+
+/*!
+ * @brief	Get the DAC playback status
+ * @return	true if playback is prepared (or playing), else false
+ */
+bool is_dac_playback_in_progress(void)
+{
+	return (dac_playback.in_progress || dac_playback.num_of_active_channels);
+}
+
+/*!
+ * @brief	Stop the DAC playback
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t end_dac_playback(void)
+{
+	dac_playback.in_progress = false;
+	dac_playback.num_of_active_channels = 0;
+
+	if (is_dac_waveform_running())
+		return SUCCESS;
+
+	return irq_disable(ticker_int_desc, TICKER_INT_ID);
+}
+
+/*!
+ * @brief	This is an ISR (Interrupt Service Routine) for the ticker event
+ * @param	*ctx[in] - Callback context (unused)
+ * @param	event[in] - Callback event (unused)
+ * @param	extra[in] - Callback extra (unused)
+ * @return	none
+ * @details	Loads next code of all active channels into their input A registers
+ *			and then updates all the channel outputs together through LDAC.
+ *			The ticker is shared with the on-device waveform generator.
+ *			The update is deferred to the next tick while the device SPI is
+ *			in use by the thread context (or register access is disabled), so
+ *			that the ticker never interleaves with other device transactions
+ */
+void dac_playback_callback(void *ctx, uint32_t event, void *extra)
+{
+	int32_t ret;
+	uint16_t codes[AD70081Z_VDAC_CH_LIMIT];
+
+	if (ad70081z_spi_is_busy(p_ad70081z_dev_inst))
+		return;
+
+	if (is_dac_waveform_running()) {
+		dac_waveform_update();
+		return;
+	}
+
+	if (!dac_playback.in_progress)
+		return;
+
+	for (uint8_t chn = 0; chn < dac_playback.num_of_active_channels; chn++) {
+		codes[chn] = dac_playback.pdata[0] | (dac_playback.pdata[1] << 8);
+		dac_playback.pdata += DAC_BYTES_PER_SAMPLE;
+	}
+
+	ret = update_dac_outputs(dac_playback.active_chn, codes,
+				 dac_playback.num_of_active_channels);
+	if (IS_ERR_VALUE(ret)) {
+		dac_playback.status = ret;
+		dac_playback.in_progress = false;
+		return;
+	}
+
+	if (--dac_playback.remaining == 0)
+		dac_playback.in_progress = false;
+}
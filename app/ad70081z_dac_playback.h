@@ -0,0 +1,54 @@
+/***************************************************************************//**
+ *   @file   ad70081z_dac_playback.h
+ *   @brief  Header for AD70081z DAC buffer playback interfaces
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_DAC_PLAYBACK_H_
+#define _AD70081Z_DAC_PLAYBACK_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_config.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Max size of the DAC playback buffer (in terms of bytes) */
+#if (ACTIVE_PLATFORM == MBED_PLATFORM)
+#define DAC_DATA_BUFFER_SIZE	(8192)		// 8Kbytes
+#else
+#define DAC_DATA_BUFFER_SIZE	(4096)		// 4Kbytes
+#endif
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+extern uint8_t dac_data_buffer[];
+
+int32_t prepare_dac_playback(uint32_t ch_mask);
+int32_t write_dac_playback_data(void *pbuf, uint32_t nb_of_samples);
+int32_t end_dac_playback(void);
+bool is_dac_playback_in_progress(void);
+int32_t set_dac_update_rate(uint32_t rate);
+uint32_t get_dac_update_rate(void);
+uint16_t get_dac_max_code(uint8_t chn);
+int32_t enable_dac_ldac_update(uint8_t chn);
+int32_t update_dac_outputs(const uint8_t *chn, const uint16_t *codes,
+			   uint8_t nb_of_ch);
+void dac_playback_callback(void *ctx, uint32_t event, void *extra);
+
+#endif /* _AD70081Z_DAC_PLAYBACK_H_ */
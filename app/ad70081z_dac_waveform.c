@@ -0,0 +1,360 @@
+/***************************************************************************//**
+ *   @file    ad70081z_dac_waveform.c
+ *   @brief   On-device DAC waveform generator for AD70081z IIO application
+ *   @details This module generates ramp, staircase, sine and triangle waveforms
+ *            on selected DAC channels from the ticker (periodic timer) interrupt,
+ *            without any involvement of the IIO client once started
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <math.h>
+
+#include "ad70081z_dac_waveform.h"
+#include "ad70081z_dac_playback.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_sweep.h"
+#include "ad70081z_iio.h"
+#include "app_config.h"
+#include "error.h"
+#include "irq.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Number of entries in sine lookup table (must be power of 2) */
+#define SINE_TABLE_SIZE		(256)
+#define SINE_TABLE_BITS		(8)
+
+/* Period reported for channels not configured yet */
+#define DAC_WAVEFORM_DEFAULT_PERIOD	(100)
+
+#define USEC_PER_SEC		(1000000ul)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/*
+ *@struct	dac_waveform_gen_t
+ *@details	Structure holding the waveform generator state of a DAC channel
+ **/
+typedef struct {
+	struct dac_waveform_config config;
+	uint32_t phase;			// Phase accumulator (full scale = 1 period)
+	uint32_t phase_inc;		// Phase increment per DAC update
+	uint16_t max_code;		// Full scale code of DAC channel
+} dac_waveform_gen_t;
+
+/* Waveform generator state for all DAC channels */
+static dac_waveform_gen_t dac_waveform_gen[AD70081Z_VDAC_CH_LIMIT];
+
+/* Channels running a waveform (in ascending order) */
+static uint8_t active_chn[AD70081Z_VDAC_CH_LIMIT];
+static uint8_t num_of_active_channels;
+
+/* Generator status */
+static volatile bool waveform_running;
+
+/* Error which stopped the generator (SUCCESS if none) */
+static volatile int32_t waveform_status = SUCCESS;
+
+/* Number of DAC updates since start and the start time, used to find the
+ * achieved update rate */
+static volatile uint32_t num_of_updates;
+static uint32_t start_time_ms;
+
+/* Sine lookup table in offset binary (0 to 65535) format */
+static uint16_t sine_table[SINE_TABLE_SIZE];
+static bool sine_table_ready;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Fill the sine lookup table
+ * @return	none
+ * @note	Computed once (outside of ISR), so that no floating point
+ *			operation is needed at the DAC update rate
+ */
+static void init_sine_table(void)
+{
+	if (sine_table_ready)
+		return;
+
+	for (uint16_t i = 0; i < SINE_TABLE_SIZE; i++) {
+		sine_table[i] = (uint16_t)(32767.5f + 32767.5f *
+					   sinf(2.0f * 3.14159265f * i / SINE_TABLE_SIZE));
+	}
+
+	sine_table_ready = true;
+}
+
+/*!
+ * @brief	Get the waveform generator parameters of DAC channel
+ * @param	chn[in] - DAC channel number
+ * @param	config[out] - Waveform parameters
+ * @return	none
+ */
+void get_dac_waveform_config(uint8_t chn, struct dac_waveform_config *config)
+{
+	if (chn >= AD70081Z_VDAC_CH_LIMIT || !config)
+		return;
+
+	*config = dac_waveform_gen[chn].config;
+
+	/* Report the default period until it is configured */
+	if (!config->period)
+		config->period = DAC_WAVEFORM_DEFAULT_PERIOD;
+}
+
+/*!
+ * @brief	Set the waveform generator parameters of DAC channel
+ * @param	chn[in] - DAC channel number
+ * @param	config[in] - Waveform parameters
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Amplitude, offset, step and period changes are applied on the fly.
+ *			Waveform type can't be changed (-EBUSY) while generator is running
+ */
+int32_t set_dac_waveform_config(uint8_t chn,
+				const struct dac_waveform_config *config)
+{
+	dac_waveform_gen_t *gen;
+	uint16_t max_code;
+	int32_t ret;
+
+	if (chn >= AD70081Z_VDAC_CH_LIMIT || !config
+	    || config->type >= DAC_WAVEFORM_TYPE_MAX
+	    || config->period < DAC_WAVEFORM_MIN_PERIOD) {
+		return -EINVAL;
+	}
+
+	gen = &dac_waveform_gen[chn];
+	max_code = get_dac_max_code(chn);
+
+	if (config->amplitude > max_code || config->offset > max_code)
+		return -EINVAL;
+
+	if (!waveform_running) {
+		gen->max_code = max_code;
+		gen->config = *config;
+		gen->phase_inc = (uint32_t)(0x100000000ull / config->period);
+		return SUCCESS;
+	}
+
+	/* Channel set and sine table are set up on start of generator */
+	if (config->type != gen->config.type)
+		return -EBUSY;
+
+	/* Update the parameters all at once with respect to the ticker ISR */
+	ret = irq_disable(ticker_int_desc, TICKER_INT_ID);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	gen->max_code = max_code;
+	gen->config.amplitude = config->amplitude;
+	gen->config.offset = config->offset;
+	gen->config.step = config->step;
+	gen->config.period = config->period;
+	gen->phase_inc = (uint32_t)(0x100000000ull / config->period);
+
+	return irq_enable(ticker_int_desc, TICKER_INT_ID);
+}
+
+/*!
+ * @brief	Start the waveform generator on all configured channels
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t start_dac_waveform(void)
+{
+	int32_t ret;
+
+	if (waveform_running)
+		return SUCCESS;
+
+	/* DAC outputs are owned by the playback or sweep, and the device can't
+	 * be accessed by the generator during an ADC capture */
+	if (is_dac_playback_in_progress() || is_sweep_in_progress()
+	    || is_adc_capture_in_progress())
+		return -EBUSY;
+
+	num_of_active_channels = 0;
+	for (uint8_t chn = 0; chn < AD70081Z_VDAC_CH_LIMIT; chn++) {
+		if (dac_waveform_gen[chn].config.type == DAC_WAVEFORM_NONE)
+			continue;
+
+		if (dac_waveform_gen[chn].config.type == DAC_WAVEFORM_SINE)
+			init_sine_table();
+
+		ret = enable_dac_ldac_update(chn);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		dac_waveform_gen[chn].phase = 0;
+		active_chn[num_of_active_channels++] = chn;
+	}
+
+	if (!num_of_active_channels)
+		return -EINVAL;
+
+	ret = set_ticker_period(ticker_int_desc, USEC_PER_SEC / get_dac_update_rate());
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	num_of_updates = 0;
+	start_time_ms = get_time_ms();
+	waveform_status = SUCCESS;
+	waveform_running = true;
+
+	ret = irq_enable(ticker_int_desc, TICKER_INT_ID);
+	if (IS_ERR_VALUE(ret)) {
+		waveform_running = false;
+		return ret;
+	}
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Stop the waveform generator
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	DAC outputs hold the last generated codes
+ */
+int32_t stop_dac_waveform(void)
+{
+	waveform_running = false;
+	return irq_disable(ticker_int_desc, TICKER_INT_ID);
+}
+
+/*!
+ * @brief	Get the waveform generator status
+ * @return	true if generator is running, else false
+ */
+bool is_dac_waveform_running(void)
+{
+	return waveform_running;
+}
+
+/*!
+ * @brief	Get the error which stopped the waveform generator
+ * @return	SUCCESS if generator is running or stopped by user, else the
+ *			device communication error code
+ */
+int32_t get_dac_waveform_status(void)
+{
+	return waveform_status;
+}
+
+/*!
+ * @brief	Get the DAC update rate achieved by the waveform generator
+ * @return	Achieved update rate in SPS (averaged since start)
+ */
+uint32_t get_dac_waveform_achieved_rate(void)
+{
+	uint32_t elapsed_ms;
+
+	if (!waveform_running)
+		return 0;
+
+	elapsed_ms = get_time_ms() - start_time_ms;
+	if (!elapsed_ms)
+		return 0;
+
+	return (uint32_t)(((uint64_t)num_of_updates * 1000) / elapsed_ms);
+}
+
+/*!
+ * @brief	Get the next code of waveform and advance its phase
+ * @param	gen[in,out] - Waveform generator state of a channel
+ * @return	DAC code
+ */
+static uint16_t get_next_waveform_code(dac_waveform_gen_t *gen)
+{
+	uint32_t phase = gen->phase;
+	uint32_t amplitude = gen->config.amplitude;
+	uint32_t val;
+	uint32_t tri;
+
+	switch (gen->config.type) {
+	case DAC_WAVEFORM_RAMP:
+		val = (amplitude * (phase >> 16)) >> 16;
+		break;
+
+	case DAC_WAVEFORM_STAIRCASE:
+		val = (amplitude * (phase >> 16)) >> 16;
+		if (gen->config.step)
+			val -= (val % gen->config.step);
+		break;
+
+	case DAC_WAVEFORM_SINE:
+		val = (amplitude * sine_table[phase >> (32 - SINE_TABLE_BITS)]) >> 16;
+		break;
+
+	case DAC_WAVEFORM_TRIANGLE:
+		/* Rise over first half of period and fall over second half */
+		tri = phase >> 15;
+		if (tri > 0xFFFF)
+			tri = 0x1FFFF - tri;
+		val = (amplitude * tri) >> 16;
+		break;
+
+	default:
+		val = 0;
+		break;
+	}
+
+	gen->phase = phase + gen->phase_inc;
+
+	val += gen->config.offset;
+	if (val > gen->max_code)
+		val = gen->max_code;
+
+	return (uint16_t)val;
+}
+
+/*!
+ * @brief	Generate and output the next code of all active channels
+ * @return	none
+ * @note	This is called from the ticker ISR at the DAC update rate, only
+ *			when the device SPI is free (refer dac_playback_callback())
+ */
+void dac_waveform_update(void)
+{
+	uint16_t codes[AD70081Z_VDAC_CH_LIMIT];
+	int32_t ret;
+
+	if (!waveform_running)
+		return;
+
+	for (uint8_t chn = 0; chn < num_of_active_channels; chn++) {
+		codes[chn] = get_next_waveform_code(&dac_waveform_gen[active_chn[chn]]);
+	}
+
+	ret = update_dac_outputs(active_chn, codes, num_of_active_channels);
+	if (IS_ERR_VALUE(ret)) {
+		/* Stop on device communication failure */
+		waveform_status = ret;
+		waveform_running = false;
+		return;
+	}
+
+	num_of_updates++;
+}
@@ -0,0 +1,63 @@
+/***************************************************************************//**
+ *   @file   ad70081z_dac_waveform.h
+ *   @brief  Header for AD70081z on-device DAC waveform generator
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_DAC_WAVEFORM_H_
+#define _AD70081Z_DAC_WAVEFORM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Min number of DAC updates per waveform period */
+#define DAC_WAVEFORM_MIN_PERIOD		(2)
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/* Waveform types. Every waveform spans from 'offset' to 'offset + amplitude' */
+enum dac_waveform_type {
+	DAC_WAVEFORM_NONE,
+	DAC_WAVEFORM_RAMP,			// Sawtooth ramp
+	DAC_WAVEFORM_STAIRCASE,		// Ramp quantized to 'step' codes
+	DAC_WAVEFORM_SINE,
+	DAC_WAVEFORM_TRIANGLE,		// Triangle (small amplitude for dithering)
+	DAC_WAVEFORM_TYPE_MAX
+};
+
+/* Waveform generator parameters of a DAC channel */
+struct dac_waveform_config {
+	enum dac_waveform_type type;
+	uint16_t amplitude;		// Peak to peak amplitude in codes
+	uint16_t offset;		// Min (start) code of waveform
+	uint16_t step;			// Step height in codes (staircase)
+	uint32_t period;		// Number of DAC updates per waveform period
+};
+
+void get_dac_waveform_config(uint8_t chn, struct dac_waveform_config *config);
+int32_t set_dac_waveform_config(uint8_t chn,
+				const struct dac_waveform_config *config);
+int32_t start_dac_waveform(void);
+int32_t stop_dac_waveform(void);
+bool is_dac_waveform_running(void);
+int32_t get_dac_waveform_status(void);
+uint32_t get_dac_waveform_achieved_rate(void);
+void dac_waveform_update(void);
+
+#endif /* _AD70081Z_DAC_WAVEFORM_H_ */
@@ -20,10 +20,14 @@
 #include <string.h>
 
 #include "ad70081z_data_capture.h"
+#include "ad70081z_dac_waveform.h"
 #include "ad70081z_iio.h"
 #include "app_config.h"
 #include "error.h"
 #include "delay.h"
+#include "util.h"
+#include "pwm.h"
+#include "app_profile.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -33,20 +37,48 @@
  * to be captured are supplied from an application */
 #define MAX_AVAILABLE_CHANNELS		(32)
 
-/* Timeout count to avoid stuck into potential infinite loop while checking
- * for new data into an acquisition buffer. The actual timeout factor is determined
- * through 'sampling_frequency' attribute of IIO app, but this period here makes sure
- * we are not stuck into a forever loop in case data capture is interrupted
- * or failed in between.
- * Note: This timeout factor is dependent upon the MCU clock frequency. Below timeout
- * is tested for SDP-K1 platform @180Mhz default core clock */
-#define BUF_READ_TIMEOUT	(100000000)
+/* Margin (in msec) added to the expected buffer fill time to avoid stuck into
+ * potential infinite loop while checking for new data into an acquisition buffer.
+ * The expected fill time is determined through 'sampling_frequency' attribute of
+ * IIO app, but this margin makes sure we are not stuck into a forever loop in case
+ * data capture is interrupted or failed in between */
+#define BUF_READ_TIMEOUT_MARGIN_MS	(100)
+
+/* Max achievable sampling rates for different values of OSR */
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+#define MAX_SAMPLING_RATE_OSR0		SAMPLING_RATE_CC_OSR0
+#define MAX_SAMPLING_RATE_OSR4		SAMPLING_RATE_CC_OSR4
+#define MAX_SAMPLING_RATE_OSR16		SAMPLING_RATE_CC_OSR16
+#define MAX_SAMPLING_RATE_OSR64		SAMPLING_RATE_CC_OSR64
+#else
+#define MAX_SAMPLING_RATE_OSR0		SAMPLING_RATE_BURST_OSR0
+#define MAX_SAMPLING_RATE_OSR4		SAMPLING_RATE_BURST_OSR4
+#define MAX_SAMPLING_RATE_OSR16		SAMPLING_RATE_BURST_OSR16
+#define MAX_SAMPLING_RATE_OSR64		SAMPLING_RATE_BURST_OSR64
+#endif
+
+#define USEC_PER_SEC	(1000000ul)
+#define NSEC_PER_SEC	(1000000000ul)
+
+/* Number of samples timed per OSR for sampling rate calibration */
+#define CALIBRATION_SAMPLE_COUNT	(256)
+
+/* Margin (in percent) of the sampling period over the timed capture loop, to
+ * cover the interrupt entry/exit overhead and run-to-run variations */
+#define CALIBRATION_MARGIN_PERCENT	(20)
+
+/* Input channel sampled for sampling rate calibration */
+#define CALIBRATION_CHN		AD70081Z_E1_CTHRM_VS
 
 /* ADC conversion delay in usec for different values of OSR */
 #define OSR4_CONV_DELAY_USEC	4
 #define OSR16_CONV_DELAY_USEC	14
 #define OSR64_CONV_DELAY_USEC	66
 
+/* Check if input channel is an IADC channel and get its enable mask bit */
+#define IS_IADC_CHN(chn)	((chn) >= AD70081Z_E10_WPD_IS0 && (chn) <= AD70081Z_E21_RTAP_IS)
+#define IADC_CHN_MASK(chn)	BIT((chn) - AD70081Z_E10_WPD_IS0)
+
 /******************************************************************************/
 /********************** Variables and User Defined Data Types *****************/
 /******************************************************************************/
@@ -86,6 +118,9 @@ static volatile bool start_adc_data_capture = false;
 /* Number of active channels in any data buffer read request */
 static volatile uint8_t num_of_active_channels = 0;
 
+/* Channel mask of active channels (set by IIO client) */
+static uint32_t active_channel_mask = 0;
+
 /* Channel data alignment variables */
 static volatile bool do_chn_alignment = false;
 
@@ -95,6 +130,63 @@ static volatile uint16_t num_of_requested_samples = 0;
 /* Conversion delay for different values of OSR */
 static uint8_t osr_delay_us;
 
+/* Sampling period (in usec) for burst mode capture */
+static uint32_t burst_sample_period_us;
+
+/* Sampling rate (in SPS) for buffered data capture */
+static uint32_t sampling_rate = SAMPLING_RATE;
+
+/* Max achievable sampling rates (in SPS), indexed by OSR. Replaced by the
+ * measured rates once calibrated */
+static uint32_t max_sampling_rate[] = {
+	[AD70081Z_ADC_CONFIG_OSR_NO_OVERSAMPLING] = MAX_SAMPLING_RATE_OSR0,
+	[AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_4] = MAX_SAMPLING_RATE_OSR4,
+	[AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_16] = MAX_SAMPLING_RATE_OSR16,
+	[AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_64] = MAX_SAMPLING_RATE_OSR64
+};
+
+/* Flag to indicate a single channel mini-burst capture is in progress */
+static volatile bool mini_burst_in_progress = false;
+
+/* IADC channels kept enabled after recent accesses (disabled lazily) */
+static uint8_t iadc_lazy_en_mask = 0;
+
+/* Time of last access to lazily enabled IADC channels */
+static uint32_t iadc_last_access_ms;
+
+/* Idle period after which lazily enabled IADC channels are disabled */
+static uint32_t iadc_idle_timeout_ms = DEFAULT_IADC_IDLE_TIMEOUT_MS;
+
+/* Streamed data read status (scans are captured back to back across reads) */
+static volatile bool stream_capture = false;
+
+/* Index of the next scan to be read in the streamed data (counted since the
+ * capture start, including the lost scans) */
+static uint32_t stream_scan_index;
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/* Ring holding the scans captured in between the streamed data reads */
+static uint16_t stream_ring[STREAM_RING_SIZE];
+
+/* Stream ring write (ISR) and read positions, and total number of samples
+ * written and read */
+static uint32_t stream_wr_pos;
+static uint32_t stream_rd_pos;
+static volatile uint32_t stream_wr_count;
+static volatile uint32_t stream_rd_count;
+
+/* Stream ring overrun status and number of scans dropped by ISR (total) */
+static volatile bool stream_overrun;
+static volatile uint32_t stream_dropped_scans;
+static uint32_t stream_dropped_seen;
+
+/* Current scan is dropped (scans are stored whole or dropped whole) */
+static bool stream_drop_scan;
+#else
+/* Time at which next scan of the streamed data is due */
+static uint32_t stream_next_scan_us;
+#endif
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -103,37 +195,457 @@ static uint8_t osr_delay_us;
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/*!
+ * @brief	Disable all the lazily enabled IADC channels
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t iadc_lazy_disable(void)
+{
+	int32_t ret;
+
+	ret = ad70081z_iadc_enable_mask(p_ad70081z_dev_inst, 0);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	iadc_lazy_en_mask = 0;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Enable IADC channels (in a single transaction), retaining the
+ *			channels which are already lazily enabled
+ * @param	mask[in] - IADC channels to enable
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t iadc_lazy_enable(uint8_t mask)
+{
+	int32_t ret;
+
+	ret = ad70081z_iadc_enable_mask(p_ad70081z_dev_inst, iadc_lazy_en_mask | mask);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	iadc_lazy_en_mask |= mask;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Mark the end of an access to lazily enabled IADC channels
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Channels are disabled immediately if idle timeout is 0
+ */
+static int32_t iadc_lazy_release(void)
+{
+	iadc_last_access_ms = get_time_ms();
+
+	if (iadc_lazy_en_mask && !iadc_idle_timeout_ms)
+		return iadc_lazy_disable();
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Disable the lazily enabled IADC channels once idle timeout expires
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	This must be called periodically from the application main loop
+ */
+int32_t iadc_idle_check(void)
+{
+	if (!iadc_lazy_en_mask || start_adc_data_capture || mini_burst_in_progress)
+		return SUCCESS;
+
+	if ((uint32_t)(get_time_ms() - iadc_last_access_ms) < iadc_idle_timeout_ms)
+		return SUCCESS;
+
+	return iadc_lazy_disable();
+}
+
+/*!
+ * @brief	Set the idle timeout for lazily enabled IADC channels
+ * @param	timeout_ms[in] - Idle timeout in msec (0 = disable after each access)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t set_iadc_idle_timeout(uint32_t timeout_ms)
+{
+	iadc_idle_timeout_ms = timeout_ms;
+	return iadc_idle_check();
+}
+
+/*!
+ * @brief	Get the idle timeout for lazily enabled IADC channels
+ * @return	Idle timeout in msec
+ */
+uint32_t get_iadc_idle_timeout(void)
+{
+	return iadc_idle_timeout_ms;
+}
+
 /*!
  * @brief	Function to read the single ADC sample (raw data) for input channel
  * @param	input_chn[in] - Input channel to sample and read data for
  * @param	raw_data[in, out]- ADC raw data
  * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	IADC channel is left enabled and disabled lazily after the idle timeout
  */
 int32_t read_single_sample(uint8_t input_chn, uint32_t *raw_data)
 {
 	int32_t ret;
+	int32_t release_ret = SUCCESS;
 
-	/* Enable IADC channel */
-	if (input_chn >= AD70081Z_E10_WPD_IS0 && input_chn <= AD70081Z_E21_RTAP_IS) {
-		ret = ad70081z_iadc_enable(p_ad70081z_dev_inst,
-					   (enum ad70081z_afe_mux_channel)input_chn, true);
+	/* Enable IADC channel (no SPI access if already enabled) */
+	if (IS_IADC_CHN(input_chn)) {
+		ret = iadc_lazy_enable(IADC_CHN_MASK(input_chn));
 		if (IS_ERR_VALUE(ret))
 			return ret;
 	}
 
 	/* Perform conversion and read the result (in register access mode) */
 	ret = ad70081z_adc_read(p_ad70081z_dev_inst, input_chn, (uint16_t *)raw_data);
+
+	if (IS_IADC_CHN(input_chn))
+		release_ret = iadc_lazy_release();
+
 	if (IS_ERR_VALUE(ret))
 		return ret;
 
-	/* Disable back IADC channel */
-	if (input_chn >= AD70081Z_E10_WPD_IS0 && input_chn <= AD70081Z_E21_RTAP_IS) {
-		ret = ad70081z_iadc_enable(p_ad70081z_dev_inst,
-					   (enum ad70081z_afe_mux_channel)input_chn, false);
+	return release_ret;
+}
+
+/*!
+ * @brief	Update the conversion delay as per the current OSR of the device
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t update_osr_conv_delay(void)
+{
+	switch (p_ad70081z_dev_inst->osr) {
+	case AD70081Z_ADC_CONFIG_OSR_NO_OVERSAMPLING:
+		osr_delay_us = 0;
+		break;
+
+	case AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_4:
+		osr_delay_us = OSR4_CONV_DELAY_USEC;
+		break;
+
+	case AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_16:
+		osr_delay_us = OSR16_CONV_DELAY_USEC;
+		break;
+
+	case AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_64:
+		osr_delay_us = OSR64_CONV_DELAY_USEC;
+		break;
+
+	default:
+		return FAILURE;
+	}
+
+	/* Burst capture is paced to the sampling period on monotonic time base */
+	burst_sample_period_us = USEC_PER_SEC / sampling_rate;
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Get the max achievable sampling rate for the current OSR
+ * @return	Max sampling rate in SPS
+ */
+uint32_t get_max_sampling_rate(void)
+{
+	if (p_ad70081z_dev_inst->osr >= ARRAY_SIZE(max_sampling_rate))
+		return max_sampling_rate[AD70081Z_ADC_CONFIG_OSR_NO_OVERSAMPLING];
+
+	return max_sampling_rate[p_ad70081z_dev_inst->osr];
+}
+
+/*!
+ * @brief	Get the max achievable sampling rates of all OSRs
+ * @param	rates[out] - Max sampling rates in SPS, indexed by OSR
+ * @param	nb_of_rates[in] - Number of rates (OSRs)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t get_max_sampling_rates(uint32_t *rates, uint8_t nb_of_rates)
+{
+	if (!rates || nb_of_rates != ARRAY_SIZE(max_sampling_rate))
+		return -EINVAL;
+
+	memcpy(rates, max_sampling_rate, sizeof(max_sampling_rate));
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Set the max achievable sampling rates of all OSRs
+ * @param	rates[in] - Max sampling rates in SPS, indexed by OSR (e.g.
+ *			previously calibrated rates)
+ * @param	nb_of_rates[in] - Number of rates (OSRs)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	The sampling rate is not changed, even if above the new max rate
+ */
+int32_t set_max_sampling_rates(const uint32_t *rates, uint8_t nb_of_rates)
+{
+	if (!rates || nb_of_rates != ARRAY_SIZE(max_sampling_rate))
+		return -EINVAL;
+
+	for (uint8_t indx = 0; indx < nb_of_rates; indx++) {
+		if (rates[indx] < MIN_SAMPLING_RATE)
+			return -EINVAL;
+	}
+
+	memcpy(max_sampling_rate, rates, sizeof(max_sampling_rate));
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Get the sampling rate used for buffered data capture
+ * @return	Sampling rate in SPS
+ */
+uint32_t get_sampling_rate(void)
+{
+	return sampling_rate;
+}
+
+/*!
+ * @brief	Set the sampling rate used for buffered data capture
+ * @param	rate[in] - Sampling rate in SPS
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	In CC mode the conversion trigger (PWM) period is reprogrammed, while
+ *			in burst mode the delay between the conversions is adjusted
+ */
+int32_t set_sampling_rate(uint32_t rate)
+{
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	int32_t ret;
+	uint32_t period_ns;
+#endif
+
+	if (rate < MIN_SAMPLING_RATE || rate > get_max_sampling_rate())
+		return -EINVAL;
+
+	if (start_adc_data_capture || mini_burst_in_progress)
+		return -EBUSY;
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	period_ns = NSEC_PER_SEC / rate;
+
+#if defined(USE_PLA_CONV_TRIGGER)
+	/* Retune the PLA generated CONVST pulse train */
+	ret = aducm410_pla_trigger_set_period(period_ns);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+#else
+	/* Retune the conversion trigger period with 50% duty cycle */
+	ret = pwm_disable(pwm_desc);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = pwm_set_period(pwm_desc, period_ns);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = pwm_set_duty_cycle(pwm_desc, period_ns / 2);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = pwm_enable(pwm_desc);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+#endif
+#endif
+
+	sampling_rate = rate;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Set the ADC oversampling ratio (OSR)
+ * @param	osr[in] - OSR value
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Sampling rate is lowered to the max achievable rate for new OSR,
+ *			if it exceeds that. The OSR is applied on next conversion config.
+ */
+int32_t set_oversampling_ratio(enum ad70081z_adc_config_osr osr)
+{
+	enum ad70081z_adc_config_osr prev_osr = p_ad70081z_dev_inst->osr;
+	int32_t ret;
+
+	if (osr > AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_64)
+		return -EINVAL;
+
+	if (start_adc_data_capture || mini_burst_in_progress)
+		return -EBUSY;
+
+	ad70081z_adc_set_osr(p_ad70081z_dev_inst, osr);
+
+	if (sampling_rate > get_max_sampling_rate()) {
+		ret = set_sampling_rate(get_max_sampling_rate());
+		if (IS_ERR_VALUE(ret)) {
+			ad70081z_adc_set_osr(p_ad70081z_dev_inst, prev_osr);
+			return ret;
+		}
+	}
+
+	return update_osr_conv_delay();
+}
+
+/*!
+ * @brief	Compute the integer square root of a 64-bit value
+ * @param	val[in] - Input value
+ * @return	Floor of the square root of input value
+ */
+static uint32_t int_sqrt64(uint64_t val)
+{
+	uint64_t res = 0;
+	uint64_t bit = (uint64_t)1 << 62;
+
+	while (bit > val) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)res;
+}
+
+/*!
+ * @brief	Capture 'n' samples of single ADC channel in a CC mode mini-burst
+ * @param	input_chn[in] - Input channel to sample
+ * @param	count[in] - Number of samples to capture
+ * @param	sum[out] - Sum of all the samples
+ * @param	sum_sq[out] - Sum of squares of all the samples
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t capture_mini_burst(uint8_t input_chn, uint16_t count,
+				  uint64_t *sum, uint64_t *sum_sq)
+{
+	int32_t ret;
+	int32_t exit_ret;
+	uint16_t adc_sample;
+
+	*sum = 0;
+	*sum_sq = 0;
+
+	ret = update_osr_conv_delay();
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	/* Select the input channel and enter into CC mode */
+	ret = ad70081z_adc_set_config(p_ad70081z_dev_inst,
+				      (enum ad70081z_afe_mux_channel)input_chn);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = ad70081z_cc_start(p_ad70081z_dev_inst);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	/* Start first conversion */
+	ret = ad70081z_adc_convst(p_ad70081z_dev_inst);
+
+	for (uint16_t sample_indx = 0; (sample_indx < count) && !ret; sample_indx++) {
+		/* Allow for conversion to finish (TBD usec) */
+		if (osr_delay_us > 0)
+			udelay(osr_delay_us);
+
+		/* Read the result, keeping the same channel selected */
+		ret = ad70081z_cc_read(p_ad70081z_dev_inst, NULL, &adc_sample);
+		if (IS_ERR_VALUE(ret))
+			break;
+
+		*sum += adc_sample;
+		*sum_sq += (uint32_t)adc_sample * adc_sample;
+
+		/* Trigger next conversion (except after the last sample) */
+		if (sample_indx < (count - 1))
+			ret = ad70081z_adc_convst(p_ad70081z_dev_inst);
+	}
+
+	/* Exit from CC mode into register mode, even if capture failed */
+	exit_ret = ad70081z_cc_exit(p_ad70081z_dev_inst);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	return exit_ret;
+}
+
+/*!
+ * @brief	Function to read the averaged ADC sample (raw data) for input channel
+ * @param	input_chn[in] - Input channel to sample and read data for
+ * @param	count[in] - Number of samples to average
+ * @param	mean[out] - Mean of the samples (rounded)
+ * @param	stddev[out] - Standard deviation of the samples, scaled by STDDEV_SCALE (optional)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Samples are captured in a single CC mode mini-burst, with IADC
+ *			channel enabled only once for the complete burst
+ */
+int32_t read_averaged_sample(uint8_t input_chn, uint16_t count, uint32_t *mean,
+			     uint32_t *stddev)
+{
+	int32_t ret;
+	int32_t release_ret = SUCCESS;
+	uint32_t raw_data = 0;
+	uint64_t sum;
+	uint64_t sum_sq;
+	uint64_t variance;
+	bool is_iadc_chn;
+
+	if (!mean || !count || count > MAX_RAW_AVERAGE_COUNT)
+		return -EINVAL;
+
+	/* Single sample is read in register mode */
+	if (count == 1) {
+		ret = read_single_sample(input_chn, &raw_data);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		*mean = (uint16_t)raw_data;
+		if (stddev)
+			*stddev = 0;
+
+		return SUCCESS;
+	}
+
+	/* Device can't be shared with an ongoing buffered data capture */
+	if (start_adc_data_capture || mini_burst_in_progress)
+		return -EBUSY;
+
+	is_iadc_chn = IS_IADC_CHN(input_chn);
+
+	/* Enable IADC channel (no SPI access if already enabled) */
+	if (is_iadc_chn) {
+		ret = iadc_lazy_enable(IADC_CHN_MASK(input_chn));
 		if (IS_ERR_VALUE(ret))
 			return ret;
 	}
 
+	mini_burst_in_progress = true;
+	ret = capture_mini_burst(input_chn, count, &sum, &sum_sq);
+	mini_burst_in_progress = false;
+
+	if (is_iadc_chn)
+		release_ret = iadc_lazy_release();
+
+	if (IS_ERR_VALUE(ret))
+		return ret;
+	if (IS_ERR_VALUE(release_ret))
+		return release_ret;
+
+	*mean = (uint32_t)((sum + (count / 2)) / count);
+
+	if (stddev) {
+		/* Population variance: (n*sum(x^2) - sum(x)^2) / n^2 */
+		variance = ((uint64_t)count * sum_sq) - (sum * sum);
+		*stddev = int_sqrt64((variance * STDDEV_SCALE * STDDEV_SCALE) /
+				     ((uint64_t)count * count));
+	}
+
 	return SUCCESS;
 }
 
@@ -168,42 +680,22 @@ int32_t read_converted_sample(uint32_t *adc_sample, uint8_t chn)
 int32_t continuous_sample_read_start_ops(uint32_t chn_mask)
 {
 	int32_t ret;
-	enum ad70081z_afe_mux_channel input_chn;
+	uint8_t iadc_mask = 0;
 
-	/* Enable IADC channels from the list of active channels */
+	/* Enable IADC channels from the list of active channels (single transaction) */
 	for (uint8_t chn = 0; chn < num_of_active_channels; chn++) {
-		input_chn = acq_buffer.active_chn[chn];
-
-		if (input_chn >= AD70081Z_E10_WPD_IS0 && input_chn <= AD70081Z_E21_RTAP_IS) {
-			ret = ad70081z_iadc_enable(p_ad70081z_dev_inst,
-						   (enum ad70081z_afe_mux_channel)input_chn,
-						   true);
-			if (IS_ERR_VALUE(ret))
-				return ret;
-		}
+		if (IS_IADC_CHN(acq_buffer.active_chn[chn]))
+			iadc_mask |= IADC_CHN_MASK(acq_buffer.active_chn[chn]);
 	}
 
-	/* Set the OSR conversion delay to use during burst data capture mode */
-	switch (p_ad70081z_dev_inst->osr) {
-	case AD70081Z_ADC_CONFIG_OSR_NO_OVERSAMPLING:
-		osr_delay_us = 0;
-		break;
-
-	case AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_4:
-		osr_delay_us = OSR4_CONV_DELAY_USEC;
-		break;
-
-	case AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_16:
-		osr_delay_us = OSR16_CONV_DELAY_USEC;
-		break;
-
-	case AD70081Z_ADC_CONFIG_OSR_OVERSAMPLING_X_64:
-		osr_delay_us = OSR64_CONV_DELAY_USEC;
-		break;
+	ret = iadc_lazy_enable(iadc_mask);
+	if (IS_ERR_VALUE(ret))
+		return ret;
 
-	default:
-		return FAILURE;
-	}
+	/* Set the OSR conversion delay to use during burst data capture mode */
+	ret = update_osr_conv_delay();
+	if (IS_ERR_VALUE(ret))
+		return ret;
 
 	/* Select the first channel from the list of active channels */
 	ret = ad70081z_adc_set_config(p_ad70081z_dev_inst, acq_buffer.active_chn[0]);
@@ -215,10 +707,12 @@ int32_t continuous_sample_read_start_ops(uint32_t chn_mask)
 	if (IS_ERR_VALUE(ret))
 		return ret;
 
+#if !defined(USE_PLA_CONV_TRIGGER)
 	/* Start Conversion */
 	ret = ad70081z_adc_convst(p_ad70081z_dev_inst);
 	if (IS_ERR_VALUE(ret))
 		return ret;
+#endif
 
 	return SUCCESS;
 }
@@ -231,27 +725,14 @@ int32_t continuous_sample_read_start_ops(uint32_t chn_mask)
 int32_t continuous_sample_read_stop_ops(void)
 {
 	int32_t ret;
-	enum ad70081z_afe_mux_channel input_chn;
 
 	/* Exit from CC mode into register mode */
 	ret = ad70081z_cc_exit(p_ad70081z_dev_inst);
 	if (IS_ERR_VALUE(ret))
 		return ret;
 
-	/* Disable previously enabled IADC channels */
-	for (uint8_t chn = 0; chn < num_of_active_channels; chn++) {
-		input_chn = acq_buffer.active_chn[chn];
-
-		if (input_chn >= AD70081Z_E10_WPD_IS0 && input_chn <= AD70081Z_E21_RTAP_IS) {
-			ret = ad70081z_iadc_enable(p_ad70081z_dev_inst,
-						   (enum ad70081z_afe_mux_channel)input_chn,
-						   false);
-			if (IS_ERR_VALUE(ret))
-				return ret;
-		}
-	}
-
-	return SUCCESS;
+	/* Previously enabled IADC channels are disabled lazily */
+	return iadc_lazy_release();
 }
 
 /*!
@@ -263,6 +744,7 @@ static void reset_data_capture(void)
 	/* Reset data capture flags */
 	start_adc_data_capture = false;
 	num_of_active_channels = 0;
+	active_channel_mask = 0;
 
 	/* Reset acquisition buffer states and clear old data */
 	acq_buffer.state = BUF_EMPTY;
@@ -270,6 +752,10 @@ static void reset_data_capture(void)
 	acq_buffer.chn_indx = 0;
 	acq_buffer.pdata = adc_data_buffer;
 	do_chn_alignment = true;
+
+	/* Streamed data read restarts with next capture */
+	stream_capture = false;
+	stream_scan_index = 0;
 }
 
 /*!
@@ -286,10 +772,16 @@ int32_t prepare_data_transfer(uint32_t ch_mask, uint8_t num_of_chns,
 	uint32_t mask = 0x1;
 	uint8_t index = 0;
 
+	/* Device can't be accessed by the DAC ticker ISR during capture (DAC
+	 * playback is already rejected during capture) */
+	if (is_dac_waveform_running())
+		return -EBUSY;
+
 	/* Reset data capture module specific flags and variables */
 	reset_data_capture();
 
 	acq_buffer.sample_size = sample_size;
+	active_channel_mask = ch_mask;
 
 	/* Get the active channels count based on the channel mask set in an IIO
 	 * client application (channel mask starts from bit 0, so for 0th ADC
@@ -310,10 +802,31 @@ int32_t prepare_data_transfer(uint32_t ch_mask, uint8_t num_of_chns,
 		return FAILURE;
 	}
 
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+	/* Conversion interrupt latency is referenced to the trigger period */
+	profile_latency_start(get_conv_trigger_cycles());
+#endif
+
 	start_adc_data_capture = true;
+
+#if defined(USE_PLA_CONV_TRIGGER)
+	/* Conversions are paced by PLA once capture is armed, so that no
+	 * conversion interrupt is missed by the channel tracking */
+	aducm410_pla_trigger_start();
+#endif
+
 	return SUCCESS;
 }
 
+/*!
+ * @brief	Get the ADC capture status
+ * @return	true if a buffered capture or mini-burst is in progress, else false
+ */
+bool is_adc_capture_in_progress(void)
+{
+	return (start_adc_data_capture || mini_burst_in_progress);
+}
+
 /*!
  * @brief	Function to stop ADC data capture
  * @return	0 in case of SUCCESS, negative error code otherwise
@@ -322,6 +835,14 @@ int32_t end_data_transfer(void)
 {
 	start_adc_data_capture = false;
 
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+	profile_latency_stop();
+#endif
+
+#if defined(USE_PLA_CONV_TRIGGER)
+	aducm410_pla_trigger_stop();
+#endif
+
 	/* Enable operations required post continuous sample read */
 	if (continuous_sample_read_stop_ops() != SUCCESS) {
 		return FAILURE;
@@ -343,6 +864,8 @@ static int32_t capture_burst_data(uint8_t *pbuf, uint32_t nb_of_samples)
 {
 	uint32_t sample_indx = 0;
 	uint32_t adc_sample;
+	uint32_t next_sample_us = get_time_us();
+	uint32_t conv_done_us;
 
 	while (sample_indx < nb_of_samples) {
 		if (read_converted_sample(&adc_sample,
@@ -365,13 +888,179 @@ static int32_t capture_burst_data(uint8_t *pbuf, uint32_t nb_of_samples)
 
 		/* Trigger new Conversion */
 		ad70081z_adc_convst(p_ad70081z_dev_inst);
+		conv_done_us = get_time_us() + osr_delay_us;
 
-		/* Allow for conversion to finish (TBD usec) */
+		/* Allow for conversion to finish and pace to the sampling rate. The
+		 * schedule restarts if it falls behind (no catch up bursts) */
+		next_sample_us += burst_sample_period_us;
+		if ((int32_t)(next_sample_us - conv_done_us) < 0)
+			next_sample_us = conv_done_us;
+
+		delay_until_us(next_sample_us);
+	}
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Time the capture loop of the active data capture mode at the
+ *			current OSR, running unpaced on a single channel
+ * @param	sample_time_ns[out] - Capture time per sample in nsec
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	In CC mode the conversion ISR is called back to back, waiting for
+ *			the conversion to complete in between (as the trigger period
+ *			must allow for), with interrupt entry/exit overhead excluded
+ */
+static int32_t time_capture_loop(uint32_t *sample_time_ns)
+{
+	int32_t ret;
+	int32_t exit_ret;
+	uint32_t start_us;
+	uint32_t elapsed_us;
+
+	reset_data_capture();
+	acq_buffer.active_chn[0] = CALIBRATION_CHN;
+	acq_buffer.sample_size = sizeof(uint16_t);
+	num_of_active_channels = 1;
+
+	ret = update_osr_conv_delay();
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	/* Select the input channel and enter into CC mode */
+	ret = ad70081z_adc_set_config(p_ad70081z_dev_inst, CALIBRATION_CHN);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = ad70081z_cc_start(p_ad70081z_dev_inst);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = ad70081z_adc_convst(p_ad70081z_dev_inst);
+	start_us = get_time_us();
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	acq_buffer.pdata = adc_data_buffer;
+	acq_buffer.state = BUF_AVAILABLE;
+	num_of_requested_samples = CALIBRATION_SAMPLE_COUNT;
+	start_adc_data_capture = true;
+
+	for (uint16_t sample_indx = 0;
+	     (sample_indx < CALIBRATION_SAMPLE_COUNT) && !ret; sample_indx++) {
 		if (osr_delay_us > 0)
 			udelay(osr_delay_us);
+
+		data_capture_isr();
+
+#if defined(USE_PLA_CONV_TRIGGER)
+		/* Conversion is triggered by the PLA during an actual capture */
+		ret = ad70081z_adc_convst(p_ad70081z_dev_inst);
+#endif
 	}
 
-	return SUCCESS;
+	start_adc_data_capture = false;
+	if (!ret && acq_buffer.state != BUF_FULL)
+		ret = FAILURE;
+#else
+	/* Unpaced burst, limited only by the conversion and the loop time */
+	burst_sample_period_us = 0;
+	if (!ret)
+		ret = capture_burst_data(adc_data_buffer, CALIBRATION_SAMPLE_COUNT);
+#endif
+
+	elapsed_us = get_time_us() - start_us;
+
+	/* Exit from CC mode into register mode, even if capture failed */
+	exit_ret = ad70081z_cc_exit(p_ad70081z_dev_inst);
+	reset_data_capture();
+
+	if (IS_ERR_VALUE(ret))
+		return ret;
+	if (IS_ERR_VALUE(exit_ret))
+		return exit_ret;
+
+	*sample_time_ns = (uint32_t)(((uint64_t)elapsed_us * 1000) /
+				     CALIBRATION_SAMPLE_COUNT);
+	if (!*sample_time_ns)
+		*sample_time_ns = 1;
+
+	/* Restore the pacing of burst capture */
+	return update_osr_conv_delay();
+}
+
+/*!
+ * @brief	Calibrate the max achievable sampling rates of all the OSRs on
+ *			the attached hardware
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @details	The capture loop is timed for every OSR and the max sampling
+ *			rate is derived with CALIBRATION_MARGIN_PERCENT margin. The
+ *			calibrated rates replace the compile time defaults
+ *			(SAMPLING_RATE_CC_x/SAMPLING_RATE_BURST_x) for the rest of the
+ *			session, and the sampling rate (conversion trigger) is set to the
+ *			max rate of the current OSR.
+ *			Rates of the OSRs timed before a failure are retained.
+ */
+int32_t calibrate_sampling_rates(void)
+{
+	enum ad70081z_adc_config_osr osr = p_ad70081z_dev_inst->osr;
+	uint32_t sample_time_ns;
+	uint64_t rate;
+	int32_t ret = SUCCESS;
+	int32_t rate_ret;
+
+	if (start_adc_data_capture || mini_burst_in_progress)
+		return -EBUSY;
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE) && !defined(USE_PLA_CONV_TRIGGER)
+	/* Stop the conversion trigger, so that the conversion ISR is run only by
+	 * the calibration (trigger is restarted with the new sampling rate) */
+	ret = pwm_disable(pwm_desc);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+#endif
+
+	for (uint8_t indx = 0; indx < ARRAY_SIZE(max_sampling_rate); indx++) {
+		ad70081z_adc_set_osr(p_ad70081z_dev_inst,
+				     (enum ad70081z_adc_config_osr)indx);
+
+		ret = time_capture_loop(&sample_time_ns);
+		if (IS_ERR_VALUE(ret))
+			break;
+
+		rate = ((uint64_t)NSEC_PER_SEC * 100) /
+		       ((uint64_t)sample_time_ns * (100 + CALIBRATION_MARGIN_PERCENT));
+		if (rate < MIN_SAMPLING_RATE)
+			rate = MIN_SAMPLING_RATE;
+
+		max_sampling_rate[indx] = (uint32_t)rate;
+	}
+
+	ad70081z_adc_set_osr(p_ad70081z_dev_inst, osr);
+
+	/* Run at the max rate of the current OSR */
+	rate_ret = set_sampling_rate(get_max_sampling_rate());
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	return rate_ret;
+}
+
+/*!
+ * @brief	Get the number of ADC channels enabled for data capture
+ * @return	Active channels count
+ */
+uint8_t get_num_of_active_channels(void)
+{
+	return num_of_active_channels;
+}
+
+/*!
+ * @brief	Get the channel mask of active channels for data capture
+ * @return	Channel mask (as set by IIO client)
+ */
+uint32_t get_active_channel_mask(void)
+{
+	return active_channel_mask;
 }
 
 /*!
@@ -382,22 +1071,35 @@ static int32_t capture_burst_data(uint8_t *pbuf, uint32_t nb_of_samples)
  */
 int32_t read_buffered_data(void *pbuf, uint32_t nb_of_samples)
 {
-	uint32_t timeout = BUF_READ_TIMEOUT;	// Buffer new data read timeout count
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	uint32_t timeout_ms;
+	uint32_t start_time_ms;
+#endif
 	num_of_requested_samples = (nb_of_samples * num_of_active_channels);
+	stream_capture = false;
 
 #if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	PROFILE_START(PROFILE_BURST_CAPTURE);
 	capture_burst_data(pbuf, num_of_requested_samples);
+	PROFILE_STOP(PROFILE_BURST_CAPTURE);
 #else
 	acq_buffer.wr_indx = 0;
-	acq_buffer.pdata = adc_data_buffer;
+	acq_buffer.pdata = pbuf;
+	do_chn_alignment = true;
+
+	/* Allow twice the expected buffer fill time (one conversion per trigger) */
+	timeout_ms = (uint32_t)(((uint64_t)num_of_requested_samples * 2000) /
+				sampling_rate) + BUF_READ_TIMEOUT_MARGIN_MS;
+	start_time_ms = get_time_ms();
+
 	acq_buffer.state = BUF_AVAILABLE;
 
 	/* Wait for acquisition buffer to become full */
-	do {
-		timeout--;
-	} while ((acq_buffer.state != BUF_FULL) && (timeout > 0));
+	while ((acq_buffer.state != BUF_FULL)
+	       && ((get_time_ms() - start_time_ms) < timeout_ms)) {
+	}
 
-	if (timeout == 0) {
+	if (acq_buffer.state != BUF_FULL) {
 		/* This returns the empty buffer */
 		return FAILURE;
 	}
@@ -406,11 +1108,171 @@ int32_t read_buffered_data(void *pbuf, uint32_t nb_of_samples)
 	return SUCCESS;
 }
 
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/*!
+ * @brief	Reset the stream ring and start storing the scans into it
+ * @return	none
+ */
+static void start_stream_ring(void)
+{
+	stream_wr_pos = 0;
+	stream_rd_pos = 0;
+	stream_wr_count = 0;
+	stream_rd_count = 0;
+	stream_overrun = false;
+	stream_dropped_seen = stream_dropped_scans;
+
+	/* Partial scan in progress is not stored */
+	stream_drop_scan = true;
+	stream_capture = true;
+}
+
+/*!
+ * @brief	Discard the stream ring content after an overrun and resume
+ *			storing the scans
+ * @return	Number of scans discarded and dropped by ISR
+ */
+static uint32_t flush_stream_ring(void)
+{
+	uint32_t discarded;
+	uint32_t dropped;
+
+	/* ISR does not store any sample during overrun */
+	discarded = stream_wr_count - stream_rd_count;
+	stream_rd_pos = stream_wr_pos;
+	stream_rd_count = stream_wr_count;
+
+	/* No more scan is dropped by ISR once overrun is cleared (ring is empty) */
+	stream_overrun = false;
+	dropped = stream_dropped_scans - stream_dropped_seen;
+	stream_dropped_seen += dropped;
+
+	return (discarded / num_of_active_channels) + dropped;
+}
+#endif
+
+/*!
+ * @brief	Function to read the ADC data streamed back to back across reads
+ * @param	pbuf[out] - Pointer to data buffer (16-bit samples)
+ * @param	nb_of_samples[in] - Number of samples (scans) to be read
+ * @param	scan_index[out] - Index of the first scan read (counted since
+ *			the capture start, including the lost scans)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @details	In CC mode the conversion ISR keeps storing the scans into the
+ *			stream ring in between the reads, so consecutive reads return
+ *			continuous data as long as the reader keeps up with the sampling
+ *			rate. On ring overrun, the scans are dropped and the data read is
+ *			restarted after the gap (the scan index skips the lost scans).
+ *			In burst mode no conversion is done in between the reads, so the
+ *			lost scans are estimated from the time elapsed since last read
+ */
+int32_t read_stream_data(uint16_t *pbuf, uint32_t nb_of_samples,
+			 uint32_t *scan_index)
+{
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	uint32_t nb_of_reads;
+	uint32_t cnt = 0;
+	uint32_t timeout_ms;
+	uint32_t start_time_ms;
+#else
+	uint32_t scan_period_us;
+	uint32_t now_us;
+#endif
+
+	if (!pbuf || !scan_index || !num_of_active_channels)
+		return -EINVAL;
+
+#if (DATA_CAPTURE_MODE == BURST_DATA_CAPTURE)
+	scan_period_us = burst_sample_period_us * num_of_active_channels;
+	now_us = get_time_us();
+
+	if (stream_capture && scan_period_us
+	    && (int32_t)(now_us - stream_next_scan_us) > 0) {
+		stream_scan_index += (now_us - stream_next_scan_us) / scan_period_us;
+	}
+
+	num_of_requested_samples = (nb_of_samples * num_of_active_channels);
+	stream_capture = true;
+
+	PROFILE_START(PROFILE_BURST_CAPTURE);
+	if (capture_burst_data((uint8_t *)pbuf, num_of_requested_samples) != SUCCESS) {
+		PROFILE_STOP(PROFILE_BURST_CAPTURE);
+		return FAILURE;
+	}
+	PROFILE_STOP(PROFILE_BURST_CAPTURE);
+
+	stream_next_scan_us = get_time_us();
+#else
+	if (!stream_capture)
+		start_stream_ring();
+
+	nb_of_reads = nb_of_samples * num_of_active_channels;
+
+	/* Allow twice the expected read time (one conversion per trigger) */
+	timeout_ms = (uint32_t)(((uint64_t)nb_of_reads * 2000) / sampling_rate) +
+		     BUF_READ_TIMEOUT_MARGIN_MS;
+	start_time_ms = get_time_ms();
+
+	while (cnt < nb_of_reads) {
+		if (stream_overrun) {
+			/* Restart the read after the gap, so that data is continuous */
+			stream_scan_index += (cnt / num_of_active_channels) + flush_stream_ring();
+			cnt = 0;
+			continue;
+		}
+
+		if (stream_rd_count == stream_wr_count) {
+			if ((get_time_ms() - start_time_ms) >= timeout_ms)
+				return FAILURE;
+
+			continue;
+		}
+
+		pbuf[cnt++] = stream_ring[stream_rd_pos];
+		if (++stream_rd_pos >= STREAM_RING_SIZE)
+			stream_rd_pos = 0;
+		stream_rd_count++;
+	}
+#endif
+
+	*scan_index = stream_scan_index;
+	stream_scan_index += nb_of_samples;
+
+	return SUCCESS;
+}
+
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+/*!
+ * @brief	Store the sample into stream ring (called from ISR)
+ * @param	chn_indx[in] - Index of the sampled channel in active channels
+ * @param	sample[in] - ADC sample
+ * @return	none
+ */
+static void store_stream_sample(uint8_t chn_indx, uint16_t sample)
+{
+	if (chn_indx == 0) {
+		/* Drop the complete scan if it does not fit into ring */
+		stream_drop_scan = stream_overrun ||
+				   ((STREAM_RING_SIZE - (stream_wr_count - stream_rd_count))
+				    < num_of_active_channels);
+		if (stream_drop_scan) {
+			stream_overrun = true;
+			stream_dropped_scans++;
+		}
+	}
+
+	if (stream_drop_scan)
+		return;
+
+	stream_ring[stream_wr_pos] = sample;
+	if (++stream_wr_pos >= STREAM_RING_SIZE)
+		stream_wr_pos = 0;
+	stream_wr_count++;
+}
+#endif
+
 /*!
  * @brief	This is an ISR (Interrupt Service Routine) to monitor end of conversion event.
- * @param	*ctx[in] - Callback context (unused)
- * @param	event[in] - Callback event (unused)
- * @param	extra[in] - Callback extra (unused)
  * @return	none
  * @details	This is an Interrupt callback function/ISR invoked in synchronous/asynchronous
  *			manner depending upon the application implementation. The conversion results
@@ -420,16 +1282,37 @@ int32_t read_buffered_data(void *pbuf, uint32_t nb_of_samples)
  *			every 'n' sample transmission. This is required to visualize data properly
  *			on IIO client application.
  */
-void data_capture_callback(void *ctx, uint32_t event, void *extra)
+void data_capture_isr(void)
 {
 	uint32_t adc_sample;
 
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+	/* Entry timestamp first, so that the ISR latency excludes the ISR body */
+	profile_latency_record();
+#endif
+
+	PROFILE_START(PROFILE_DATA_CAPTURE_ISR);
+
 	if (start_adc_data_capture == true) {
 		/* Read the sample(s) for channel(s) which has/have been sampled recently and
 		 * get the number of samples read count */
 		if (read_converted_sample(&adc_sample,
 					  acq_buffer.active_chn[acq_buffer.chn_indx]) != FAILURE) {
 			do {
+#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+				if (stream_capture == true) {
+					/* Scans are stored back to back into stream ring */
+					store_stream_sample(acq_buffer.chn_indx, (uint16_t)adc_sample);
+
+					acq_buffer.chn_indx++;
+					if (acq_buffer.chn_indx >= num_of_active_channels) {
+						acq_buffer.chn_indx = 0;
+					}
+
+					break;
+				}
+#endif
+
 				/* Wait until conversion event for the zeroth channel is triggered */
 				if ((do_chn_alignment == true) && (acq_buffer.chn_indx != 0)) {
 					/* Track the count for recently sampled channel */
@@ -468,7 +1351,25 @@ void data_capture_callback(void *ctx, uint32_t event, void *extra)
 			} while (0);
 		}
 
+#if !defined(USE_PLA_CONV_TRIGGER)
 		/* Trigger next Conversion */
 		ad70081z_adc_convst(p_ad70081z_dev_inst);
+#endif
 	}
+
+	PROFILE_STOP(PROFILE_DATA_CAPTURE_ISR);
+}
+
+/*!
+ * @brief	Conversion complete interrupt callback (generic IRQ callback)
+ * @param	*ctx[in] - Callback context (unused)
+ * @param	event[in] - Callback event (unused)
+ * @param	extra[in] - Callback extra (unused)
+ * @return	none
+ * @note	Platforms supporting a direct interrupt handler invoke the
+ *			data_capture_isr() straight from the interrupt vector instead
+ */
+void data_capture_callback(void *ctx, uint32_t event, void *extra)
+{
+	data_capture_isr();
 }
@@ -22,6 +22,7 @@
 #include <stddef.h>
 
 #include "app_config.h"
+#include "ad70081z.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -34,6 +35,20 @@
 #define DATA_BUFFER_SIZE	(8192)		// 8Kbytes
 #endif
 
+/* Size of the ring holding the scans captured back to back for the streamed
+ * (compressed) data reads, in terms of samples */
+#if (ACTIVE_PLATFORM == MBED_PLATFORM)
+#define STREAM_RING_SIZE	(4096)		// 8Kbytes
+#else
+#define STREAM_RING_SIZE	(1024)		// 2Kbytes
+#endif
+
+/* Max number of samples that can be averaged for single channel raw read */
+#define MAX_RAW_AVERAGE_COUNT	(1024)
+
+/* Scale factor of the standard deviation returned by read_averaged_sample() */
+#define STDDEV_SCALE	(100)
+
 /******************************************************************************/
 /************************ Public Declarations *********************************/
 /******************************************************************************/
@@ -41,10 +56,28 @@
 extern uint8_t adc_data_buffer[];
 
 int32_t read_single_sample(uint8_t input_chn, uint32_t *raw_data);
+int32_t read_averaged_sample(uint8_t input_chn, uint16_t count, uint32_t *mean,
+			     uint32_t *stddev);
 int32_t read_buffered_data(void *pbuf, uint32_t nb_of_samples);
+int32_t read_stream_data(uint16_t *pbuf, uint32_t nb_of_samples,
+			 uint32_t *scan_index);
 int32_t prepare_data_transfer(uint32_t ch_mask, uint8_t num_of_chns,
 			      uint8_t sample_size_in_byte);
 int32_t end_data_transfer(void);
+bool is_adc_capture_in_progress(void);
+uint8_t get_num_of_active_channels(void);
+uint32_t get_active_channel_mask(void);
+int32_t iadc_idle_check(void);
+int32_t set_iadc_idle_timeout(uint32_t timeout_ms);
+uint32_t get_iadc_idle_timeout(void);
+int32_t set_sampling_rate(uint32_t rate);
+uint32_t get_sampling_rate(void);
+uint32_t get_max_sampling_rate(void);
+int32_t get_max_sampling_rates(uint32_t *rates, uint8_t nb_of_rates);
+int32_t set_max_sampling_rates(const uint32_t *rates, uint8_t nb_of_rates);
+int32_t calibrate_sampling_rates(void);
+int32_t set_oversampling_ratio(enum ad70081z_adc_config_osr osr);
+void data_capture_isr(void);
 void data_capture_callback(void *ctx, uint32_t event, void *extra);
 
 #endif /* _AD70081Z_DATA_CAPTURE_H_ */
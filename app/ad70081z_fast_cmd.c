@@ -0,0 +1,306 @@
+/***************************************************************************//**
+ *   @file    ad70081z_fast_cmd.c
+ *   @brief   Binary fast path command channel for AD70081z IIO application
+ *   @details This module serves fixed size binary command frames received on
+ *            the IIO UART link. The frames are dispatched directly to the
+ *            ad70081z APIs, bypassing the text IIO protocol (formatting and
+ *            parsing of attributes). Any other data received is handed over
+ *            to the IIO interface, so the IIO clients keep working as before
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "ad70081z_fast_cmd.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_dac_playback.h"
+#include "ad70081z_iio.h"
+#include "app_config.h"
+#include "uart.h"
+#include "crc.h"
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* CRC-8 (x^8 + x^2 + x + 1) over all the frame bytes preceding the CRC */
+#define FAST_CMD_CRC8_POLYNOMIAL	0x07
+#define FAST_CMD_CRC8_INITIAL_VALUE	0x00
+
+/* Frame field offsets */
+#define FAST_CMD_SYNC_OFFSET	0
+#define FAST_CMD_ID_OFFSET		1
+#define FAST_CMD_ARG_OFFSET		2
+#define FAST_CMD_VALUE_OFFSET	6
+#define FAST_CMD_CRC_OFFSET		10
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+DECLARE_CRC8_TABLE(fast_cmd_crc8);
+
+/* Status of capture started through fast path */
+static bool fast_capture_active;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Get the 32-bit little endian field of frame
+ * @param	buf[in] - Pointer to field
+ * @return	Field value
+ */
+static uint32_t get_le32(const uint8_t *buf)
+{
+	return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+	       ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/*!
+ * @brief	Put the 32-bit little endian field into frame
+ * @param	buf[out] - Pointer to field
+ * @param	val[in] - Field value
+ * @return	none
+ */
+static void put_le32(uint8_t *buf, uint32_t val)
+{
+	buf[0] = (uint8_t)val;
+	buf[1] = (uint8_t)(val >> 8);
+	buf[2] = (uint8_t)(val >> 16);
+	buf[3] = (uint8_t)(val >> 24);
+}
+
+/*!
+ * @brief	Initialize the fast path command channel
+ * @return	none
+ */
+void fast_cmd_init(void)
+{
+	crc8_populate_msb(fast_cmd_crc8, FAST_CMD_CRC8_POLYNOMIAL);
+}
+
+/*!
+ * @brief	Receive the rest of the frame following the sync byte
+ * @param	frame[in,out] - Frame buffer (holding the sync byte)
+ * @return	true if complete frame is received, false on timeout
+ */
+static bool receive_frame(uint8_t *frame)
+{
+	uint32_t start_time_ms = get_time_ms();
+	uint32_t cnt = 1;
+	int32_t ret;
+
+	while (cnt < FAST_CMD_FRAME_SIZE) {
+		ret = uart_read_nonblocking(uart_desc, &frame[cnt],
+					    FAST_CMD_FRAME_SIZE - cnt);
+		if (ret > 0)
+			cnt += ret;
+
+		if ((uint32_t)(get_time_ms() - start_time_ms) > FAST_CMD_FRAME_TIMEOUT_MS)
+			return false;
+	}
+
+	return true;
+}
+
+/*!
+ * @brief	Check if the AFE mux channel is one of the ADC channels (same
+ *			channel map as for the ADC IIO channels)
+ * @param	chn[in] - AFE mux channel
+ * @return	true if channel is valid, else false
+ */
+static bool is_adc_chn_valid(uint32_t chn)
+{
+	return ((chn >= AD70081Z_E1_CTHRM_VS && chn <= AD70081Z_E21_RTAP_IS)
+		|| chn == AD70081Z_E25_SOA_VS0 || chn == AD70081Z_E25_SOA_VS1);
+}
+
+/*!
+ * @brief	Get the status of capture started through fast path
+ * @return	true if fast path capture is active, else false
+ */
+bool is_fast_capture_active(void)
+{
+	return fast_capture_active;
+}
+
+/*!
+ * @brief	Read the scans captured through fast path into ADC data buffer
+ * @param	nb_of_scans[in] - Number of scans to be read
+ * @param	scan_index[out] - Index of first scan read
+ * @param	data_bytes[out] - Size of data read
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t read_capture_data(uint32_t nb_of_scans, uint32_t *scan_index,
+				 uint32_t *data_bytes)
+{
+	uint32_t scan_bytes = get_num_of_active_channels() * sizeof(uint16_t);
+	int32_t ret;
+
+	if (!fast_capture_active)
+		return -EINVAL;
+
+	if (!nb_of_scans || nb_of_scans > DATA_BUFFER_SIZE / scan_bytes)
+		return -EINVAL;
+
+	ret = read_stream_data((uint16_t *)adc_data_buffer, nb_of_scans, scan_index);
+	if (IS_ERR_VALUE(ret))
+		return ret;
+
+	*data_bytes = nb_of_scans * scan_bytes;
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Execute the fast path command
+ * @param	cmd[in] - Command ID
+ * @param	arg[in] - Command argument
+ * @param	value[in,out] - Command value (in) and response value (out)
+ * @param	data_bytes[out] - Size of data (in ADC data buffer) following
+ *			the response frame
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+static int32_t execute_command(uint8_t cmd, uint32_t arg, uint32_t *value,
+			       uint32_t *data_bytes)
+{
+	int32_t ret;
+	uint32_t adc_data;
+
+	/* Device is in conversion mode during capture (IIO buffer or fast path) */
+	if (cmd != FAST_CMD_CAPTURE_READ && cmd != FAST_CMD_CAPTURE_STOP
+	    && is_adc_capture_in_progress())
+		return -EBUSY;
+
+	switch (cmd) {
+	case FAST_CMD_REG_READ:
+		return ad70081z_spi_reg_read(p_ad70081z_dev_inst, arg, value);
+
+	case FAST_CMD_REG_WRITE:
+		return ad70081z_spi_reg_write(p_ad70081z_dev_inst, arg, *value);
+
+	case FAST_CMD_DAC_SET:
+		if (arg >= AD70081Z_VDAC_CH_LIMIT || *value > get_dac_max_code(arg))
+			return -EINVAL;
+
+		return ad70081z_set_dac_value(p_ad70081z_dev_inst, (uint16_t)*value,
+					      (enum ad70081z_channel)arg);
+
+	case FAST_CMD_ADC_READ:
+		if (!is_adc_chn_valid(arg))
+			return -EINVAL;
+
+		/* Sample is read as 16-bit result */
+		adc_data = 0;
+		ret = read_single_sample((uint8_t)arg, &adc_data);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		*value = adc_data;
+		return SUCCESS;
+
+	case FAST_CMD_CAPTURE_START:
+		if (!arg || (arg >> ADC_CHN_COUNT))
+			return -EINVAL;
+
+		ret = prepare_data_transfer(arg, ADC_CHN_COUNT, sizeof(uint16_t));
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		fast_capture_active = true;
+		return SUCCESS;
+
+	case FAST_CMD_CAPTURE_READ:
+		return read_capture_data(arg, value, data_bytes);
+
+	case FAST_CMD_CAPTURE_STOP:
+		if (!fast_capture_active)
+			return SUCCESS;
+
+		fast_capture_active = false;
+		return end_data_transfer();
+
+	default:
+		return -EINVAL;
+	}
+}
+
+/*!
+ * @brief	Serve the fast path command frame received on IIO UART link
+ * @return	true if text IIO command is pending (to be handled by IIO
+ *			interface), else false
+ * @note	Non-blocking. Received character which is not a fast path sync
+ *			byte is pushed back into UART driver for the IIO interface
+ */
+bool fast_cmd_step(void)
+{
+	uint8_t frame[FAST_CMD_FRAME_SIZE];
+	uint32_t data_bytes = 0;
+	uint32_t value;
+	int32_t status;
+	uint8_t data_crc;
+
+	if (uart_read_nonblocking(uart_desc, frame, 1) != 1)
+		return false;
+
+	if (frame[FAST_CMD_SYNC_OFFSET] != FAST_CMD_REQ_SYNC) {
+		/* Text IIO command */
+		if (IS_ERR_VALUE(uart_push_back(uart_desc, frame[FAST_CMD_SYNC_OFFSET])))
+			return false;
+
+		return true;
+	}
+
+	/* Incomplete frame is dropped, host retries on response timeout */
+	if (!receive_frame(frame))
+		return false;
+
+	value = get_le32(&frame[FAST_CMD_VALUE_OFFSET]);
+
+	if (crc8(fast_cmd_crc8, frame, FAST_CMD_CRC_OFFSET,
+		 FAST_CMD_CRC8_INITIAL_VALUE) != frame[FAST_CMD_CRC_OFFSET]) {
+		status = -EBADMSG;
+	} else {
+		status = execute_command(frame[FAST_CMD_ID_OFFSET],
+					 get_le32(&frame[FAST_CMD_ARG_OFFSET]), &value,
+					 &data_bytes);
+	}
+
+	/* Response echoes the command ID, with status in place of argument */
+	frame[FAST_CMD_SYNC_OFFSET] = FAST_CMD_RESP_SYNC;
+	put_le32(&frame[FAST_CMD_ARG_OFFSET], (uint32_t)status);
+	put_le32(&frame[FAST_CMD_VALUE_OFFSET], IS_ERR_VALUE(status) ? 0 : value);
+	frame[FAST_CMD_CRC_OFFSET] = crc8(fast_cmd_crc8, frame, FAST_CMD_CRC_OFFSET,
+					  FAST_CMD_CRC8_INITIAL_VALUE);
+
+	(void)uart_write(uart_desc, frame, FAST_CMD_FRAME_SIZE);
+
+	/* Captured data follows the response frame */
+	if (!IS_ERR_VALUE(status) && data_bytes) {
+		data_crc = crc8(fast_cmd_crc8, adc_data_buffer, data_bytes,
+				FAST_CMD_CRC8_INITIAL_VALUE);
+		(void)uart_write(uart_desc, adc_data_buffer, data_bytes);
+		(void)uart_write(uart_desc, &data_crc, 1);
+	}
+
+	return false;
+}
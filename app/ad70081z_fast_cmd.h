@@ -0,0 +1,74 @@
+/***************************************************************************//**
+ *   @file   ad70081z_fast_cmd.h
+ *   @brief  Header for AD70081z binary fast path command channel
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_FAST_CMD_H_
+#define _AD70081Z_FAST_CMD_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* First byte of command (request) and response frames. The request sync byte
+ * is not a printable character, so it never starts a text IIO command */
+#define FAST_CMD_REQ_SYNC		0xA5
+#define FAST_CMD_RESP_SYNC		0x5A
+
+/* Size of command and response frames (in bytes):
+ * sync(1) | cmd(1) | arg(4, LE) | value(4, LE) | crc8(1)
+ * For response frame, 'arg' carries the (signed) status of command */
+#define FAST_CMD_FRAME_SIZE		11
+
+/* Max time (in msec) to receive rest of the frame after sync byte */
+#define FAST_CMD_FRAME_TIMEOUT_MS	10
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/* Fast path commands. 'arg' and 'value' fields per command:
+ * REG_READ: arg = register (AD70081Z_R1B/R2B | address), value = read data
+ * REG_WRITE: arg = register (AD70081Z_R1B/R2B | address), value = data
+ * DAC_SET: arg = DAC channel, value = DAC code
+ * ADC_READ: arg = ADC mux channel, value = ADC code
+ * CAPTURE_START: arg = ADC channel mask (same as IIO buffer channel mask)
+ * CAPTURE_READ: arg = number of scans, value = index of first scan read
+ *   (counted since capture start, including the lost scans)
+ * CAPTURE_STOP: none
+ * Response frame of CAPTURE_READ (on success) is followed by the data:
+ *   samples(num_of_scans * num_of_chns * 2, LE, interleaved channels) | crc8(1)
+ * The scans are captured back to back across the reads (refer
+ * read_stream_data()), the max number of scans per read is limited by the
+ * ADC data buffer size. Device is in conversion mode from CAPTURE_START to
+ * CAPTURE_STOP, so all other commands (and IIO buffer capture) return -EBUSY
+ * meanwhile, as they do during an IIO buffer capture */
+enum fast_cmd_id {
+	FAST_CMD_REG_READ = 0x01,
+	FAST_CMD_REG_WRITE,
+	FAST_CMD_DAC_SET,
+	FAST_CMD_ADC_READ,
+	FAST_CMD_CAPTURE_START,
+	FAST_CMD_CAPTURE_READ,
+	FAST_CMD_CAPTURE_STOP
+};
+
+void fast_cmd_init(void);
+bool fast_cmd_step(void);
+bool is_fast_capture_active(void);
+
+#endif /* _AD70081Z_FAST_CMD_H_ */
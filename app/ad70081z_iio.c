@@ -24,6 +24,15 @@
 #include "ad70081z_regs.h"
 #include "app_config.h"
 #include "ad70081z_data_capture.h"
+#include "ad70081z_dac_playback.h"
+#include "ad70081z_dac_waveform.h"
+#include "ad70081z_sweep.h"
+#include "ad70081z_fast_cmd.h"
+#include "ad70081z_compress.h"
+#include "ad70081z_stream_frame.h"
+#include "ad70081z_config_store.h"
+#include "app_profile.h"
+#include "desc_pool.h"
 #include "error.h"
 #include "util.h"
 
@@ -63,14 +72,14 @@ static ssize_t iio_ad70081z_attr_available_set(void *device, char *buf,
 	.store = iio_ad70081z_attr_available_set\
 }
 
-#define AD70081Z_DAC_CH(_name, _idx) {\
+#define AD70081Z_DAC_CH(_name, _idx, _scan_type) {\
 	.name = _name # _idx, \
 	.ch_type = IIO_VOLTAGE,\
 	.ch_out = 1,\
 	.indexed = true,\
 	.channel = _idx,\
 	.scan_index = _idx,\
-	.scan_type = NULL,\
+	.scan_type = &_scan_type,\
 	.attributes = iio_ad700081z_dac_ch_attributes\
 }
 
@@ -99,20 +108,40 @@ static ssize_t iio_ad70081z_attr_available_set(void *device, char *buf,
 #define		BYTE_SIZE		(uint32_t)8
 #define		BYTE_MASK		(uint32_t)0xff
 
-#define REFERENCE_VOLTAGE	2.5
+/* Reference voltage in mV */
+#define REFERENCE_VOLTAGE_MV	2500
 
 #define IDAC_MAX_DATA_COUNT		(1 << 10)
 #define VDAC16_MAX_DATA_COUNT	(1 << 16)
 #define VDAC12_MAX_DATA_COUNT	(1 << 12)
 #define ADC_MAX_DATA_COUNT		(1 << 16)
 
-#define ADC_CHN_COUNT		23
+/* Number of AFE mux channel indexes used as ADC IIO channel numbers */
+#define ADC_MUX_CHN_COUNT	(AD70081Z_E25_SOA_VS1 + 1)
 
-/* ADC Raw to Voltage conversion default scale factor for IIO client */
-#define ADC_DEFAULT_SCALE		((REFERENCE_VOLTAGE / ADC_MAX_DATA_COUNT) * 1000)
+/* Number of fractional digits for raw_stddev attribute (matches STDDEV_SCALE) */
+#define RAW_STDDEV_FRAC_DIGITS	2
 
-/* Scale attribute value per channel */
-static float attr_scale_val[ADC_CHN_COUNT] = {
+/* Number of fractional digits for stream_compression_ratio attribute */
+#define COMPRESSION_RATIO_FRAC_DIGITS	2
+
+/* Number of fractional digits used for fixed-point attribute values */
+#define SCALE_FRAC_DIGITS		6
+#define DAC_VOLTAGE_FRAC_DIGITS	4
+#define IADC_CURRENT_FRAC_DIGITS	6
+
+/* 10^SCALE_FRAC_DIGITS and 10^DAC_VOLTAGE_FRAC_DIGITS multipliers */
+#define SCALE_FRAC_MULT			1000000ul
+#define DAC_VOLTAGE_FRAC_MULT	10000ul
+#define IADC_CURRENT_FRAC_MULT	1000000ull
+
+/* ADC Raw to Voltage conversion default scale factor (in mV) for IIO client,
+ * stored as a fixed-point value scaled by SCALE_FRAC_MULT (rounded) */
+#define ADC_DEFAULT_SCALE		(((REFERENCE_VOLTAGE_MV * SCALE_FRAC_MULT) + \
+					  (ADC_MAX_DATA_COUNT / 2)) / ADC_MAX_DATA_COUNT)
+
+/* Scale attribute value per channel (fixed-point, scaled by SCALE_FRAC_MULT) */
+static uint32_t attr_scale_val[ADC_CHN_COUNT] = {
 	ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE,
 	ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE,
 	ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE,
@@ -121,6 +150,23 @@ static float attr_scale_val[ADC_CHN_COUNT] = {
 	ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE, ADC_DEFAULT_SCALE
 };
 
+/* Number of samples averaged per 'raw' attribute read, per channel */
+static uint16_t raw_average_count[ADC_MUX_CHN_COUNT];
+
+/* Standard deviation of the last averaged 'raw' read per channel
+ * (scaled by STDDEV_SCALE) */
+static uint32_t raw_stddev[ADC_MUX_CHN_COUNT];
+
+/* Standard sampling rates (in SPS) listed as available along with the max
+ * sampling rate for the current OSR. All have an integer usec period, so that
+ * these are exactly achievable by the conversion trigger */
+static const uint32_t std_sampling_rates[] = {
+	1000, 2000, 5000, 10000, 20000, 25000, 40000, 50000, 100000
+};
+
+/* Oversampling ratios (mapped to ad70081z_adc_config_osr enum) */
+static const uint8_t osr_ratios[] = { 1, 4, 16, 64 };
+
 /* Bytes per sample. This count should divide the total 256 bytes into 'n' equivalent
  * ADC samples as IIO library requests only 256bytes of data at a time in a given
  * data read query.
@@ -133,6 +179,9 @@ static float attr_scale_val[ADC_CHN_COUNT] = {
 /* Number of data storage bits (needed for IIO client to plot ADC data) */
 #define CHN_STORAGE_BITS	(BYTES_PER_SAMPLE * 8)
 
+/* Number of IIO devices (ADC and DAC) */
+#define IIO_DEV_COUNT		2
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
@@ -143,9 +192,19 @@ static struct iio_desc *p_ad70081z_iio_desc;
 /* IIO Device name */
 static const char dev_name[] = IIO_DEVICE_NAME;
 
+/* IIO device descriptors pool */
+DESC_POOL_DEFINE(iio_dev_pool, struct iio_device, IIO_DEV_COUNT);
+
 /* Pointer to the struct representing the IIO device */
 struct ad70081z_dev *p_ad70081z_dev_inst = NULL;
 
+/* Startup time metrics in usec, from the end of system peripherals init (time
+ * base is not running before). First response time is 0 until the first IIO
+ * command is served */
+static uint32_t startup_begin_us;
+static uint32_t startup_init_us;
+static uint32_t startup_first_response_us;
+
 /* AD70081z device types */
 enum ad70081z_dev_type {
 	AD70081Z_ADC,
@@ -182,14 +241,48 @@ enum ad70081z_attribute_ids {
 	IDAC_SHUTDOWN_ENABLE,
 	REFERENCE_SOURCE,
 
+	DAC_SAMPLING_FREQUENCY,
+
+	DAC_WAVEFORM_TYPE,
+	DAC_WAVEFORM_AMPLITUDE,
+	DAC_WAVEFORM_OFFSET,
+	DAC_WAVEFORM_STEP,
+	DAC_WAVEFORM_PERIOD,
+	DAC_WAVEFORM_ENABLE,
+	DAC_WAVEFORM_UPDATE_RATE,
+
+	DAC_SWEEP_START,
+	DAC_SWEEP_STOP,
+	DAC_SWEEP_STEP,
+
 	ADC_RAW,
+	ADC_RAW_AVERAGE_COUNT,
+	ADC_RAW_STDDEV,
 	ADC_SCALE,
 	ADC_OFFSET,
 	ADC_SAMPLING_FREQUENCY,
+	ADC_OVERSAMPLING_RATIO,
 
 	IADC_INPUT_CURRENT_RANGE,
 	IADC_INPUT_CURRENT,
 	IADC_RSENSE,
+	IADC_IDLE_TIMEOUT,
+
+	ADC_SWEEP_ENABLE,
+	ADC_SWEEP_SETTLE_TIME,
+	ADC_SWEEP_AVERAGE_COUNT,
+	ADC_SWEEP_POINTS,
+
+	ADC_STREAM_COMPRESSION,
+	ADC_STREAM_COMPRESSION_RATIO,
+	ADC_STREAM_FRAMING,
+
+	CONFIG_SAVE,
+	CONFIG_RESTORE,
+
+	DEBUG_PROFILE,
+	DEBUG_ISR_LATENCY,
+	DEBUG_STARTUP_TIME,
 };
 
 /* ADC channel scan structure */
@@ -201,6 +294,40 @@ static struct scan_type ad70081z_adc_scan_type = {
 	.is_big_endian = false
 };
 
+/* DAC waveform generator types (in the order of enum dac_waveform_type) */
+static const char *dac_waveform_types[] = {
+	"None",
+	"Ramp",
+	"Staircase",
+	"Sine",
+	"Triangle"
+};
+
+/* DAC channels scan structures (codes are right aligned into 16-bit words) */
+static struct scan_type ad70081z_idac_scan_type = {
+	.realbits = 10,
+	.storagebits = 16,
+	.shift = 0,
+	.sign = 'u',
+	.is_big_endian = false
+};
+
+static struct scan_type ad70081z_vdac16_scan_type = {
+	.realbits = 16,
+	.storagebits = 16,
+	.shift = 0,
+	.sign = 'u',
+	.is_big_endian = false
+};
+
+static struct scan_type ad70081z_vdac12_scan_type = {
+	.realbits = 12,
+	.storagebits = 16,
+	.shift = 0,
+	.sign = 'u',
+	.is_big_endian = false
+};
+
 /* DAC channel attributes structure */
 static struct iio_attribute iio_ad700081z_dac_ch_attributes[] = {
 	/* DAC data, voltage and current attributes */
@@ -229,12 +356,27 @@ static struct iio_attribute iio_ad700081z_dac_ch_attributes[] = {
 	/* IDAC channel enable channel attributes */
 	AD70081Z_CHN_ATTR("shutdown_enable", IDAC_SHUTDOWN_ENABLE),
 
+	/* DAC waveform generator channel attributes */
+	AD70081Z_CHN_ATTR("waveform_type", DAC_WAVEFORM_TYPE),
+	AD70081Z_CHN_AVAIL_ATTR("waveform_type_available", DAC_WAVEFORM_TYPE),
+	AD70081Z_CHN_ATTR("waveform_amplitude", DAC_WAVEFORM_AMPLITUDE),
+	AD70081Z_CHN_ATTR("waveform_offset", DAC_WAVEFORM_OFFSET),
+	AD70081Z_CHN_ATTR("waveform_step", DAC_WAVEFORM_STEP),
+	AD70081Z_CHN_ATTR("waveform_period", DAC_WAVEFORM_PERIOD),
+
+	/* DAC sweep channel attributes */
+	AD70081Z_CHN_ATTR("sweep_start", DAC_SWEEP_START),
+	AD70081Z_CHN_ATTR("sweep_stop", DAC_SWEEP_STOP),
+	AD70081Z_CHN_ATTR("sweep_step", DAC_SWEEP_STEP),
+
 	END_ATTRIBUTES_ARRAY,
 };
 
 /* VADC channel attributes structure */
 static struct iio_attribute iio_ad700081z_vadc_ch_attributes[] = {
 	AD70081Z_CHN_ATTR("raw", ADC_RAW),
+	AD70081Z_CHN_ATTR("raw_average_count", ADC_RAW_AVERAGE_COUNT),
+	AD70081Z_CHN_ATTR("raw_stddev", ADC_RAW_STDDEV),
 	AD70081Z_CHN_ATTR("scale", ADC_SCALE),
 	AD70081Z_CHN_ATTR("offset", ADC_OFFSET),
 	END_ATTRIBUTES_ARRAY,
@@ -243,6 +385,8 @@ static struct iio_attribute iio_ad700081z_vadc_ch_attributes[] = {
 /* IADC channel attributes structure */
 static struct iio_attribute iio_ad700081z_iadc_ch_attributes[] = {
 	AD70081Z_CHN_ATTR("raw", ADC_RAW),
+	AD70081Z_CHN_ATTR("raw_average_count", ADC_RAW_AVERAGE_COUNT),
+	AD70081Z_CHN_ATTR("raw_stddev", ADC_RAW_STDDEV),
 	AD70081Z_CHN_ATTR("scale", ADC_SCALE),
 	AD70081Z_CHN_ATTR("offset", ADC_OFFSET),
 
@@ -262,6 +406,14 @@ static struct iio_attribute dac_global_attributes[] = {
 	AD70081Z_CHN_AVAIL_ATTR("compare_enable_available", DAC_COMPARE_ENABLE),
 	AD70081Z_CHN_ATTR("reference_source", REFERENCE_SOURCE),
 	AD70081Z_CHN_AVAIL_ATTR("reference_source_available", REFERENCE_SOURCE),
+	AD70081Z_CHN_ATTR("sampling_frequency", DAC_SAMPLING_FREQUENCY),
+	AD70081Z_CHN_ATTR("waveform_enable", DAC_WAVEFORM_ENABLE),
+	AD70081Z_CHN_AVAIL_ATTR("waveform_enable_available", DAC_WAVEFORM_ENABLE),
+	AD70081Z_CHN_ATTR("waveform_update_rate", DAC_WAVEFORM_UPDATE_RATE),
+#if defined(ENABLE_CONFIG_STORE)
+	AD70081Z_CHN_ATTR("config_save", CONFIG_SAVE),
+	AD70081Z_CHN_ATTR("config_restore", CONFIG_RESTORE),
+#endif
 	END_ATTRIBUTES_ARRAY,
 };
 
@@ -270,11 +422,36 @@ static struct iio_attribute adc_global_attributes[] = {
 	AD70081Z_CHN_ATTR("reference_source", REFERENCE_SOURCE),
 	AD70081Z_CHN_AVAIL_ATTR("reference_source_available", REFERENCE_SOURCE),
 	AD70081Z_CHN_ATTR("sampling_frequency", ADC_SAMPLING_FREQUENCY),
+	AD70081Z_CHN_AVAIL_ATTR("sampling_frequency_available", ADC_SAMPLING_FREQUENCY),
+	AD70081Z_CHN_ATTR("oversampling_ratio", ADC_OVERSAMPLING_RATIO),
+	AD70081Z_CHN_AVAIL_ATTR("oversampling_ratio_available", ADC_OVERSAMPLING_RATIO),
+	AD70081Z_CHN_ATTR("iadc_idle_timeout_ms", IADC_IDLE_TIMEOUT),
+	AD70081Z_CHN_ATTR("sweep_enable", ADC_SWEEP_ENABLE),
+	AD70081Z_CHN_AVAIL_ATTR("sweep_enable_available", ADC_SWEEP_ENABLE),
+	AD70081Z_CHN_ATTR("sweep_settle_us", ADC_SWEEP_SETTLE_TIME),
+	AD70081Z_CHN_ATTR("sweep_average_count", ADC_SWEEP_AVERAGE_COUNT),
+	AD70081Z_CHN_ATTR("sweep_points", ADC_SWEEP_POINTS),
+	AD70081Z_CHN_ATTR("stream_compression", ADC_STREAM_COMPRESSION),
+	AD70081Z_CHN_AVAIL_ATTR("stream_compression_available", ADC_STREAM_COMPRESSION),
+	AD70081Z_CHN_ATTR("stream_compression_ratio", ADC_STREAM_COMPRESSION_RATIO),
+	AD70081Z_CHN_ATTR("stream_framing", ADC_STREAM_FRAMING),
+	AD70081Z_CHN_AVAIL_ATTR("stream_framing_available", ADC_STREAM_FRAMING),
+#if defined(ENABLE_CONFIG_STORE)
+	AD70081Z_CHN_ATTR("config_save", CONFIG_SAVE),
+	AD70081Z_CHN_ATTR("config_restore", CONFIG_RESTORE),
+#endif
 	END_ATTRIBUTES_ARRAY,
 };
 
 /* IIOD debug attributes list */
 static struct iio_attribute debug_attributes[] = {
+#if defined(ENABLE_PROFILING)
+	AD70081Z_CHN_ATTR("profile", DEBUG_PROFILE),
+#endif
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+	AD70081Z_CHN_ATTR("isr_latency", DEBUG_ISR_LATENCY),
+#endif
+	AD70081Z_CHN_ATTR("startup_time", DEBUG_STARTUP_TIME),
 	END_ATTRIBUTES_ARRAY
 };
 
@@ -283,6 +460,11 @@ struct iio_data_buffer adc_data_buff = {
 	.buff = adc_data_buffer
 };
 
+struct iio_data_buffer dac_data_buff = {
+	.size = DAC_DATA_BUFFER_SIZE,
+	.buff = dac_data_buffer
+};
+
 /******************************************************************************/
 /************************** Functions Declarations ****************************/
 /******************************************************************************/
@@ -291,6 +473,36 @@ struct iio_data_buffer adc_data_buff = {
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/*!
+ * @brief	List the achievable sampling rates for the current OSR
+ * @param	buf[out] - Output string buffer
+ * @param	len[in] - Size of output buffer
+ * @return	Number of characters written in case of SUCCESS, negative error code otherwise
+ */
+static ssize_t sampling_rates_available_to_str(char *buf, size_t len)
+{
+	uint32_t max_rate = get_max_sampling_rate();
+	size_t indx = 0;
+	int ret;
+
+	for (uint8_t i = 0; i < ARRAY_SIZE(std_sampling_rates); i++) {
+		if (std_sampling_rates[i] < MIN_SAMPLING_RATE
+		    || std_sampling_rates[i] >= max_rate)
+			continue;
+
+		ret = snprintf(buf + indx, len - indx, "%lu ", std_sampling_rates[i]);
+		if (ret < 0 || (size_t)ret >= len - indx)
+			return -EINVAL;
+		indx += ret;
+	}
+
+	ret = snprintf(buf + indx, len - indx, "%lu", max_rate);
+	if (ret < 0 || (size_t)ret >= len - indx)
+		return -EINVAL;
+
+	return indx + ret;
+}
+
 /*!
  * @brief	Attribute available getter function for DAC attributes
  * @param	device[in]- Pointer to IIO device instance
@@ -310,14 +522,27 @@ static ssize_t iio_ad70081z_attr_available_get(void *device, char *buf,
 
 	case DAC_TOGGLE_ENABLE:
 	case DAC_COMPARE_ENABLE:
+	case DAC_WAVEFORM_ENABLE:
+	case ADC_SWEEP_ENABLE:
+	case ADC_STREAM_COMPRESSION:
+	case ADC_STREAM_FRAMING:
 		return sprintf(buf, "%s", "Disable Enable");
 
+	case DAC_WAVEFORM_TYPE:
+		return sprintf(buf, "%s", "None Ramp Staircase Sine Triangle");
+
 	case IADC_INPUT_CURRENT_RANGE:
 		return sprintf(buf, "%s", "6.25-50uA 1.25-10uA 5-40uA NA");
 
 	case REFERENCE_SOURCE:
 		return sprintf(buf, "%s", "External Internal");
 
+	case ADC_SAMPLING_FREQUENCY:
+		return sampling_rates_available_to_str(buf, len);
+
+	case ADC_OVERSAMPLING_RATIO:
+		return sprintf(buf, "%s", "1 4 16 64");
+
 	default:
 		break;
 	}
@@ -341,6 +566,48 @@ static ssize_t iio_ad70081z_attr_available_set(void *device, char *buf,
 	return len;
 }
 
+/*!
+ * @brief	Convert a fixed-point value into a decimal string
+ * @param	buf[out] - Output string buffer
+ * @param	len[in] - Size of output buffer
+ * @param	val[in] - Value scaled by 10^frac_digits
+ * @param	frac_digits[in] - Number of fractional digits in val
+ * @return	Number of characters written in case of SUCCESS, negative error code otherwise
+ * @note	Avoids float printf formatting, so that a minimal printf library
+ *			can be used by the firmware
+ */
+static ssize_t fixed_point_to_str(char *buf, size_t len, uint64_t val,
+				  uint8_t frac_digits)
+{
+	char digits[24];
+	uint8_t num_digits = 0;
+	size_t indx = 0;
+
+	/* Extract decimal digits (least significant first) */
+	do {
+		digits[num_digits++] = '0' + (val % 10);
+		val /= 10;
+	} while (val > 0 && num_digits < sizeof(digits));
+
+	/* Pad with zeros to have at least one integer digit */
+	while (num_digits <= frac_digits && num_digits < sizeof(digits)) {
+		digits[num_digits++] = '0';
+	}
+
+	/* Digits + decimal point + NUL terminator */
+	if (len < (size_t)num_digits + 2)
+		return -EINVAL;
+
+	while (num_digits > 0) {
+		if (num_digits == frac_digits)
+			buf[indx++] = '.';
+		buf[indx++] = digits[--num_digits];
+	}
+	buf[indx] = '\0';
+
+	return indx;
+}
+
 /*!
  * @brief	Getter function for DAC attributes
  * @param	device[in]- Pointer to IIO device instance
@@ -374,15 +641,19 @@ static int32_t get_dac_multibyte_reg_and_mask(void *device, uint8_t chn,
  * @param	priv[in] - Attribute private ID
  * @return	len in case of SUCCESS, negative error code otherwise
  */
-static ssize_t iio_ad70081z_attr_get(void *device, char *buf, size_t len,
-				     const struct iio_ch_info *channel, intptr_t priv)
+static ssize_t ad70081z_attr_get_handler(void *device, char *buf, size_t len,
+		const struct iio_ch_info *channel, intptr_t priv)
 {
 	uint32_t val;
 	int32_t	 ret;
 	uint8_t dac_chn_msk;
-	float voltage;
-	float iadc_input_current;
+	uint32_t max_count;
+	uint32_t voltage;
+	uint64_t iadc_input_current;
+	uint32_t rsense;
 	enum ad70081z_iadc_range range;
+	struct dac_waveform_config waveform;
+	struct sweep_dac_config sweep;
 
 	val = srt_to_uint32(buf);
 
@@ -415,17 +686,21 @@ static ssize_t iio_ad70081z_attr_get(void *device, char *buf, size_t len,
 			return ret;
 
 		if (channel->ch_num < AD70081Z_IDAC_CH_LIMIT) {
-			voltage = (val * REFERENCE_VOLTAGE) / IDAC_MAX_DATA_COUNT;
+			max_count = IDAC_MAX_DATA_COUNT;
 		} else {
 			if ((channel->ch_num == AD70081Z_E8_MZDB)
 			    || (channel->ch_num == AD70081Z_E0_TECC)) {
-				voltage = (val * REFERENCE_VOLTAGE) / VDAC12_MAX_DATA_COUNT;
+				max_count = VDAC12_MAX_DATA_COUNT;
 			} else {
-				voltage = (val * REFERENCE_VOLTAGE) / VDAC16_MAX_DATA_COUNT;
+				max_count = VDAC16_MAX_DATA_COUNT;
 			}
 		}
 
-		return snprintf(buf, len, "%.4f", voltage);
+		/* Voltage in units of 0.1mV (rounded to nearest) */
+		voltage = (((uint16_t)val * (REFERENCE_VOLTAGE_MV * DAC_VOLTAGE_FRAC_MULT / 1000))
+			   + (max_count / 2)) / max_count;
+
+		return fixed_point_to_str(buf, len, voltage, DAC_VOLTAGE_FRAC_DIGITS);
 
 	/****************** DAC Toggle SW/HW getters ******************/
 	case DAC_TOGGLE_ENABLE:
@@ -555,20 +830,85 @@ static ssize_t iio_ad70081z_attr_get(void *device, char *buf, size_t len,
 
 	/****************** ADC channel getters ******************/
 	case ADC_RAW:
-		ret = read_single_sample((uint8_t)channel->ch_num, &val);
+		ret = read_averaged_sample((uint8_t)channel->ch_num,
+					   raw_average_count[channel->ch_num], &val,
+					   &raw_stddev[channel->ch_num]);
 		if (IS_ERR_VALUE(ret))
 			return ret;
 
 		return snprintf(buf, len, "%u", (uint16_t)val);
 
+	case ADC_RAW_AVERAGE_COUNT:
+		return snprintf(buf, len, "%u", raw_average_count[channel->ch_num]);
+
+	case ADC_RAW_STDDEV:
+		return fixed_point_to_str(buf, len, raw_stddev[channel->ch_num],
+					  RAW_STDDEV_FRAC_DIGITS);
+
 	case ADC_SCALE:
-		return sprintf(buf, "%f", attr_scale_val[channel->ch_num]);
+		return fixed_point_to_str(buf, len, attr_scale_val[channel->ch_num],
+					  SCALE_FRAC_DIGITS);
 
 	case ADC_OFFSET:
 		return snprintf(buf, len, "%d", 0);
 
+	case DAC_SAMPLING_FREQUENCY:
+		return snprintf(buf, len, "%lu", get_dac_update_rate());
+
+	/****************** DAC Waveform generator getters ******************/
+	case DAC_WAVEFORM_TYPE:
+		get_dac_waveform_config(channel->ch_num, &waveform);
+		return snprintf(buf, len, "%s", dac_waveform_types[waveform.type]);
+
+	case DAC_WAVEFORM_AMPLITUDE:
+		get_dac_waveform_config(channel->ch_num, &waveform);
+		return snprintf(buf, len, "%d", waveform.amplitude);
+
+	case DAC_WAVEFORM_OFFSET:
+		get_dac_waveform_config(channel->ch_num, &waveform);
+		return snprintf(buf, len, "%d", waveform.offset);
+
+	case DAC_WAVEFORM_STEP:
+		get_dac_waveform_config(channel->ch_num, &waveform);
+		return snprintf(buf, len, "%d", waveform.step);
+
+	case DAC_WAVEFORM_PERIOD:
+		get_dac_waveform_config(channel->ch_num, &waveform);
+		return snprintf(buf, len, "%lu", waveform.period);
+
+	case DAC_WAVEFORM_ENABLE:
+		/* Report the device error which stopped the generator */
+		ret = get_dac_waveform_status();
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		if (is_dac_waveform_running()) {
+			return snprintf(buf, len, "%s", "Enable");
+		} else {
+			return snprintf(buf, len, "%s", "Disable");
+		}
+
+	case DAC_WAVEFORM_UPDATE_RATE:
+		return snprintf(buf, len, "%lu", get_dac_waveform_achieved_rate());
+
+	/****************** DAC Sweep getters ******************/
+	case DAC_SWEEP_START:
+		get_sweep_dac_config(channel->ch_num, &sweep);
+		return snprintf(buf, len, "%d", sweep.start);
+
+	case DAC_SWEEP_STOP:
+		get_sweep_dac_config(channel->ch_num, &sweep);
+		return snprintf(buf, len, "%d", sweep.stop);
+
+	case DAC_SWEEP_STEP:
+		get_sweep_dac_config(channel->ch_num, &sweep);
+		return snprintf(buf, len, "%d", sweep.step);
+
 	case ADC_SAMPLING_FREQUENCY:
-		return snprintf(buf, len, "%d", SAMPLING_RATE);
+		return snprintf(buf, len, "%lu", get_sampling_rate());
+
+	case ADC_OVERSAMPLING_RATIO:
+		return snprintf(buf, len, "%d", osr_ratios[p_ad70081z_dev_inst->osr]);
 
 	case IADC_INPUT_CURRENT_RANGE:
 		if (channel->ch_num >= AD70081Z_E19_TOND_IS0
@@ -590,19 +930,70 @@ static ssize_t iio_ad70081z_attr_get(void *device, char *buf, size_t len,
 		}
 
 	case IADC_INPUT_CURRENT:
-		ret = read_single_sample((uint8_t)channel->ch_num, &val);
+		ret = read_averaged_sample((uint8_t)channel->ch_num,
+					   raw_average_count[channel->ch_num], &val,
+					   &raw_stddev[channel->ch_num]);
 		if (IS_ERR_VALUE(ret))
 			return ret;
 
-		iadc_input_current = (REFERENCE_VOLTAGE / ADC_MAX_DATA_COUNT) *
-				     ((float)val / p_ad70081z_dev_inst->iadc_rsense[channel->ch_num -
-								     AD70081Z_E10_WPD_IS0]);
-		return snprintf(buf, len, "%f", iadc_input_current);
+		rsense = p_ad70081z_dev_inst->iadc_rsense[channel->ch_num -
+							  AD70081Z_E10_WPD_IS0];
+		if (!rsense)
+			return -EINVAL;
+
+		/* Input current in units of 1uA (rounded to nearest) */
+		iadc_input_current = (((uint64_t)(uint16_t)val * REFERENCE_VOLTAGE_MV *
+				       (IADC_CURRENT_FRAC_MULT / 1000)) +
+				      (((uint64_t)rsense * ADC_MAX_DATA_COUNT) / 2)) /
+				     ((uint64_t)rsense * ADC_MAX_DATA_COUNT);
+
+		return fixed_point_to_str(buf, len, iadc_input_current,
+					  IADC_CURRENT_FRAC_DIGITS);
 
 	case IADC_RSENSE:
 		val = p_ad70081z_dev_inst->iadc_rsense[channel->ch_num - AD70081Z_E10_WPD_IS0];
 		return snprintf(buf, len, "%u", (uint16_t)val);
 
+	case IADC_IDLE_TIMEOUT:
+		return snprintf(buf, len, "%lu", (unsigned long)get_iadc_idle_timeout());
+
+	/****************** ADC Sweep getters ******************/
+	case ADC_SWEEP_ENABLE:
+		if (is_sweep_enabled()) {
+			return snprintf(buf, len, "%s", "Enable");
+		} else {
+			return snprintf(buf, len, "%s", "Disable");
+		}
+
+	case ADC_SWEEP_SETTLE_TIME:
+		return snprintf(buf, len, "%lu", (unsigned long)get_sweep_settle_time());
+
+	case ADC_SWEEP_AVERAGE_COUNT:
+		return snprintf(buf, len, "%u", get_sweep_average_count());
+
+	case ADC_SWEEP_POINTS:
+		return snprintf(buf, len, "%lu", (unsigned long)get_sweep_num_of_points());
+
+	/****************** ADC stream compression getters ******************/
+	case ADC_STREAM_COMPRESSION:
+		if (is_stream_compression_enabled()) {
+			return snprintf(buf, len, "%s", "Enable");
+		} else {
+			return snprintf(buf, len, "%s", "Disable");
+		}
+
+	case ADC_STREAM_COMPRESSION_RATIO:
+		return fixed_point_to_str(buf, len, get_stream_compression_ratio(),
+					  COMPRESSION_RATIO_FRAC_DIGITS);
+
+	/****************** ADC stream framing getters ******************/
+	case ADC_STREAM_FRAMING:
+		if (is_stream_framing_enabled()) {
+			return snprintf(buf, len, "%s", "Enable");
+		} else {
+			return snprintf(buf, len, "%s", "Disable");
+		}
+
 	/****************** DAC/ADC common (global) getters ******************/
 	case REFERENCE_SOURCE:
 		ret = ad70081z_spi_reg_read(device, AD70081Z_REF_CONFIG, &val);
@@ -615,6 +1006,30 @@ static ssize_t iio_ad70081z_attr_get(void *device, char *buf, size_t len,
 			return snprintf(buf, len, "%s", "External");
 		}
 
+	/****************** Configuration store getters ******************/
+#if defined(ENABLE_CONFIG_STORE)
+	case CONFIG_SAVE:
+	case CONFIG_RESTORE:
+		/* 1 if a configuration is saved in flash */
+		return snprintf(buf, len, "%d", is_config_stored() ? 1 : 0);
+#endif
+
+	/****************** Debug getters ******************/
+#if defined(ENABLE_PROFILING)
+	case DEBUG_PROFILE:
+		return profile_to_str(buf, len);
+#endif
+
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+	case DEBUG_ISR_LATENCY:
+		return profile_latency_to_str(buf, len);
+#endif
+
+	case DEBUG_STARTUP_TIME:
+		return snprintf(buf, len, "init_us: %lu\nfirst_response_us: %lu",
+				(unsigned long)startup_init_us,
+				(unsigned long)startup_first_response_us);
+
 	default:
 		break;
 	}
@@ -622,6 +1037,27 @@ static ssize_t iio_ad70081z_attr_get(void *device, char *buf, size_t len,
 	return len;
 }
 
+/*!
+ * @brief	Getter function for attributes (profiled)
+ * @param	device[in]- Pointer to IIO device instance
+ * @param	buf[in]- IIO input data buffer
+ * @param	len[in]- Number of input bytes
+ * @param	channel[in] - Input channel
+ * @param	priv[in] - Attribute private ID
+ * @return	len in case of SUCCESS, negative error code otherwise
+ */
+static ssize_t iio_ad70081z_attr_get(void *device, char *buf, size_t len,
+				     const struct iio_ch_info *channel, intptr_t priv)
+{
+	ssize_t ret;
+
+	PROFILE_START(PROFILE_ATTR_GET);
+	ret = ad70081z_attr_get_handler(device, buf, len, channel, priv);
+	PROFILE_STOP(PROFILE_ATTR_GET);
+
+	return ret;
+}
+
 /*!
  * @brief	Setter function for DAC attributes
  * @param	device[in]- Pointer to IIO device instance
@@ -631,12 +1067,14 @@ static ssize_t iio_ad70081z_attr_get(void *device, char *buf, size_t len,
  * @param	priv[in] - Attribute private ID
  * @return	len in case of SUCCESS, negative error code otherwise
  */
-static ssize_t iio_ad70081z_attr_set(void *device, char *buf, size_t len,
-				     const struct iio_ch_info *channel, intptr_t priv)
+static ssize_t ad70081z_attr_set_handler(void *device, char *buf, size_t len,
+		const struct iio_ch_info *channel, intptr_t priv)
 {
 	uint32_t val;
 	int32_t	 ret = SUCCESS;
 	enum ad70081z_iadc_range range;
+	struct dac_waveform_config waveform;
+	struct sweep_dac_config sweep;
 
 	val = srt_to_uint32(buf);
 
@@ -827,13 +1265,119 @@ static ssize_t iio_ad70081z_attr_set(void *device, char *buf, size_t len,
 
 	/****************** ADC channel setters ******************/
 	case ADC_RAW:
+	case ADC_RAW_STDDEV:
 	case ADC_OFFSET:
 	case ADC_SCALE:
-	case ADC_SAMPLING_FREQUENCY:
 	case IADC_INPUT_CURRENT:
 		/* These attributes are read only */
 		return len;
 
+	case DAC_SAMPLING_FREQUENCY:
+		ret = set_dac_update_rate(val);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	/****************** DAC Waveform generator setters ******************/
+	case DAC_WAVEFORM_TYPE:
+	case DAC_WAVEFORM_AMPLITUDE:
+	case DAC_WAVEFORM_OFFSET:
+	case DAC_WAVEFORM_STEP:
+	case DAC_WAVEFORM_PERIOD:
+		get_dac_waveform_config(channel->ch_num, &waveform);
+
+		if (priv == DAC_WAVEFORM_TYPE) {
+			for (val = 0; val < ARRAY_SIZE(dac_waveform_types); val++) {
+				if (!strncmp(buf, dac_waveform_types[val], strlen(buf)))
+					break;
+			}
+			waveform.type = (enum dac_waveform_type)val;
+		} else if (priv == DAC_WAVEFORM_PERIOD) {
+			waveform.period = val;
+		} else {
+			if (val > UINT16_MAX)
+				return -EINVAL;
+
+			if (priv == DAC_WAVEFORM_AMPLITUDE)
+				waveform.amplitude = val;
+			else if (priv == DAC_WAVEFORM_OFFSET)
+				waveform.offset = val;
+			else
+				waveform.step = val;
+		}
+
+		ret = set_dac_waveform_config(channel->ch_num, &waveform);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case DAC_WAVEFORM_ENABLE:
+		if (!strncmp(buf, "Enable", strlen(buf))) {
+			ret = start_dac_waveform();
+		} else {
+			ret = stop_dac_waveform();
+		}
+
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case DAC_WAVEFORM_UPDATE_RATE:
+		/* This attribute is read only */
+		return len;
+
+	/****************** DAC Sweep setters ******************/
+	case DAC_SWEEP_START:
+	case DAC_SWEEP_STOP:
+	case DAC_SWEEP_STEP:
+		if (val > UINT16_MAX)
+			return -EINVAL;
+
+		get_sweep_dac_config(channel->ch_num, &sweep);
+
+		if (priv == DAC_SWEEP_START)
+			sweep.start = val;
+		else if (priv == DAC_SWEEP_STOP)
+			sweep.stop = val;
+		else
+			sweep.step = val;
+
+		ret = set_sweep_dac_config(channel->ch_num, &sweep);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case ADC_SAMPLING_FREQUENCY:
+		ret = set_sampling_rate(val);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case ADC_OVERSAMPLING_RATIO:
+		for (uint8_t osr = 0; osr < ARRAY_SIZE(osr_ratios); osr++) {
+			if (val == osr_ratios[osr]) {
+				ret = set_oversampling_ratio((enum ad70081z_adc_config_osr)osr);
+				if (IS_ERR_VALUE(ret))
+					return ret;
+
+				return len;
+			}
+		}
+
+		return -EINVAL;
+
+	case ADC_RAW_AVERAGE_COUNT:
+		if (!val || val > MAX_RAW_AVERAGE_COUNT)
+			return -EINVAL;
+
+		raw_average_count[channel->ch_num] = val;
+		return len;
+
 	case IADC_INPUT_CURRENT_RANGE:
 		if (!strncmp(buf, "6.25-50uA", strlen(buf))) {
 			range = AD70081Z_IADC_RANGE_6p25_50uA;
@@ -860,6 +1404,77 @@ static ssize_t iio_ad70081z_attr_set(void *device, char *buf, size_t len,
 
 		return len;
 
+	case IADC_IDLE_TIMEOUT:
+		ret = set_iadc_idle_timeout(val);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	/****************** ADC Sweep setters ******************/
+	case ADC_SWEEP_ENABLE:
+		if (!strncmp(buf, "Enable", strlen(buf))) {
+			ret = set_sweep_enable(true);
+		} else {
+			ret = set_sweep_enable(false);
+		}
+
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case ADC_SWEEP_SETTLE_TIME:
+		ret = set_sweep_settle_time(val);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case ADC_SWEEP_AVERAGE_COUNT:
+		if (val > UINT16_MAX)
+			return -EINVAL;
+
+		ret = set_sweep_average_count(val);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case ADC_SWEEP_POINTS:
+		/* This attribute is read only */
+		return len;
+
+	/****************** ADC stream compression setters ******************/
+	case ADC_STREAM_COMPRESSION:
+		if (!strncmp(buf, "Enable", strlen(buf))) {
+			ret = set_stream_compression(true);
+		} else {
+			ret = set_stream_compression(false);
+		}
+
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case ADC_STREAM_COMPRESSION_RATIO:
+		/* This attribute is read only */
+		return len;
+
+	/****************** ADC stream framing setters ******************/
+	case ADC_STREAM_FRAMING:
+		if (!strncmp(buf, "Enable", strlen(buf))) {
+			ret = set_stream_framing(true);
+		} else {
+			ret = set_stream_framing(false);
+		}
+
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
 	/****************** DAC/ADC common getters ******************/
 	case REFERENCE_SOURCE:
 		if (!strncmp(buf, "Internal", strlen(buf))) {
@@ -873,6 +1488,57 @@ static ssize_t iio_ad70081z_attr_set(void *device, char *buf, size_t len,
 
 		return len;
 
+	/****************** Configuration store setters ******************/
+#if defined(ENABLE_CONFIG_STORE)
+	case CONFIG_SAVE:
+		/* Write 1 to save the configuration, 0 to discard the saved one */
+		if (val > 1U)
+			return -EINVAL;
+
+		if (val) {
+			ret = config_store_save();
+		} else {
+			ret = config_store_clear();
+		}
+
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+
+	case CONFIG_RESTORE:
+		/* Any write restores the saved configuration */
+		ret = config_store_restore();
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+#endif
+
+	/****************** Debug setters ******************/
+#if defined(ENABLE_PROFILING)
+	case DEBUG_PROFILE:
+		/* Any write resets the statistics */
+		profile_reset();
+		return len;
+#endif
+
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+	case DEBUG_ISR_LATENCY:
+		/* Write sets the bucket width in nsec (0 keeps the width) and
+		 * resets the histogram */
+		if (!val) {
+			profile_latency_reset();
+			return len;
+		}
+
+		ret = profile_latency_set_bucket_width(val);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+#endif
+
 	default:
 		break;
 	}
@@ -880,6 +1546,27 @@ static ssize_t iio_ad70081z_attr_set(void *device, char *buf, size_t len,
 	return len;
 }
 
+/*!
+ * @brief	Setter function for attributes (profiled)
+ * @param	device[in]- Pointer to IIO device instance
+ * @param	buf[in]- IIO input data buffer
+ * @param	len[in]- Number of expected bytes
+ * @param	channel[in] - Input channel
+ * @param	priv[in] - Attribute private ID
+ * @return	len in case of SUCCESS, negative error code otherwise
+ */
+static ssize_t iio_ad70081z_attr_set(void *device, char *buf, size_t len,
+				     const struct iio_ch_info *channel, intptr_t priv)
+{
+	ssize_t ret;
+
+	PROFILE_START(PROFILE_ATTR_SET);
+	ret = ad70081z_attr_set_handler(device, buf, len, channel, priv);
+	PROFILE_STOP(PROFILE_ATTR_SET);
+
+	return ret;
+}
+
 /**
  * @brief	Read buffer data corresponding to AD70081z ADC IIO device
  * @param	dev_instance[in] - IIO device instance
@@ -891,6 +1578,18 @@ static int32_t iio_ad77081z_read_data(void *dev_instance,
 				      void *pbuf,
 				      uint32_t nb_of_samples)
 {
+	/* Run the DAC sweep and read the result table */
+	if (is_sweep_enabled())
+		return read_sweep_data(pbuf, nb_of_samples);
+
+	/* Capture the data in CRC protected frames (compressed if enabled) */
+	if (is_stream_framing_enabled())
+		return read_framed_data(pbuf, nb_of_samples);
+
+	/* Capture the data in blocks and read compressed blocks */
+	if (is_stream_compression_enabled())
+		return read_compressed_data(pbuf, nb_of_samples);
+
 	/* Read the data stored into acquisition buffers */
 	return read_buffered_data(pbuf, nb_of_samples);
 }
@@ -904,6 +1603,13 @@ static int32_t iio_ad77081z_read_data(void *dev_instance,
 static int32_t iio_ad77081z_prepare_transfer(void *dev_instance,
 		uint32_t ch_mask)
 {
+	/* Capture is owned by fast path until it is stopped */
+	if (is_fast_capture_active())
+		return -EBUSY;
+
+	if (is_sweep_enabled())
+		return prepare_sweep(ch_mask, ADC_CHN_COUNT);
+
 	return prepare_data_transfer(ch_mask, ADC_CHN_COUNT, BYTES_PER_SAMPLE);
 }
 
@@ -914,9 +1620,51 @@ static int32_t iio_ad77081z_prepare_transfer(void *dev_instance,
  */
 static int32_t iio_ad77081z_end_transfer(void *dev)
 {
+	if (is_fast_capture_active())
+		return -EBUSY;
+
+	if (is_sweep_enabled())
+		return end_sweep();
+
 	return end_data_transfer();
 }
 
+/**
+ * @brief	Write buffer data to AD70081z DAC IIO device (play out the codes)
+ * @param	dev_instance[in] - IIO device instance
+ * @param	pbuf[in] - Pointer to input data buffer
+ * @param	nb_of_samples[in] - Number of samples to write
+ * @return	SUCCESS in case of success or negative value otherwise
+ */
+static int32_t iio_ad77081z_write_data(void *dev_instance,
+				       void *pbuf,
+				       uint32_t nb_of_samples)
+{
+	return write_dac_playback_data(pbuf, nb_of_samples);
+}
+
+/**
+ * @brief	Prepare the DAC device for buffer data playback
+ * @param	dev_instance[in] - IIO device instance
+ * @param	ch_mask[in] - Channels select mask
+ * @return	SUCCESS in case of success or negative value otherwise
+ */
+static int32_t iio_ad77081z_prepare_dac_transfer(void *dev_instance,
+		uint32_t ch_mask)
+{
+	return prepare_dac_playback(ch_mask);
+}
+
+/**
+ * @brief	Perform tasks before end of current DAC data transfer
+ * @param	dev_instance[in] - IIO device instance
+ * @return	SUCCESS in case of success or negative value otherwise
+ */
+static int32_t iio_ad77081z_end_dac_transfer(void *dev)
+{
+	return end_dac_playback();
+}
+
 /*!
  * @brief	Search the debug register address in look-up table Or registers array
  * @param	addr- Register address to search for
@@ -1035,40 +1783,40 @@ int32_t debug_reg_write(void *dev, uint32_t reg, uint32_t writeval)
 /* IIOD channels configurations */
 static struct iio_channel ad70081z_dac_iio_channels[] = {
 	/* 10-bit DAC Current Channels (Count= 3) */
-	AD70081Z_DAC_CH("idac_", AD70081Z_E24_GAIN),
-	AD70081Z_DAC_CH("idac_", AD70081Z_E25_SOA(0)),
-	AD70081Z_DAC_CH("idac_", AD70081Z_E25_SOA(1)),
+	AD70081Z_DAC_CH("idac_", AD70081Z_E24_GAIN, ad70081z_idac_scan_type),
+	AD70081Z_DAC_CH("idac_", AD70081Z_E25_SOA(0), ad70081z_idac_scan_type),
+	AD70081Z_DAC_CH("idac_", AD70081Z_E25_SOA(1), ad70081z_idac_scan_type),
 
 	/* 16-bit DAC Voltage Channels (Count= 25) */
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E4_MIR(0)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E4_MIR(1)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(0)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(1)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(2)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(3)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(4)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(5)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(6)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(7)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E5_SPH),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E17_SPVOA(0)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E17_SPVOA(1)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E17_SPVOA(2)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E17_SPVOA(3)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E18_TPVOA(0)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E18_TPVOA(1)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E16_RPVOA(0)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E16_RPVOA(1)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E12_WHTR),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E9_RFPD),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E19_TOND),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E26_TONF(0)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E26_TONF(1)),
-	AD70081Z_DAC_CH("vdac16_", AD70081Z_E22_FSOPD),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E4_MIR(0), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E4_MIR(1), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(0), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(1), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(2), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(3), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(4), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(5), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(6), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E6_PHTR(7), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E5_SPH, ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E17_SPVOA(0), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E17_SPVOA(1), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E17_SPVOA(2), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E17_SPVOA(3), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E18_TPVOA(0), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E18_TPVOA(1), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E16_RPVOA(0), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E16_RPVOA(1), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E12_WHTR, ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E9_RFPD, ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E19_TOND, ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E26_TONF(0), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E26_TONF(1), ad70081z_vdac16_scan_type),
+	AD70081Z_DAC_CH("vdac16_", AD70081Z_E22_FSOPD, ad70081z_vdac16_scan_type),
 
 	/* 12-bit DAC Voltage Channels (Count= 2) */
-	AD70081Z_DAC_CH("vdac12_", AD70081Z_E8_MZDB),
-	AD70081Z_DAC_CH("vdac12_", AD70081Z_E0_TECC),
+	AD70081Z_DAC_CH("vdac12_", AD70081Z_E8_MZDB, ad70081z_vdac12_scan_type),
+	AD70081Z_DAC_CH("vdac12_", AD70081Z_E0_TECC, ad70081z_vdac12_scan_type),
 };
 
 /* IIOD channels configurations */
@@ -1115,7 +1863,7 @@ static int32_t iio_ad70081z_init(struct iio_device **desc,
 {
 	struct iio_device *iio_ad70081z_inst;
 
-	iio_ad70081z_inst = calloc(1, sizeof(struct iio_device));
+	iio_ad70081z_inst = desc_pool_alloc(&iio_dev_pool);
 	if (!iio_ad70081z_inst) {
 		return FAILURE;
 	}
@@ -1128,10 +1876,10 @@ static int32_t iio_ad70081z_init(struct iio_device **desc,
 		iio_ad70081z_inst->attributes = dac_global_attributes;
 		iio_ad70081z_inst->debug_attributes = debug_attributes;
 
-		iio_ad70081z_inst->prepare_transfer = NULL;
-		iio_ad70081z_inst->end_transfer = NULL;
+		iio_ad70081z_inst->prepare_transfer = iio_ad77081z_prepare_dac_transfer;
+		iio_ad70081z_inst->end_transfer = iio_ad77081z_end_dac_transfer;
 		iio_ad70081z_inst->read_dev = NULL;
-		iio_ad70081z_inst->write_dev = NULL;
+		iio_ad70081z_inst->write_dev = iio_ad77081z_write_data;
 		iio_ad70081z_inst->debug_reg_read = debug_reg_read;
 		iio_ad70081z_inst->debug_reg_write = debug_reg_write;
 		break;
@@ -1152,6 +1900,7 @@ static int32_t iio_ad70081z_init(struct iio_device **desc,
 		break;
 
 	default:
+		desc_pool_free(&iio_dev_pool, iio_ad70081z_inst);
 		return FAILURE;
 	}
 
@@ -1197,11 +1946,17 @@ int32_t ad70081z_iio_initialize(void)
 	/* IIO interface init parameters */
 	struct iio_init_param iio_init_params;
 
+	/* Single sample per raw read by default */
+	for (uint8_t chn = 0; chn < ADC_MUX_CHN_COUNT; chn++) {
+		raw_average_count[chn] = 1;
+	}
+
 	/* Init the system peripherals */
 	init_status = init_system();
 	if (init_status != SUCCESS) {
 		return init_status;
 	}
+	startup_begin_us = get_time_us();
 
 	/* Initialize AD70081z device and peripheral interface */
 	init_status = ad70081z_init(&p_ad70081z_dev_inst, &ad70081z_init_params);
@@ -1209,6 +1964,28 @@ int32_t ad70081z_iio_initialize(void)
 		return init_status;
 	}
 
+#if defined(ENABLE_CONFIG_STORE)
+	/* Apply the configuration saved in flash (if any, else the defaults
+	 * are kept) */
+	init_status = config_store_restore();
+#elif defined(CALIBRATE_SAMPLING_RATES)
+	init_status = -ENOENT;
+#endif
+
+#if defined(CALIBRATE_SAMPLING_RATES)
+	/* Measure the max sampling rates achievable on this hardware, unless
+	 * restored from the saved configuration */
+	if (init_status != SUCCESS) {
+		init_status = calibrate_sampling_rates();
+		if (init_status != SUCCESS) {
+			return init_status;
+		}
+	}
+#endif
+
+	/* Initialize the binary fast path command channel */
+	fast_cmd_init();
+
 	/* Initialize the IIO interface */
 	iio_init_params.phy_type = USE_UART;
 	iio_init_params.uart_desc = uart_desc;
@@ -1246,11 +2023,13 @@ int32_t ad70081z_iio_initialize(void)
 				   (char *)ad70081z_dev_name[1],
 				   p_ad70081z_dev_inst,
 				   NULL,
-				   NULL);
+				   &dac_data_buff);
 	if (init_status != SUCCESS) {
 		return iio_ad70081z_remove(p_ad70081z_iio_desc);
 	}
 
+	startup_init_us = get_time_us() - startup_begin_us;
+
 	return init_status;
 }
 
@@ -1263,6 +2042,17 @@ int32_t ad70081z_iio_initialize(void)
 void ad70081z_iio_event_handler(void)
 {
 	while (1) {
-		(void)iio_step(p_ad70081z_iio_desc);
+		/* Disable the IADC inputs left enabled by previous reads once idle */
+		(void)iadc_idle_check();
+
+		/* Serve the binary fast path frames and hand over the text IIO
+		 * commands to IIO interface */
+		if (fast_cmd_step()) {
+			(void)iio_step(p_ad70081z_iio_desc);
+
+			if (!startup_first_response_us) {
+				startup_first_response_us = get_time_us() - startup_begin_us;
+			}
+		}
 	}
 }
@@ -24,6 +24,9 @@
 /********************** Macros and Constants Definition ***********************/
 /******************************************************************************/
 
+/* Number of ADC IIO channels */
+#define ADC_CHN_COUNT		23
+
 /******************************************************************************/
 /********************** Public/Extern Declarations ****************************/
 /******************************************************************************/
@@ -0,0 +1,229 @@
+/***************************************************************************//**
+ *   @file    ad70081z_stream_frame.c
+ *   @brief   Framed (CRC protected) ADC data stream for AD70081z IIO application
+ *   @details This module captures the ADC data into frames carrying a sync
+ *            word, sequence number, channel mask and CRC32. The host decoder
+ *            detects corrupted and lost frames, resynchronises on the sync
+ *            word and continues with the next good frame, instead of silently
+ *            misaligning the channels of the raw stream
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include "ad70081z_stream_frame.h"
+#include "ad70081z_compress.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_iio.h"
+#include "app_config.h"
+#include "error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Frame header field offsets */
+#define STREAM_FRAME_SYNC_OFFSET		0
+#define STREAM_FRAME_SEQ_OFFSET			4
+#define STREAM_FRAME_PAYLOAD_OFFSET		6
+#define STREAM_FRAME_CHN_MASK_OFFSET	8
+#define STREAM_FRAME_SCANS_OFFSET		12
+#define STREAM_FRAME_FLAGS_OFFSET		13
+#define STREAM_FRAME_RESERVED_OFFSET	14
+#define STREAM_FRAME_SCAN_INDEX_OFFSET	16
+
+/* Round up the size to multiple of 4 bytes (CRC32 word) */
+#define STREAM_FRAME_ALIGN(x)			(((x) + 3) & ~3ul)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Framed stream mode status */
+static bool stream_framing_enabled;
+
+/* Sequence number of next frame */
+static uint16_t stream_frame_seq;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Put the 16-bit little endian field into frame
+ * @param	buf[out] - Pointer to field
+ * @param	val[in] - Field value
+ * @return	none
+ */
+static void put_le16(uint8_t *buf, uint16_t val)
+{
+	buf[0] = (uint8_t)val;
+	buf[1] = (uint8_t)(val >> 8);
+}
+
+/*!
+ * @brief	Put the 32-bit little endian field into frame
+ * @param	buf[out] - Pointer to field
+ * @param	val[in] - Field value
+ * @return	none
+ */
+static void put_le32(uint8_t *buf, uint32_t val)
+{
+	buf[0] = (uint8_t)val;
+	buf[1] = (uint8_t)(val >> 8);
+	buf[2] = (uint8_t)(val >> 16);
+	buf[3] = (uint8_t)(val >> 24);
+}
+
+/*!
+ * @brief	Enable/Disable the framed stream mode of ADC IIO buffer
+ * @param	enable[in] - true to send the captured data in frames, else false
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t set_stream_framing(bool enable)
+{
+	if (enable && !stream_framing_enabled)
+		stream_frame_seq = 0;
+
+	stream_framing_enabled = enable;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Get the framed stream mode status of ADC IIO buffer
+ * @return	true if framed stream mode is enabled, else false
+ */
+bool is_stream_framing_enabled(void)
+{
+	return stream_framing_enabled;
+}
+
+/*!
+ * @brief	Capture the data into a frame
+ * @param	frame[out] - Frame output
+ * @param	space[in] - Space available for frame (in bytes)
+ * @param	frame_bytes[out] - Size of frame
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	-ENOMEM is returned if no more frame fits into the space
+ */
+static int32_t capture_frame(uint8_t *frame, uint32_t space,
+			     uint32_t *frame_bytes)
+{
+	uint8_t num_of_chns = get_num_of_active_channels();
+	uint8_t *payload = frame + STREAM_FRAME_HEADER_SIZE;
+	uint32_t payload_space;
+	uint32_t payload_bytes;
+	uint32_t raw_bytes;
+	uint32_t num_of_scans;
+	uint32_t padded_bytes;
+	uint32_t scan_index;
+	uint8_t flags = 0;
+	int32_t ret;
+
+	if (!num_of_chns)
+		return -EINVAL;
+
+	if (space <= STREAM_FRAME_HEADER_SIZE + STREAM_FRAME_CRC_SIZE)
+		return -ENOMEM;
+
+	payload_space = (space - STREAM_FRAME_HEADER_SIZE - STREAM_FRAME_CRC_SIZE)
+			& ~3ul;
+
+	if (is_stream_compression_enabled()) {
+		ret = capture_compressed_block(payload, payload_space,
+					       &payload_bytes, &raw_bytes, &scan_index);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		/* Scans count from header of compressed block */
+		num_of_scans = payload[2];
+		flags = STREAM_FRAME_FLAG_COMPRESSED;
+	} else {
+		num_of_scans = payload_space / (num_of_chns * sizeof(uint16_t));
+		if (!num_of_scans)
+			return -ENOMEM;
+
+		if (num_of_scans > STREAM_FRAME_SCANS)
+			num_of_scans = STREAM_FRAME_SCANS;
+
+		/* Next frame is captured (by ISR) while this frame is sent */
+		ret = read_stream_data((uint16_t *)payload, num_of_scans, &scan_index);
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		payload_bytes = num_of_scans * num_of_chns * sizeof(uint16_t);
+	}
+
+	padded_bytes = STREAM_FRAME_ALIGN(payload_bytes);
+	memset(payload + payload_bytes, 0, padded_bytes - payload_bytes);
+
+	put_le32(&frame[STREAM_FRAME_SYNC_OFFSET], STREAM_FRAME_SYNC);
+	put_le16(&frame[STREAM_FRAME_SEQ_OFFSET], stream_frame_seq++);
+	put_le16(&frame[STREAM_FRAME_PAYLOAD_OFFSET], (uint16_t)payload_bytes);
+	put_le32(&frame[STREAM_FRAME_CHN_MASK_OFFSET], get_active_channel_mask());
+	frame[STREAM_FRAME_SCANS_OFFSET] = (uint8_t)num_of_scans;
+	frame[STREAM_FRAME_FLAGS_OFFSET] = flags;
+	put_le16(&frame[STREAM_FRAME_RESERVED_OFFSET], 0);
+	put_le32(&frame[STREAM_FRAME_SCAN_INDEX_OFFSET], scan_index);
+
+	put_le32(payload + padded_bytes,
+		 stream_crc32(frame, STREAM_FRAME_HEADER_SIZE + padded_bytes));
+
+	*frame_bytes = STREAM_FRAME_HEADER_SIZE + padded_bytes + STREAM_FRAME_CRC_SIZE;
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Capture the data and read the frames into buffer
+ * @param	pbuf[out] - Pointer to ADC data buffer
+ * @param	nb_of_samples[in] - Number of samples (scans) requested by IIO client
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @details	Frames are captured until the buffer size of the requested
+ *			samples is filled, the rest of buffer is zero padded
+ */
+int32_t read_framed_data(void *pbuf, uint32_t nb_of_samples)
+{
+	uint8_t *pout = pbuf;
+	uint32_t remaining;
+	uint32_t frame_bytes;
+	int32_t ret;
+
+	if (!pbuf)
+		return -EINVAL;
+
+	remaining = nb_of_samples * get_num_of_active_channels() * sizeof(uint16_t);
+
+	while (remaining > STREAM_FRAME_HEADER_SIZE + STREAM_FRAME_CRC_SIZE) {
+		ret = capture_frame(pout, remaining, &frame_bytes);
+		if (ret == -ENOMEM)
+			break;
+
+		if (IS_ERR_VALUE(ret))
+			return ret;
+
+		pout += frame_bytes;
+		remaining -= frame_bytes;
+	}
+
+	memset(pout, 0, remaining);
+
+	return SUCCESS;
+}
@@ -0,0 +1,62 @@
+/***************************************************************************//**
+ *   @file   ad70081z_stream_frame.h
+ *   @brief  Header for AD70081z framed (CRC protected) ADC data stream
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_STREAM_FRAME_H_
+#define _AD70081Z_STREAM_FRAME_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/*
+ * Framed stream format (must match host side decoder):
+ * The IIO buffer holds a sequence of frames, followed by zero padding up to
+ * the end of buffer. All fields are little endian. Every frame is:
+ *   sync(4) | seq(2) | payload_bytes(2) | chn_mask(4) | num_of_scans(1) |
+ *   flags(1) | reserved(2) | scan_index(4) | payload | zero padding | crc32(4)
+ * 'seq' increments by one for every frame sent (wraps at 2^16), so that host
+ * can detect the lost frames. 'chn_mask' is the IIO buffer channel mask.
+ * 'scan_index' is the index of the first scan of frame, counted since the
+ * capture start (IIO buffer enable) including the scans lost in between
+ * frames, so that host can detect the gaps in the captured data. Frames
+ * are captured back to back, so the data of consecutive frames is
+ * continuous (scan_index follows on) unless the link falls behind.
+ * Payload holds the 16-bit samples as captured (interleaved channels) or, if
+ * STREAM_FRAME_FLAG_COMPRESSED is set, a single compressed block (refer
+ * ad70081z_compress.h). Payload is zero padded to multiple of 4 bytes.
+ * 'crc32' covers the frame from sync to the padding, as 32-bit little endian
+ * words fed MSB first (poly 0x04C11DB7, seed 0xFFFFFFFF, no final xor).
+ */
+#define STREAM_FRAME_SYNC				0xF5A5AD70
+#define STREAM_FRAME_HEADER_SIZE		20
+#define STREAM_FRAME_CRC_SIZE			4
+#define STREAM_FRAME_FLAG_COMPRESSED	0x01
+
+/* Max number of scans (samples per channel) in a frame */
+#define STREAM_FRAME_SCANS				32
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+int32_t set_stream_framing(bool enable);
+bool is_stream_framing_enabled(void);
+int32_t read_framed_data(void *pbuf, uint32_t nb_of_samples);
+
+#endif /* _AD70081Z_STREAM_FRAME_H_ */
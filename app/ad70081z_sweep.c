@@ -0,0 +1,356 @@
+/***************************************************************************//**
+ *   @file    ad70081z_sweep.c
+ *   @brief   DAC sweep / ADC capture measurement engine for AD70081z IIO app
+ *   @details This module steps the selected DAC channels through a range of
+ *            codes and, at every sweep point, captures (averaged) samples of
+ *            the active ADC channels after a settling delay. The result table
+ *            is delivered to IIO client through the ADC IIO buffer
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "ad70081z_sweep.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_dac_playback.h"
+#include "ad70081z_dac_waveform.h"
+#include "ad70081z_iio.h"
+#include "app_config.h"
+#include "error.h"
+#include "util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Max number of ADC channels captured per sweep point */
+#define MAX_SWEEP_ADC_CHANNELS		(32)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Sweep parameters of all DAC channels */
+static struct sweep_dac_config sweep_dac_config[AD70081Z_VDAC_CH_LIMIT];
+
+/* Settling delay after every DAC sweep step */
+static uint32_t sweep_settle_time_us;
+
+/* Number of ADC samples averaged per channel at every sweep point */
+static uint16_t sweep_average_count = 1;
+
+/* Sweep mode status (ADC IIO buffer delivers the sweep result table) */
+static bool sweep_enabled;
+
+/* Flag to indicate sweep capture is in progress (between prepare and end) */
+static bool sweep_in_progress;
+
+/* Active ADC channels (in the order of samples in a result table row) */
+static uint8_t sweep_adc_chn[MAX_SWEEP_ADC_CHANNELS];
+static uint8_t num_of_sweep_adc_chns;
+
+/* Next sweep point to be captured */
+static uint32_t sweep_point_indx;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Get the number of sweep points of a DAC channel
+ * @param	config[in] - Sweep parameters of DAC channel
+ * @return	Number of points (0 if channel is not swept)
+ * @note	Last point is clamped to stop code, if range is not a multiple of step
+ */
+static uint32_t get_dac_sweep_points(const struct sweep_dac_config *config)
+{
+	uint32_t range;
+
+	if (!config->step)
+		return 0;
+
+	if (config->stop >= config->start)
+		range = config->stop - config->start;
+	else
+		range = config->start - config->stop;
+
+	return ((range + config->step - 1) / config->step) + 1;
+}
+
+/*!
+ * @brief	Get the DAC code of a sweep point
+ * @param	config[in] - Sweep parameters of DAC channel
+ * @param	point[in] - Sweep point index
+ * @return	DAC code (held at stop code beyond the last point of channel)
+ */
+static uint16_t get_dac_sweep_code(const struct sweep_dac_config *config,
+				   uint32_t point)
+{
+	uint32_t delta = point * config->step;
+
+	if (config->stop >= config->start) {
+		if (delta >= (uint32_t)(config->stop - config->start))
+			return config->stop;
+
+		return config->start + delta;
+	}
+
+	if (delta >= (uint32_t)(config->start - config->stop))
+		return config->stop;
+
+	return config->start - delta;
+}
+
+/*!
+ * @brief	Get the sweep parameters of DAC channel
+ * @param	chn[in] - DAC channel number
+ * @param	config[out] - Sweep parameters
+ * @return	none
+ */
+void get_sweep_dac_config(uint8_t chn, struct sweep_dac_config *config)
+{
+	if (chn >= AD70081Z_VDAC_CH_LIMIT || !config)
+		return;
+
+	*config = sweep_dac_config[chn];
+}
+
+/*!
+ * @brief	Set the sweep parameters of DAC channel
+ * @param	chn[in] - DAC channel number
+ * @param	config[in] - Sweep parameters (step = 0 excludes channel from sweep)
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t set_sweep_dac_config(uint8_t chn, const struct sweep_dac_config *config)
+{
+	if (chn >= AD70081Z_VDAC_CH_LIMIT || !config)
+		return -EINVAL;
+
+	if (config->start > get_dac_max_code(chn) || config->stop > get_dac_max_code(chn))
+		return -EINVAL;
+
+	if (sweep_in_progress)
+		return -EBUSY;
+
+	sweep_dac_config[chn] = *config;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Set the settling delay after every DAC sweep step
+ * @param	settle_time_us[in] - Settling delay in usec
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t set_sweep_settle_time(uint32_t settle_time_us)
+{
+	if (settle_time_us > MAX_SWEEP_SETTLE_TIME_US)
+		return -EINVAL;
+
+	sweep_settle_time_us = settle_time_us;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Get the settling delay after every DAC sweep step
+ * @return	Settling delay in usec
+ */
+uint32_t get_sweep_settle_time(void)
+{
+	return sweep_settle_time_us;
+}
+
+/*!
+ * @brief	Set the number of ADC samples averaged at every sweep point
+ * @param	count[in] - Number of samples to average
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t set_sweep_average_count(uint16_t count)
+{
+	if (!count || count > MAX_RAW_AVERAGE_COUNT)
+		return -EINVAL;
+
+	sweep_average_count = count;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Get the number of ADC samples averaged at every sweep point
+ * @return	Number of samples averaged
+ */
+uint16_t get_sweep_average_count(void)
+{
+	return sweep_average_count;
+}
+
+/*!
+ * @brief	Enable/Disable the sweep mode of ADC IIO buffer
+ * @param	enable[in] - true to deliver sweep results, false for data capture
+ * @return	SUCCESS in case of success, negative error code otherwise
+ */
+int32_t set_sweep_enable(bool enable)
+{
+	if (sweep_in_progress)
+		return -EBUSY;
+
+	sweep_enabled = enable;
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Get the sweep mode status of ADC IIO buffer
+ * @return	true if sweep mode is enabled, else false
+ */
+bool is_sweep_enabled(void)
+{
+	return sweep_enabled;
+}
+
+/*!
+ * @brief	Get the sweep status
+ * @return	true if a sweep is prepared (or running), else false
+ */
+bool is_sweep_in_progress(void)
+{
+	return sweep_in_progress;
+}
+
+/*!
+ * @brief	Get the number of points in a complete sweep
+ * @return	Number of sweep points (longest range of all swept DAC channels)
+ */
+uint32_t get_sweep_num_of_points(void)
+{
+	uint32_t points = 0;
+	uint32_t chn_points;
+
+	for (uint8_t chn = 0; chn < AD70081Z_VDAC_CH_LIMIT; chn++) {
+		chn_points = get_dac_sweep_points(&sweep_dac_config[chn]);
+		if (chn_points > points)
+			points = chn_points;
+	}
+
+	return points;
+}
+
+/*!
+ * @brief	Prepare the sweep for new buffer read request of IIO client
+ * @param	ch_mask[in] - ADC channels to capture at every sweep point
+ * @param	num_of_chns[in] - ADC channel count
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Channel mask bit 0 corresponds to the first valid ADC mux channel,
+ *			same as for the data capture
+ */
+int32_t prepare_sweep(uint32_t ch_mask, uint8_t num_of_chns)
+{
+	if (is_dac_waveform_running())
+		return -EBUSY;
+
+	if (!get_sweep_num_of_points())
+		return -EINVAL;
+
+	num_of_sweep_adc_chns = 0;
+	for (uint8_t chn = AD70081Z_E1_CTHRM_VS; chn <= num_of_chns; chn++) {
+		if ((ch_mask & BIT(chn - AD70081Z_E1_CTHRM_VS))
+		    && num_of_sweep_adc_chns < MAX_SWEEP_ADC_CHANNELS) {
+			sweep_adc_chn[num_of_sweep_adc_chns++] = chn;
+		}
+	}
+
+	if (!num_of_sweep_adc_chns)
+		return -EINVAL;
+
+	sweep_point_indx = 0;
+	sweep_in_progress = true;
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Wait for the DAC outputs to settle
+ * @return	none
+ */
+static void sweep_settle_delay(void)
+{
+	delay_until_us(get_time_us() + sweep_settle_time_us);
+}
+
+/*!
+ * @brief	Run the sweep and read the result table into buffer
+ * @param	pbuf[out] - Pointer to ADC data buffer
+ * @param	nb_of_samples[in] - Number of samples (sweep points) to read
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @details	Every sample (row) of the table holds the averaged 16-bit result
+ *			of all active ADC channels for one sweep point. The sweep restarts
+ *			from the first point once all points are captured, so reading
+ *			'sweep_points' samples per buffer read delivers one complete sweep
+ */
+int32_t read_sweep_data(void *pbuf, uint32_t nb_of_samples)
+{
+	int32_t ret;
+	uint16_t *pdata = pbuf;
+	uint32_t num_of_points = get_sweep_num_of_points();
+	uint32_t mean;
+	uint16_t code;
+
+	if (!pbuf || !sweep_in_progress)
+		return -EINVAL;
+
+	for (uint32_t sample = 0; sample < nb_of_samples; sample++) {
+		/* Step all the swept DAC channels to the next point */
+		for (uint8_t chn = 0; chn < AD70081Z_VDAC_CH_LIMIT; chn++) {
+			if (!sweep_dac_config[chn].step)
+				continue;
+
+			code = get_dac_sweep_code(&sweep_dac_config[chn], sweep_point_indx);
+			ret = ad70081z_set_dac_value(p_ad70081z_dev_inst, code,
+						     (enum ad70081z_channel)chn);
+			if (IS_ERR_VALUE(ret))
+				return ret;
+		}
+
+		sweep_settle_delay();
+
+		for (uint8_t chn = 0; chn < num_of_sweep_adc_chns; chn++) {
+			ret = read_averaged_sample(sweep_adc_chn[chn], sweep_average_count,
+						   &mean, NULL);
+			if (IS_ERR_VALUE(ret))
+				return ret;
+
+			*pdata++ = (uint16_t)mean;
+		}
+
+		if (++sweep_point_indx >= num_of_points)
+			sweep_point_indx = 0;
+	}
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	End the sweep capture
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	DAC outputs hold the codes of the last captured sweep point
+ */
+int32_t end_sweep(void)
+{
+	sweep_in_progress = false;
+	num_of_sweep_adc_chns = 0;
+
+	return SUCCESS;
+}
@@ -0,0 +1,55 @@
+/***************************************************************************//**
+ *   @file   ad70081z_sweep.h
+ *   @brief  Header for AD70081z DAC sweep / ADC capture measurement engine
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_SWEEP_H_
+#define _AD70081Z_SWEEP_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Max settling delay (in usec) after every DAC sweep step */
+#define MAX_SWEEP_SETTLE_TIME_US	(1000000)
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/* Sweep parameters of a DAC channel (channel is swept when step is non-zero) */
+struct sweep_dac_config {
+	uint16_t start;		// First code of sweep
+	uint16_t stop;		// Last code of sweep (may be lower than start)
+	uint16_t step;		// Code increment per sweep point
+};
+
+void get_sweep_dac_config(uint8_t chn, struct sweep_dac_config *config);
+int32_t set_sweep_dac_config(uint8_t chn, const struct sweep_dac_config *config);
+int32_t set_sweep_settle_time(uint32_t settle_time_us);
+uint32_t get_sweep_settle_time(void);
+int32_t set_sweep_average_count(uint16_t count);
+uint16_t get_sweep_average_count(void);
+int32_t set_sweep_enable(bool enable);
+bool is_sweep_enabled(void);
+bool is_sweep_in_progress(void);
+uint32_t get_sweep_num_of_points(void);
+int32_t prepare_sweep(uint32_t ch_mask, uint8_t num_of_chns);
+int32_t read_sweep_data(void *pbuf, uint32_t nb_of_samples);
+int32_t end_sweep(void);
+
+#endif /* _AD70081Z_SWEEP_H_ */
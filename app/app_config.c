@@ -16,19 +16,33 @@
 /******************************************************************************/
 
 #include <stdbool.h>
+#include <stdio.h>
 
 #include "app_config.h"
 #include "ad70081z_data_capture.h"
+#include "ad70081z_dac_playback.h"
 #include "uart.h"
 #include "error.h"
 #include "irq.h"
 #include "gpio.h"
 #include "pwm.h"
+#include "app_profile.h"
 
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
 /******************************************************************************/
 
+#if defined(UART_THROUGHPUT_BENCHMARK)
+/* Total number of bytes sent for UART throughput benchmark */
+#define UART_BENCHMARK_BYTES		(65536)
+
+/* Size of every UART write during benchmark (same as IIOD buffer size) */
+#define UART_BENCHMARK_BLOCK_SIZE	(4096)
+
+/* Number of bits on UART line per data byte (8-N-1 framing) */
+#define UART_BITS_PER_BYTE			(10)
+#endif
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
@@ -53,6 +67,19 @@ static struct callback_desc ext_int_callback_desc = {
 	NULL
 };
 
+/* Ticker interrupt init parameters */
+static struct irq_init_param ticker_int_init_params = {
+	.irq_ctrl_id = TICKER_INT_ID,
+	.extra = &ticker_int_extra_init_params
+};
+
+/* Ticker interrupt callback descriptor */
+static struct callback_desc ticker_int_callback_desc = {
+	dac_playback_callback,
+	NULL,
+	NULL
+};
+
 /* BUSY GPIO init parameters */
 static struct gpio_init_param busy_gpio_init_params = {
 	.number = BUSY_GPIO,
@@ -87,6 +114,9 @@ struct gpio_desc *conv_int_gpio_desc;
 /* PWM descriptor */
 struct pwm_desc *pwm_desc;
 
+/* Ticker interrupt descriptor */
+struct irq_ctrl_desc *ticker_int_desc;
+
 /******************************************************************************/
 /************************** Functions Declarations ****************************/
 /******************************************************************************/
@@ -135,6 +165,50 @@ static int32_t init_uart(void)
 	return uart_init(&uart_desc, &uart_init_params);
 }
 
+#if defined(UART_THROUGHPUT_BENCHMARK)
+/**
+ * @brief 	Measure the UART transmit throughput
+ * @return	none
+ * @details	Test pattern is sent in IIOD buffer sized writes and the achieved
+ *			throughput is reported against the line rate. Rebuild with other
+ *			IIO_UART_BAUD_RATE to benchmark the higher baud rates
+ */
+static void uart_throughput_benchmark(void)
+{
+	static uint8_t block[UART_BENCHMARK_BLOCK_SIZE];
+	char report[120];
+	uint32_t start_time_ms;
+	uint32_t elapsed_ms;
+	uint32_t sent_bytes;
+	int len;
+
+	/* Printable pattern, so that benchmark can be run from a terminal */
+	for (uint32_t i = 0; i < sizeof(block); i++) {
+		block[i] = 'A' + (i % 26);
+	}
+
+	start_time_ms = get_time_ms();
+	for (sent_bytes = 0; sent_bytes < UART_BENCHMARK_BYTES;
+	     sent_bytes += sizeof(block)) {
+		uart_write(uart_desc, block, sizeof(block));
+	}
+	elapsed_ms = get_time_ms() - start_time_ms;
+
+	if (!elapsed_ms) {
+		elapsed_ms = 1;
+	}
+
+	len = snprintf(report, sizeof(report),
+		       "\r\nUART benchmark: %lu bytes in %lu ms, %lu B/s (line rate %lu B/s)\r\n",
+		       (unsigned long)sent_bytes, (unsigned long)elapsed_ms,
+		       (unsigned long)(((uint64_t)sent_bytes * 1000) / elapsed_ms),
+		       (unsigned long)(IIO_UART_BAUD_RATE / UART_BITS_PER_BYTE));
+	if (len > 0) {
+		uart_write(uart_desc, (uint8_t *)report, len);
+	}
+}
+#endif
+
 /**
  * @brief 	Initialize the IRQ contoller
  * @return	none
@@ -156,6 +230,14 @@ static int32_t init_interrupts(void)
 		return FAILURE;
 	}
 
+#if (ACTIVE_PLATFORM == ADUCM410_PLATFORM) && !defined(USE_IRQ_CALLBACK_CONV_ISR)
+	/* Serve the conversion interrupt straight from the interrupt vector */
+	if (aducm410_irq_register_fast_handler(EXTERNAL_INT_ID,
+					       data_capture_isr) != SUCCESS) {
+		return FAILURE;
+	}
+#endif
+
 	/* Enable external interrupt */
 	if (irq_enable(ext_int_desc, EXTERNAL_INT_ID) != SUCCESS) {
 		return FAILURE;
@@ -164,6 +246,29 @@ static int32_t init_interrupts(void)
 	return SUCCESS;
 }
 
+/**
+ * @brief 	Initialize the ticker (periodic timer) interrupt
+ * @return	SUCCESS in case of success, FAILURE otherwise
+ * @details	The ticker is used to pace DAC buffer playback and is enabled only
+ *			while the playback is in progress
+ */
+static int32_t init_ticker(void)
+{
+	/* Initialize the IRQ controller for ticker interrupt */
+	if (irq_ctrl_init(&ticker_int_desc, &ticker_int_init_params) != SUCCESS) {
+		return FAILURE;
+	}
+
+	/* Register a callback function for ticker interrupt */
+	if (irq_register_callback(ticker_int_desc,
+				  TICKER_INT_ID,
+				  &ticker_int_callback_desc) != SUCCESS) {
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
 /**
  * @brief 	Initialize the PWM contoller
  * @return	SUCCESS in case of success, FAILURE otherwise
@@ -187,6 +292,31 @@ static int32_t init_pwm(void)
 	return FAILURE;
 }
 
+/**
+ * @brief 	Check if the deadline on monotonic time base is reached
+ * @param	deadline_us[in] - Deadline in usec (as per get_time_us())
+ * @return	true if deadline is reached, else false
+ * @note	Deadline must be within 2^31 usec (~35 min) of current time
+ */
+bool time_us_reached(uint32_t deadline_us)
+{
+	return (int32_t)(get_time_us() - deadline_us) >= 0;
+}
+
+/**
+ * @brief 	Wait until the deadline on monotonic time base is reached
+ * @param	deadline_us[in] - Deadline in usec (as per get_time_us())
+ * @return	none
+ * @note	Returns immediately if deadline is already passed. Waiting for
+ *			absolute deadlines (instead of relative delays) keeps periodic
+ *			events paced regardless of the work done between them
+ */
+void delay_until_us(uint32_t deadline_us)
+{
+	while (!time_us_reached(deadline_us)) {
+	}
+}
+
 /**
  * @brief 	Initialize the system peripherals
  * @return	SUCCESS in case of success, FAILURE otherwise
@@ -199,15 +329,33 @@ int32_t init_system(void)
 	}
 #endif
 
+#if defined(PROFILE_TIMESTAMP)
+	profile_init();
+#endif
+
 	if (init_uart() != SUCCESS) {
 		return FAILURE;
 	}
 
+#if defined(UART_THROUGHPUT_BENCHMARK)
+	uart_throughput_benchmark();
+#endif
+
 	if (init_gpio() != SUCCESS) {
 		return FAILURE;
 	}
 
-#if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
+	if (init_ticker() != SUCCESS) {
+		return FAILURE;
+	}
+
+#if defined(USE_PLA_CONV_TRIGGER)
+	/* CONVST pulse train and conversion interrupt are generated by PLA */
+	if (aducm410_pla_trigger_init(CONV_TRIGGER_PERIOD_NSEC,
+				      data_capture_isr) != SUCCESS) {
+		return FAILURE;
+	}
+#elif (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 	if (init_interrupts() != SUCCESS) {
 		return FAILURE;
 	}
@@ -18,6 +18,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -47,6 +48,7 @@
 #define uart_extra_init_params mbed_uart_extra_init_params
 #define spi_extra_init_params mbed_spi_extra_init_params
 #define ext_int_extra_init_params mbed_ext_int_extra_init_params
+#define ticker_int_extra_init_params mbed_ticker_int_extra_init_params
 #define pwm_extra_init_params mbed_pwm_extra_init_params
 #define ldac_gpio_extra_init_params mbed_ldac_gpio_extra_init_params
 #define reset_gpio_extra_init_params mbed_reset_gpio_extra_init_params
@@ -54,12 +56,19 @@
 #define convst_gpio_extra_init_params mbed_convst_gpio_extra_init_params
 #define busy_gpio_extra_init_params mbed_busy_gpio_extra_init_params
 #define conv_int_gpio_extra_init_params mbed_conv_int_gpio_extra_init_params
+#define get_time_ms mbed_get_time_ms
+#define get_time_us mbed_get_time_us
+#define uart_push_back mbed_uart_push_back
+#define set_ticker_period mbed_set_ticker_period
+#define stream_crc32 mbed_stream_crc32
+#define get_conv_trigger_cycles mbed_get_conv_trigger_cycles
 #define EXTERNAL_INT_ID EXTERNAL_INT_ID1
 #elif (ACTIVE_PLATFORM == ADUCM410_PLATFORM)
 #include "app_config_aducm410.h"
 #define uart_extra_init_params aducm410_uart_extra_init_params
 #define spi_extra_init_params aducm410_spi_extra_init_params
 #define ext_int_extra_init_params aducm410_ext_int_extra_init_params
+#define ticker_int_extra_init_params aducm410_ticker_int_extra_init_params
 #define pwm_extra_init_params aducm410_pwm_extra_init_params
 #define ldac_gpio_extra_init_params aducm410_ldac_gpio_extra_init_params
 #define reset_gpio_extra_init_params aducm410_reset_gpio_extra_init_params
@@ -67,6 +76,12 @@
 #define convst_gpio_extra_init_params aducm410_convst_gpio_extra_init_params
 #define busy_gpio_extra_init_params aducm410_busy_gpio_extra_init_params
 #define conv_int_gpio_extra_init_params aducm410_conv_int_gpio_extra_init_params
+#define get_time_ms aducm410_get_time_ms
+#define get_time_us aducm410_get_time_us
+#define uart_push_back aducm410_uart_push_back
+#define set_ticker_period aducm410_set_ticker_period
+#define stream_crc32 aducm410_stream_crc32
+#define get_conv_trigger_cycles aducm410_get_conv_trigger_cycles
 #define EXTERNAL_INT_ID EXTERNAL_INT_ID6 // EXINT5
 #else
 #error "No/Invalid active platform selected"
@@ -76,7 +91,27 @@
 #define IIO_DEVICE_NAME		"ad70081z"
 
 /* Baud rate for IIO application UART interface */
+#if !defined(IIO_UART_BAUD_RATE)
 #define IIO_UART_BAUD_RATE	(230400)
+#endif
+
+/* Enable to measure the UART transmit throughput at startup. The report is sent
+ * over the IIO UART link before IIO interface is started (benchmark build only) */
+//#define UART_THROUGHPUT_BENCHMARK
+
+/* Enable for production startup. The device init progress messages are not
+ * printed on the IIO UART link (each costs milliseconds at the IIO baud rate).
+ * The startup time is read through 'startup_time' IIO debug attribute */
+//#define PRODUCTION_STARTUP
+
+#if defined(PRODUCTION_STARTUP) && defined(UART_THROUGHPUT_BENCHMARK)
+#error "UART throughput benchmark is not allowed in production startup"
+#endif
+
+/* Enable to record the execution time of hot path functions (SPI transfers,
+ * data capture, UART writes, IIO attribute handlers). The statistics are read
+ * (and reset on write) through 'profile' IIO debug attribute */
+//#define ENABLE_PROFILING
 
 #if (ACTIVE_PLATFORM == MBED_PLATFORM)
 /* Enable the VirtualCOM port connection/interface. By default serial comminunication
@@ -96,9 +131,45 @@
 /* AD70081z OSR default value */
 #define DEFAULT_OSR		OSR0
 
+/* Idle period (in msec) after which IADC inputs enabled for single sample
+ * reads are disabled back. Value 0 disables the inputs right after each read */
+#define DEFAULT_IADC_IDLE_TIMEOUT_MS	(500)
+
+/* Default update (playback) rate in SPS for DAC output buffer */
+#define DEFAULT_DAC_UPDATE_RATE		(1000)
+
+/* Min possible DAC buffer playback (update) rate in SPS */
+#define MIN_DAC_UPDATE_RATE			(10)
+
 /* Select the ADC data capture mode (default is burst mode) */
 #define DATA_CAPTURE_MODE	BURST_DATA_CAPTURE
 
+/* Enable to generate the CONVST pulse train in CC mode from the PLA (clocked by
+ * a timer) on ADuCM410 platform, instead of the PWM to external interrupt
+ * wiring. Conversion timing is then jitter-free and independent of CPU load */
+//#define USE_PLA_CONV_TRIGGER
+
+#if defined(USE_PLA_CONV_TRIGGER) && \
+	((ACTIVE_PLATFORM != ADUCM410_PLATFORM) || \
+	 (DATA_CAPTURE_MODE != CONTINUOUS_DATA_CAPTURE))
+#error "PLA conversion trigger is supported only in CC mode on ADuCM410 platform"
+#endif
+
+/* Enable to record the conversion interrupt entry latency (in CC mode) into a
+ * histogram, read (and configured) through 'isr_latency' IIO debug attribute.
+ * Used to find the safe max sampling rates (SAMPLING_RATE_CC_x) of a platform */
+//#define ENABLE_ISR_LATENCY_HISTOGRAM
+
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM) && \
+	(DATA_CAPTURE_MODE != CONTINUOUS_DATA_CAPTURE)
+#error "ISR latency histogram is supported only in continuous data capture mode"
+#endif
+
+/* Enable to serve the conversion interrupt on ADuCM410 through the generic irq
+ * callback instead of the fast handler, so that the ISR entry latency of both
+ * dispatch paths can be compared (with the latency histogram) on one build */
+//#define USE_IRQ_CALLBACK_CONV_ISR
+
 #if (DATA_CAPTURE_MODE == CONTINUOUS_DATA_CAPTURE)
 #if (DEFAULT_OSR == OSR64)
 #define SAMPLING_RATE	SAMPLING_RATE_CC_OSR64
@@ -121,6 +192,23 @@
 #endif
 #endif
 
+/* Enable to calibrate the max sampling rates of all OSRs at startup, by timing
+ * the capture loop on the attached hardware. The measured rates (with margin)
+ * replace the SAMPLING_RATE_CC_x/SAMPLING_RATE_BURST_x defaults of the platform
+ * and the sampling rate is set to the max rate of the default OSR */
+//#define CALIBRATE_SAMPLING_RATES
+
+/* Enable to keep the operating point (DAC codes and masks, IADC rsense/range,
+ * OSR, sampling rate and calibrated max sampling rates) in a reserved flash
+ * region. It is saved/cleared through 'config_save' IIO attribute, restored
+ * through 'config_restore' IIO attribute and applied at startup (skipping the
+ * sampling rate calibration) */
+//#define ENABLE_CONFIG_STORE
+
+#if defined(ENABLE_CONFIG_STORE) && (ACTIVE_PLATFORM != ADUCM410_PLATFORM)
+#error "Configuration store is supported only on ADuCM410 platform"
+#endif
+
 /* PWM period and duty cycle calculations (cc mode) */
 #define CONV_TRIGGER_PERIOD_NSEC		(((float)(1.0 / SAMPLING_RATE) * 1000000) * 1000.0)
 #define CONV_TRIGGER_DUTY_CYCLE_NSEC	(CONV_TRIGGER_PERIOD_NSEC / 2)
@@ -135,7 +223,11 @@
 
 extern struct uart_desc *uart_desc;
 extern struct gpio_desc *busy_gpio_desc;
+extern struct pwm_desc *pwm_desc;
+extern struct irq_ctrl_desc *ticker_int_desc;
 
 int32_t init_system(void);
+bool time_us_reached(uint32_t deadline_us);
+void delay_until_us(uint32_t deadline_us);
 
 #endif	// APP_CONFIG_H
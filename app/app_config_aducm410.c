@@ -23,11 +23,13 @@
 #include "SpiLib.h"
 #include "IntLib.h"
 #include "WdtLib.h"
+#include "CrcLib.h"
 
 #include "app_config.h"
 #include "app_config_aducm410.h"
 #include "error.h"
 #include "gpio.h"
+#include "irq.h"
 
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
@@ -37,6 +39,19 @@
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
 
+/* System time in msec, incremented from SysTick interrupt */
+static volatile uint32_t sys_time_ms = 0;
+
+/* Setup of CRC accelerator for stream CRC32 (MSB first, seed all ones) */
+static const CRC_SETUP_t stream_crc_setup = {
+	.poly = CRC32_POLY,
+	.seed = 0xFFFFFFFF,
+	.LSB_First = 0,
+	.bitSwap = 0,
+	.byteSwap = 0,
+	.hwordSwap = 0
+};
+
 /* UART ADuCM410 platform specific init parameters */
 aducm410_uart_init_param aducm410_uart_extra_init_params  = {
 	.uart_tx_pin = UART_TX,
@@ -61,6 +76,12 @@ aducm410_irq_init_param aducm410_ext_int_extra_init_params = {
 	.int_mode = INT_FALL,
 };
 
+/* Define ticker interrupt platform specific parameters structure */
+aducm410_irq_init_param aducm410_ticker_int_extra_init_params = {
+	.int_mode = 0,
+	.ticker_period_usec = (1000000 / DEFAULT_DAC_UPDATE_RATE)
+};
+
 /* Define PWM platform specific parameters structure */
 aducm410_pwm_init_param aducm410_pwm_extra_init_params = {
 	.channel = PWM_CHN0,			// GPIO P1.2
@@ -320,6 +341,115 @@ int32_t init_pwm_gpios(void)
 	return SUCCESS;
 }
 
+/**
+ * @brief 	SysTick interrupt handler (1msec tick)
+ * @return	none
+ */
+void SysTick_Handler(void)
+{
+	sys_time_ms++;
+}
+
+/**
+ * @brief 	Get the free running system time
+ * @return	System time in msec (wraps around at 2^32 msec)
+ */
+uint32_t aducm410_get_time_ms(void)
+{
+	return sys_time_ms;
+}
+
+/**
+ * @brief 	Get the free running monotonic time
+ * @return	System time in usec (wraps around at 2^32 usec)
+ * @note	The msec count is extended with the elapsed core clock cycles of
+ *			current SysTick period. A SysTick reload not yet counted by the
+ *			SysTick interrupt (pending or masked) is accounted for, so that
+ *			time never goes backwards
+ */
+uint32_t aducm410_get_time_us(void)
+{
+	uint32_t time_ms;
+	uint32_t ticks;
+	bool tick_pending;
+
+	do {
+		time_ms = sys_time_ms;
+		ticks = SysTick->VAL;
+		tick_pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+	} while (time_ms != sys_time_ms);
+
+	if (tick_pending) {
+		/* Counter has reloaded, read the count of the new period */
+		ticks = SysTick->VAL;
+		time_ms++;
+	}
+
+	return (time_ms * 1000) +
+	       ((SysTick->LOAD - ticks) / (SystemCoreClock / 1000000));
+}
+
+/**
+ * @brief 	Set the ticker interrupt period
+ * @param	desc[in] - Ticker interrupt controller descriptor
+ * @param	period_usec[in] - Ticker period in usec
+ * @return	SUCCESS in case of success, FAILURE otherwise
+ * @note	New period is applied on next enable of ticker interrupt
+ */
+int32_t aducm410_set_ticker_period(struct irq_ctrl_desc *desc,
+				   uint32_t period_usec)
+{
+	if (!desc || !desc->extra || !period_usec) {
+		return FAILURE;
+	}
+
+	((aducm410_irq_desc *)desc->extra)->ticker_period_usec = period_usec;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief 	Get the conversion trigger period (CC mode)
+ * @return	Conversion trigger period in core clock cycles, as programmed into
+ *			the trigger timer
+ * @note	PWM0 period is (PWM0LEN + 1) cycles of the prescaled PWM_UCLK
+ */
+uint32_t aducm410_get_conv_trigger_cycles(void)
+{
+#if defined(USE_PLA_CONV_TRIGGER)
+	return aducm410_pla_trigger_get_cycles();
+#else
+	uint32_t pwm_clock_freq = aducm410_pwm_extra_init_params.pwm_clock_freq /
+				  (2 << aducm410_pwm_extra_init_params.clk_divider);
+
+	return (pADI_PWM->PWM0LEN + 1) * (SystemCoreClock / pwm_clock_freq);
+#endif
+}
+
+/**
+ * @brief 	Calculate the stream CRC32 using CRC accelerator
+ * @param	buf[in] - Data buffer
+ * @param	len[in] - Data length in bytes (multiple of 4)
+ * @return	CRC32 (poly 0x04C11DB7, seed 0xFFFFFFFF, MSB first, no final xor)
+ *			of the little endian 32-bit words of buffer
+ */
+uint32_t aducm410_stream_crc32(const uint8_t *buf, uint32_t len)
+{
+	uint32_t crc = stream_crc_setup.seed;
+
+	CrcSetup(&stream_crc_setup);
+	CrcEnable();
+
+	for (uint32_t indx = 0; indx + 4 <= len; indx += 4) {
+		crc = hw_crc32((uint32_t)buf[indx] | ((uint32_t)buf[indx + 1] << 8) |
+			       ((uint32_t)buf[indx + 2] << 16) | ((uint32_t)buf[indx + 3] << 24));
+	}
+
+	CrcDisable();
+
+	return crc;
+}
+
 /**
  * @brief 	Clear the ADuCM410 interrupts
  * @return	none
@@ -347,6 +477,12 @@ int32_t aducm410_system_init(void)
 
 	/* Initialize the system clock */
 	ClkSetup(&gClkSetup);
+	SystemCoreClockUpdate();
+
+	/* Generate 1msec system tick */
+	if (SysTick_Config(SystemCoreClock / 1000) != 0) {
+		return FAILURE;
+	}
 
 	/* Init external interrupt */
 	ExIntSetup(&gExIntSetup);
@@ -361,10 +497,12 @@ int32_t aducm410_system_init(void)
 		return FAILURE;
 	}
 
+#if !defined(USE_PLA_CONV_TRIGGER)
 	/* Init the PWM GPIOs */
 	if (init_pwm_gpios() != SUCCESS) {
 		return FAILURE;
 	}
+#endif
 
 	return SUCCESS;
 }
@@ -25,6 +25,8 @@
 #include "aducm410_gpio.h"
 #include "aducm410_irq.h"
 #include "aducm410_pwm.h"
+#include "aducm410_pla_trigger.h"
+#include "aducm410_flash_store.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definition ***********************/
@@ -100,6 +102,23 @@
 #define SAMPLING_RATE_BURST_OSR16	(58000)		// 58KSPS
 #define SAMPLING_RATE_BURST_OSR64	(16000)		// 16KSPS
 
+/* Min possible sampling rate in SPS (limited by 16-bit PWM period counter
+ * running @80Mhz PWM_UCLK in CC mode) */
+#define MIN_SAMPLING_RATE			(1250)
+
+/* Max possible DAC buffer playback (update) rate in SPS. Each update writes all
+ * active DAC channels over SPI from the ticker interrupt, followed by an LDAC */
+#define MAX_DAC_UPDATE_RATE			(10000)
+
+/* Number of descriptors in the static descriptor pools (refer desc_pool.h).
+ * GPIOs: UART Tx/Rx, SPI SCLK/MISO/MOSI/CS, PWM, BUSY, CONV_INT and the
+ * LDAC/RESET/TGP/CONVST device GPIOs. IRQs: external and ticker interrupts */
+#define GPIO_DESC_POOL_SIZE			13
+#define SPI_DESC_POOL_SIZE			1
+#define UART_DESC_POOL_SIZE			1
+#define IRQ_DESC_POOL_SIZE			2
+#define PWM_DESC_POOL_SIZE			1
+
 /******************************************************************************/
 /********************** Public/Extern Declarations ****************************/
 /******************************************************************************/
@@ -107,6 +126,7 @@
 extern aducm410_uart_init_param aducm410_uart_extra_init_params ;
 extern aducm410_spi_init_param aducm410_spi_extra_init_params ;
 extern aducm410_irq_init_param aducm410_ext_int_extra_init_params;
+extern aducm410_irq_init_param aducm410_ticker_int_extra_init_params;
 extern aducm410_pwm_init_param aducm410_pwm_extra_init_params ;
 extern aducm410_gpio_init_param aducm410_ldac_gpio_extra_init_params;
 extern aducm410_gpio_init_param aducm410_reset_gpio_extra_init_params;
@@ -117,5 +137,13 @@ extern aducm410_gpio_init_param aducm410_conv_int_gpio_extra_init_params ;
 
 int32_t aducm410_system_init(void);
 void aducm410_clear_interrupts(void);
+struct irq_ctrl_desc;
+
+uint32_t aducm410_get_time_ms(void);
+uint32_t aducm410_get_time_us(void);
+int32_t aducm410_set_ticker_period(struct irq_ctrl_desc *desc,
+				   uint32_t period_usec);
+uint32_t aducm410_get_conv_trigger_cycles(void);
+uint32_t aducm410_stream_crc32(const uint8_t *buf, uint32_t len);
 
 #endif /* APP_CONFIG_ADUCM410_H_ */
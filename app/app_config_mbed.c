@@ -15,17 +15,31 @@
 /******************************************************************************/
 
 #include <stdbool.h>
+#include "us_ticker_api.h"
+#include "cmsis.h"
+
 #include "app_config.h"
 #include "app_config_mbed.h"
+#include "irq.h"
+#include "pwm.h"
+#include "error.h"
 
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
 /******************************************************************************/
 
+/* Stream CRC32 polynomial and seed */
+#define STREAM_CRC32_POLYNOMIAL		0x04C11DB7
+#define STREAM_CRC32_SEED			0xFFFFFFFF
+
 /******************************************************************************/
 /******************** Variables and User Defined Data Types *******************/
 /******************************************************************************/
 
+/* Lookup table for stream CRC32 (MSB first, byte at a time) */
+static uint32_t stream_crc32_table[256];
+static bool stream_crc32_table_populated = false;
+
 /* UART Mbed platform specific init parameters */
 mbed_uart_init_param mbed_uart_extra_init_params = {
 #if defined(USE_VIRTUAL_COM_PORT)
@@ -55,6 +69,14 @@ mbed_irq_init_param mbed_ext_int_extra_init_params = {
 	.int_obj_type = NULL
 };
 
+/* Ticker interrupt Mbed platform specific parameters */
+mbed_irq_init_param mbed_ticker_int_extra_init_params = {
+	.int_mode = 0,
+	.ext_int_pin = 0,
+	.ticker_period_usec = (1000000 / DEFAULT_DAC_UPDATE_RATE),
+	.int_obj_type = NULL
+};
+
 /* PWM Mbed platform specific parameters */
 mbed_pwm_init_param mbed_pwm_extra_init_params = {
 	.pwm_pin = CONV_INT_GPIO	// Unused currently. PWM ID is used for seting GPIO
@@ -97,3 +119,89 @@ mbed_gpio_init_param mbed_conv_int_gpio_extra_init_params = {
 /******************************************************************************/
 /************************** Functions Definitions *****************************/
 /******************************************************************************/
+
+/**
+ * @brief 	Get the free running system time
+ * @return	System time in msec (wraps around at 2^32 msec)
+ */
+uint32_t mbed_get_time_ms(void)
+{
+	return (uint32_t)(ticker_read_us(get_us_ticker_data()) / 1000);
+}
+
+/**
+ * @brief 	Get the free running monotonic time
+ * @return	System time in usec (wraps around at 2^32 usec)
+ */
+uint32_t mbed_get_time_us(void)
+{
+	return (uint32_t)ticker_read_us(get_us_ticker_data());
+}
+
+/**
+ * @brief 	Set the ticker interrupt period
+ * @param	desc[in] - Ticker interrupt controller descriptor
+ * @param	period_usec[in] - Ticker period in usec
+ * @return	SUCCESS in case of success, FAILURE otherwise
+ * @note	New period is applied on next enable of ticker interrupt
+ */
+int32_t mbed_set_ticker_period(struct irq_ctrl_desc *desc, uint32_t period_usec)
+{
+	if (!desc || !desc->extra || !period_usec) {
+		return FAILURE;
+	}
+
+	((mbed_irq_desc *)desc->extra)->ticker_period_usec = period_usec;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief 	Get the conversion trigger period (CC mode)
+ * @return	Conversion trigger period in core clock cycles, as programmed into
+ *			the trigger PWM
+ * @note	The PWM period is programmed with usec resolution
+ */
+uint32_t mbed_get_conv_trigger_cycles(void)
+{
+	if (!pwm_desc) {
+		return 0;
+	}
+
+	return (pwm_desc->period_ns / 1000) * (SystemCoreClock / 1000000);
+}
+
+/**
+ * @brief 	Calculate the stream CRC32 (table driven)
+ * @param	buf[in] - Data buffer
+ * @param	len[in] - Data length in bytes (multiple of 4)
+ * @return	CRC32 (poly 0x04C11DB7, seed 0xFFFFFFFF, MSB first, no final xor)
+ *			of the little endian 32-bit words of buffer
+ * @note	Same as CRC accelerator of ADuCM410 fed with 32-bit words
+ */
+uint32_t mbed_stream_crc32(const uint8_t *buf, uint32_t len)
+{
+	uint32_t crc = STREAM_CRC32_SEED;
+	uint32_t val;
+
+	if (!stream_crc32_table_populated) {
+		for (uint32_t indx = 0; indx < 256; indx++) {
+			val = indx << 24;
+			for (uint8_t bit = 0; bit < 8; bit++) {
+				val = (val & 0x80000000) ? ((val << 1) ^ STREAM_CRC32_POLYNOMIAL) :
+				      (val << 1);
+			}
+			stream_crc32_table[indx] = val;
+		}
+		stream_crc32_table_populated = true;
+	}
+
+	/* Most significant byte of every little endian word goes first */
+	for (uint32_t indx = 0; indx + 4 <= len; indx += 4) {
+		for (int8_t byte = 3; byte >= 0; byte--) {
+			crc = (crc << 8) ^ stream_crc32_table[(crc >> 24) ^ buf[indx + byte]];
+		}
+	}
+
+	return crc;
+}
@@ -67,6 +67,24 @@
 #define SAMPLING_RATE_BURST_OSR16	(44000)		// 44KSPS
 #define SAMPLING_RATE_BURST_OSR64	(14000)		// 14KSPS
 
+/* Min possible sampling rate in SPS (limited by usec resolution of the PWM
+ * period and the usec delay used for pacing burst capture) */
+#define MIN_SAMPLING_RATE			(1000)
+
+/* Max possible DAC buffer playback (update) rate in SPS. Each update writes all
+ * active DAC channels over SPI from the ticker interrupt, followed by an LDAC */
+#define MAX_DAC_UPDATE_RATE			(10000)
+
+/* Number of descriptors in the static descriptor pools (refer desc_pool.h).
+ * GPIOs: BUSY, CONV_INT and the LDAC/RESET/TGP/CONVST device GPIOs.
+ * IRQs: external and ticker interrupts */
+#define GPIO_DESC_POOL_SIZE			6
+#define SPI_DESC_POOL_SIZE			1
+#define UART_DESC_POOL_SIZE			1
+#define IRQ_DESC_POOL_SIZE			2
+#define PWM_DESC_POOL_SIZE			1
+#define TIMER_DESC_POOL_SIZE		1
+
 /******************************************************************************/
 /********************** Public/Extern Declarations ****************************/
 /******************************************************************************/
@@ -74,6 +92,7 @@
 extern mbed_uart_init_param mbed_uart_extra_init_params;
 extern mbed_spi_init_param mbed_spi_extra_init_params;
 extern mbed_irq_init_param mbed_ext_int_extra_init_params;
+extern mbed_irq_init_param mbed_ticker_int_extra_init_params;
 extern mbed_pwm_init_param mbed_pwm_extra_init_params;
 extern mbed_gpio_init_param mbed_ldac_gpio_extra_init_params;
 extern mbed_gpio_init_param mbed_reset_gpio_extra_init_params;
@@ -82,4 +101,12 @@ extern mbed_gpio_init_param mbed_convst_gpio_extra_init_params;
 extern mbed_gpio_init_param mbed_busy_gpio_extra_init_params;
 extern mbed_gpio_init_param mbed_conv_int_gpio_extra_init_params;
 
+struct irq_ctrl_desc;
+
+uint32_t mbed_get_time_ms(void);
+uint32_t mbed_get_time_us(void);
+int32_t mbed_set_ticker_period(struct irq_ctrl_desc *desc, uint32_t period_usec);
+uint32_t mbed_get_conv_trigger_cycles(void);
+uint32_t mbed_stream_crc32(const uint8_t *buf, uint32_t len);
+
 #endif /* APP_CONFIG_MBED_H_ */
@@ -0,0 +1,415 @@
+/***************************************************************************//**
+ *   @file    app_profile.c
+ *   @brief   Hot path execution time profiling
+ *   @details Timestamps are taken from the DWT cycle counter on Cortex-M
+ *            platforms (core clock ticks), or from the monotonic clock (nsec
+ *            ticks) when compiled natively on Linux. The probe overhead is
+ *            calibrated at init and subtracted from every record. The
+ *            conversion ISR entry latency histogram uses the same timestamp
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include "app_profile.h"
+#include "error.h"
+
+#if defined(PROFILE_TIMESTAMP)
+
+#if defined(__linux__)
+#include <time.h>
+#elif (ACTIVE_PLATFORM == ADUCM410_PLATFORM)
+#include "ADuCM410.h"
+#else
+#include "cmsis.h"
+#endif
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Number of empty probes timed to calibrate the probe overhead */
+#define PROFILE_CALIBRATION_COUNT	16
+
+/* Number of ISR latency histogram buckets (last bucket collects all the
+ * latencies beyond the histogram range) */
+#define LATENCY_BUCKET_COUNT		32
+
+/* Default width of an ISR latency histogram bucket in nsec */
+#define LATENCY_BUCKET_WIDTH_NSEC	250
+
+#define NSEC_PER_SEC				(1000000000ull)
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+#if defined(ENABLE_PROFILING)
+/* Execution time statistics of a probe (in timestamp ticks) */
+struct profile_stats {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+};
+
+/* Probe names, indexed by 'profile_probe_id' */
+static const char *profile_names[PROFILE_PROBE_COUNT] = {
+	[PROFILE_SPI_XFER] = "spi_write_and_read",
+	[PROFILE_CC_READ] = "ad70081z_cc_read",
+	[PROFILE_DATA_CAPTURE_ISR] = "data_capture_isr",
+	[PROFILE_BURST_CAPTURE] = "capture_burst_data",
+	[PROFILE_UART_WRITE] = "uart_write",
+	[PROFILE_ATTR_GET] = "attr_get",
+	[PROFILE_ATTR_SET] = "attr_set"
+};
+
+/* Probe statistics, indexed by 'profile_probe_id' */
+static volatile struct profile_stats profile_table[PROFILE_PROBE_COUNT];
+
+/* Probe overhead (in timestamp ticks) */
+static uint32_t profile_overhead;
+#endif
+
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+/* ISR entry latency histogram (latencies in timestamp ticks) */
+struct latency_histogram {
+	uint32_t bins[LATENCY_BUCKET_COUNT];
+	uint32_t count;
+	uint32_t max;
+	uint32_t overruns;
+};
+
+static volatile struct latency_histogram latency_hist;
+
+/* Histogram bucket width (in timestamp ticks) */
+static volatile uint32_t latency_bucket_width;
+
+/* Conversion trigger period (in timestamp ticks), 0 while not armed */
+static volatile uint32_t latency_period;
+
+/* Expected ISR entry timestamp of the next conversion trigger edge */
+static uint32_t latency_expected;
+
+/* Set once the expected entry is referenced to an actual ISR entry */
+static volatile bool latency_synced;
+#endif
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Get the profiling timestamp
+ * @return	Timestamp in ticks (wraps around at 2^32 ticks)
+ */
+uint32_t profile_timestamp(void)
+{
+#if defined(__linux__)
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec);
+#else
+	return DWT->CYCCNT;
+#endif
+}
+
+/*!
+ * @brief	Get the profiling timestamp frequency
+ * @return	Timestamp ticks per second
+ */
+static uint32_t profile_clock_hz(void)
+{
+#if defined(__linux__)
+	return NSEC_PER_SEC;
+#else
+	return SystemCoreClock;
+#endif
+}
+
+#if defined(ENABLE_PROFILING)
+/*!
+ * @brief	Record the execution time of a probe
+ * @param	id[in] - Probe ID
+ * @param	start[in] - Timestamp at start of probe
+ * @return	none
+ * @note	Statistics of a probe hit from both thread and interrupt context
+ *			are approximate, the table is not locked to keep probes cheap
+ */
+void profile_record(enum profile_probe_id id, uint32_t start)
+{
+	volatile struct profile_stats *stats = &profile_table[id];
+	uint32_t elapsed = profile_timestamp() - start;
+
+	elapsed = (elapsed > profile_overhead) ? (elapsed - profile_overhead) : 0;
+
+	if (!stats->count || elapsed < stats->min)
+		stats->min = elapsed;
+
+	if (elapsed > stats->max)
+		stats->max = elapsed;
+
+	stats->total += elapsed;
+	stats->count++;
+}
+
+/*!
+ * @brief	Reset the statistics of all probes
+ * @return	none
+ */
+void profile_reset(void)
+{
+	memset((void *)profile_table, 0, sizeof(profile_table));
+}
+#endif	// ENABLE_PROFILING
+
+/*!
+ * @brief	Initialize the profiling timestamp and calibrate probe overhead
+ * @return	none
+ */
+void profile_init(void)
+{
+#if defined(ENABLE_PROFILING)
+	uint32_t start;
+	uint32_t elapsed;
+#endif
+
+#if !defined(__linux__)
+	/* Enable the DWT cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+#if defined(ENABLE_PROFILING)
+	/* Overhead is the min time of an empty probe */
+	profile_overhead = 0;
+	profile_reset();
+	for (uint8_t cnt = 0; cnt < PROFILE_CALIBRATION_COUNT; cnt++) {
+		start = profile_timestamp();
+		profile_record(PROFILE_SPI_XFER, start);
+	}
+
+	elapsed = profile_table[PROFILE_SPI_XFER].min;
+	profile_reset();
+	profile_overhead = elapsed;
+#endif
+
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+	(void)profile_latency_set_bucket_width(LATENCY_BUCKET_WIDTH_NSEC);
+#endif
+}
+
+#if defined(ENABLE_PROFILING)
+/*!
+ * @brief	Print the statistics of all probes
+ * @param	buf[out] - Output string buffer
+ * @param	len[in] - Size of output buffer
+ * @return	Number of characters written in case of success, negative error
+ *			code otherwise
+ * @details	First line holds the timestamp frequency, followed by a line per
+ *			probe: name count min avg max (in timestamp ticks)
+ */
+int32_t profile_to_str(char *buf, uint32_t len)
+{
+	struct profile_stats stats;
+	uint32_t pos;
+	int ret;
+
+	if (!buf || !len)
+		return -EINVAL;
+
+	ret = snprintf(buf, len, "clock_hz %lu\n", (unsigned long)profile_clock_hz());
+	if (ret < 0 || (uint32_t)ret >= len)
+		return -ENOMEM;
+	pos = ret;
+
+	for (uint8_t id = 0; id < PROFILE_PROBE_COUNT; id++) {
+		/* Snapshot, so that a line is consistent with itself */
+		memcpy(&stats, (const void *)&profile_table[id], sizeof(stats));
+
+		ret = snprintf(buf + pos, len - pos, "%s %lu %lu %lu %lu\n",
+			       profile_names[id],
+			       (unsigned long)stats.count,
+			       (unsigned long)stats.min,
+			       (unsigned long)(stats.count ? stats.total / stats.count : 0),
+			       (unsigned long)stats.max);
+		if (ret < 0 || (uint32_t)ret >= len - pos)
+			return -ENOMEM;
+		pos += ret;
+	}
+
+	return pos;
+}
+#endif	// ENABLE_PROFILING
+
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+/*!
+ * @brief	Arm the ISR latency recording for a periodic conversion trigger
+ * @param	period[in] - Conversion trigger period in timestamp ticks, as
+ *			programmed into the trigger timer
+ * @return	none
+ * @note	The first ISR entry after arming is the timing reference, it is
+ *			not recorded
+ */
+void profile_latency_start(uint32_t period)
+{
+	latency_period = 0;
+	latency_synced = false;
+	latency_period = period;
+}
+
+/*!
+ * @brief	Disarm the ISR latency recording (histogram is retained)
+ * @return	none
+ */
+void profile_latency_stop(void)
+{
+	latency_period = 0;
+}
+
+/*!
+ * @brief	Record the ISR entry latency of the current conversion trigger
+ * @return	none
+ * @note	Must be the first statement of the conversion ISR. The trigger
+ *			edges are expected exactly one trigger period apart, so latency
+ *			is the delay of an ISR entry past its expected entry. Whenever an
+ *			entry is earlier than expected, the reference is moved to it, so
+ *			that the latency is relative to the fastest entry observed (i.e.
+ *			excluding the constant hardware interrupt entry latency). Trigger
+ *			edges lost while the ISR was held off for more than a period are
+ *			counted as overruns
+ */
+void profile_latency_record(void)
+{
+	uint32_t now = profile_timestamp();
+	uint32_t period = latency_period;
+	uint32_t latency;
+	uint32_t bucket;
+
+	if (!period)
+		return;
+
+	if (!latency_synced) {
+		latency_expected = now + period;
+		latency_synced = true;
+		return;
+	}
+
+	if ((int32_t)(now - latency_expected) < 0)
+		latency_expected = now;
+
+	latency = now - latency_expected;
+
+	bucket = latency / latency_bucket_width;
+	if (bucket >= LATENCY_BUCKET_COUNT)
+		bucket = LATENCY_BUCKET_COUNT - 1;
+
+	latency_hist.bins[bucket]++;
+	latency_hist.count++;
+	if (latency > latency_hist.max)
+		latency_hist.max = latency;
+
+	/* Trigger edges collapsed into this entry are lost */
+	latency_hist.overruns += latency / period;
+	latency_expected += ((latency / period) + 1) * period;
+}
+
+/*!
+ * @brief	Reset the ISR latency histogram
+ * @return	none
+ */
+void profile_latency_reset(void)
+{
+	memset((void *)&latency_hist, 0, sizeof(latency_hist));
+}
+
+/*!
+ * @brief	Set the ISR latency histogram bucket width (resets the histogram)
+ * @param	width_ns[in] - Bucket width in nsec
+ * @return	SUCCESS in case of success, negative error code otherwise
+ * @note	Width is rounded down to timestamp ticks (min 1 tick)
+ */
+int32_t profile_latency_set_bucket_width(uint32_t width_ns)
+{
+	uint32_t width;
+
+	if (!width_ns)
+		return -EINVAL;
+
+	width = (uint32_t)(((uint64_t)width_ns * profile_clock_hz()) / NSEC_PER_SEC);
+	latency_bucket_width = width ? width : 1;
+	profile_latency_reset();
+
+	return SUCCESS;
+}
+
+/*!
+ * @brief	Print the ISR latency histogram
+ * @param	buf[out] - Output string buffer
+ * @param	len[in] - Size of output buffer
+ * @return	Number of characters written in case of success, negative error
+ *			code otherwise
+ * @details	Header lines hold the timestamp frequency, bucket width, number
+ *			of recorded entries, max latency and overrun count (in timestamp
+ *			ticks), followed by a line per non empty bucket: lower bound of
+ *			the bucket (in timestamp ticks) and its count. The last bucket
+ *			also holds all the latencies beyond the histogram range
+ */
+int32_t profile_latency_to_str(char *buf, uint32_t len)
+{
+	struct latency_histogram hist;
+	uint32_t width = latency_bucket_width;
+	uint32_t pos;
+	int ret;
+
+	if (!buf || !len)
+		return -EINVAL;
+
+	/* Snapshot, so that the buckets add up to the count (but for an
+	 * interrupt in between) */
+	memcpy(&hist, (const void *)&latency_hist, sizeof(hist));
+
+	ret = snprintf(buf, len,
+		       "clock_hz %lu\nbucket_width %lu\ncount %lu\nmax %lu\noverruns %lu\n",
+		       (unsigned long)profile_clock_hz(),
+		       (unsigned long)width,
+		       (unsigned long)hist.count,
+		       (unsigned long)hist.max,
+		       (unsigned long)hist.overruns);
+	if (ret < 0 || (uint32_t)ret >= len)
+		return -ENOMEM;
+	pos = ret;
+
+	for (uint8_t bucket = 0; bucket < LATENCY_BUCKET_COUNT; bucket++) {
+		if (!hist.bins[bucket])
+			continue;
+
+		ret = snprintf(buf + pos, len - pos, "%lu %lu\n",
+			       (unsigned long)(bucket * width),
+			       (unsigned long)hist.bins[bucket]);
+		if (ret < 0 || (uint32_t)ret >= len - pos)
+			return -ENOMEM;
+		pos += ret;
+	}
+
+	return pos;
+}
+#endif	// ENABLE_ISR_LATENCY_HISTOGRAM
+
+#endif	// PROFILE_TIMESTAMP
@@ -0,0 +1,101 @@
+/*************************************************************************//**
+ *   @file   app_profile.h
+ *   @brief  Header for hot path execution time profiling
+ *   @details Probes placed around the hot path functions record the execution
+ *            time (in timestamp ticks) into a static min/max/avg table, which
+ *            is exported over IIO link through 'profile' debug attribute.
+ *            Probes compile to nothing unless ENABLE_PROFILING is defined.
+ *            The conversion interrupt entry latency histogram (exported
+ *            through 'isr_latency' debug attribute) is built only when
+ *            ENABLE_ISR_LATENCY_HISTOGRAM is defined
+******************************************************************************
+* Copyright (c) 2021 Analog Devices, Inc.
+*
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*****************************************************************************/
+
+#ifndef APP_PROFILE_H_
+#define APP_PROFILE_H_
+
+// Platform drivers using the probes may be built as C++
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "app_config.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Profiling timestamp is needed by the probes and by the latency histogram */
+#if defined(ENABLE_PROFILING) || defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+#define PROFILE_TIMESTAMP
+#endif
+
+#if defined(ENABLE_PROFILING)
+/* Start the probe (declares the start timestamp in current scope) */
+#define PROFILE_START(id)	uint32_t profile_start_##id = profile_timestamp()
+
+/* Stop the probe and record the elapsed time */
+#define PROFILE_STOP(id)	profile_record((id), profile_start_##id)
+#else
+#define PROFILE_START(id)
+#define PROFILE_STOP(id)
+#endif
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Profiled hot path functions */
+enum profile_probe_id {
+	PROFILE_SPI_XFER,
+	PROFILE_CC_READ,
+	PROFILE_DATA_CAPTURE_ISR,
+	PROFILE_BURST_CAPTURE,
+	PROFILE_UART_WRITE,
+	PROFILE_ATTR_GET,
+	PROFILE_ATTR_SET,
+	PROFILE_PROBE_COUNT
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+#if defined(PROFILE_TIMESTAMP)
+void profile_init(void);
+uint32_t profile_timestamp(void);
+#endif
+
+#if defined(ENABLE_PROFILING)
+void profile_record(enum profile_probe_id id, uint32_t start);
+void profile_reset(void);
+int32_t profile_to_str(char *buf, uint32_t len);
+#endif
+
+#if defined(ENABLE_ISR_LATENCY_HISTOGRAM)
+void profile_latency_start(uint32_t period);
+void profile_latency_stop(void);
+void profile_latency_record(void);
+void profile_latency_reset(void);
+int32_t profile_latency_set_bucket_width(uint32_t width_ns);
+int32_t profile_latency_to_str(char *buf, uint32_t len);
+#endif
+
+#ifdef __cplusplus // Closing extern c
+}
+#endif
+
+#endif /* APP_PROFILE_H_ */
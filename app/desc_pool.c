@@ -0,0 +1,78 @@
+/***************************************************************************//**
+ *   @file    desc_pool.c
+ *   @brief   Static descriptor pools
+ *   @details A descriptor is allocated from the first free slot of the pool
+ *            (zero initialized, like calloc) and returned to the pool by
+ *            freeing its slot
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "desc_pool.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*!
+ * @brief	Allocate a descriptor from the pool
+ * @param	pool[in,out] - Descriptor pool
+ * @return	Zero initialized descriptor, NULL if the pool is exhausted
+ */
+void *desc_pool_alloc(struct desc_pool *pool)
+{
+	uint8_t *desc;
+
+	if (!pool) {
+		return NULL;
+	}
+
+	for (uint32_t slot = 0; slot < pool->size; slot++) {
+		if (!(pool->used & (1UL << slot))) {
+			pool->used |= (1UL << slot);
+
+			desc = &pool->mem[slot * pool->desc_size];
+			memset(desc, 0, pool->desc_size);
+
+			return desc;
+		}
+	}
+
+	return NULL;
+}
+
+/*!
+ * @brief	Return a descriptor to the pool
+ * @param	pool[in,out] - Descriptor pool
+ * @param	desc[in] - Descriptor allocated by desc_pool_alloc() (NULL is
+ *			ignored, like free)
+ * @return	none
+ */
+void desc_pool_free(struct desc_pool *pool, void *desc)
+{
+	uint32_t offset;
+
+	if (!pool || !desc || (uint8_t *)desc < pool->mem) {
+		return;
+	}
+
+	offset = (uint32_t)((uint8_t *)desc - pool->mem);
+	if (offset % pool->desc_size ||
+	    offset / pool->desc_size >= pool->size) {
+		return;
+	}
+
+	pool->used &= ~(1UL << (offset / pool->desc_size));
+}
@@ -0,0 +1,76 @@
+/*************************************************************************//**
+ *   @file   desc_pool.h
+ *   @brief  Header for static descriptor pools
+ *   @details The platform and device drivers take their descriptors from
+ *            compile-time sized static pools instead of the heap, so that
+ *            the descriptor RAM is accounted for at link time and no heap
+ *            is needed for them. The pool sizes are set per platform in
+ *            app_config_<platform>.h for the descriptors requested by the
+ *            application. Pools are meant to be used from thread context
+ *            (init/remove) only
+******************************************************************************
+* Copyright (c) 2021 Analog Devices, Inc.
+*
+* All rights reserved.
+*
+* This software is proprietary to Analog Devices, Inc. and its licensors.
+* By using this software you agree to the terms of the associated
+* Analog Devices Software License Agreement.
+*****************************************************************************/
+
+#ifndef DESC_POOL_H_
+#define DESC_POOL_H_
+
+// Platform drivers using the pools may be built as C++
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "app_config.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Max number of descriptors in a pool (one bit each in the usage bitmap) */
+#define DESC_POOL_MAX_SIZE		32
+
+/* Define a static pool of 'size' descriptors of 'type' */
+#define DESC_POOL_DEFINE(name, type, size) \
+	extern char name##_size_check[((size) > 0 && \
+				       (size) <= DESC_POOL_MAX_SIZE) ? 1 : -1]; \
+	static type name##_mem[size]; \
+	static struct desc_pool name = { \
+		(uint8_t *)name##_mem, sizeof(type), (size), 0 \
+	}
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Static descriptor pool (refer DESC_POOL_DEFINE()) */
+struct desc_pool {
+	uint8_t *mem;			// Descriptors storage
+	uint32_t desc_size;		// Size of a descriptor in bytes
+	uint32_t size;			// Number of descriptors in the pool
+	uint32_t used;			// Bitmap of the allocated descriptors
+};
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+void *desc_pool_alloc(struct desc_pool *pool);
+void desc_pool_free(struct desc_pool *pool, void *desc);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif /* DESC_POOL_H_ */
@@ -28,6 +28,8 @@ extern "C"
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
+#define USEC_PER_MSEC	1000
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -39,10 +41,14 @@ extern "C"
  */
 void udelay(uint32_t usecs)
 {
-	/* wait_ns is more time efficient function compared to wait_us
-	 * Note: For higher values of delay (more than few msec), it is better to use
-	 * mdelay() function as no error/limit checking is done in this function */
-	wait_ns(usecs * 1000);
+	/* wait_ns is more time efficient function compared to wait_us, but is
+	 * a calibrated loop (and nsec count overflows beyond ~4sec), so longer
+	 * delays are timed on the us_ticker based wait_us instead */
+	if (usecs < USEC_PER_MSEC) {
+		wait_ns(usecs * 1000);
+	} else {
+		wait_us(usecs);
+	}
 }
 
 /**
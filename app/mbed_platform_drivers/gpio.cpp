@@ -17,6 +17,26 @@
 #include <stdlib.h>
 #include <mbed.h>
 
+/* Access to the (protected) HAL GPIO object of DigitalOut/DigitalIn, so that
+ * a fast GPIO pin uses the pin already configured through the descriptor */
+class DigitalOutHal : public DigitalOut
+{
+public:
+	static const gpio_t *get(const DigitalOut *out)
+	{
+		return &(out->*(&DigitalOutHal::gpio));
+	}
+};
+
+class DigitalInHal : public DigitalIn
+{
+public:
+	static const gpio_t *get(const DigitalIn *in)
+	{
+		return &(in->*(&DigitalInHal::gpio));
+	}
+};
+
 // Platform drivers needs to be C-compatible to work with other drivers
 #ifdef __cplusplus
 extern "C"
@@ -26,6 +46,16 @@ extern "C"
 #include "error.h"
 #include "gpio.h"
 #include "gpio_extra.h"
+#include "gpio_fast.h"
+#include "desc_pool.h"
+
+/******************************************************************************/
+/********************** Variables and User defined data types *****************/
+/******************************************************************************/
+
+/* Static pools of gpio descriptors */
+DESC_POOL_DEFINE(gpio_desc_pool, gpio_desc, GPIO_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(mbed_gpio_desc_pool, mbed_gpio_desc, GPIO_DESC_POOL_SIZE);
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -43,7 +73,7 @@ int32_t gpio_get(struct gpio_desc **desc, const struct gpio_init_param *param)
 
 	if (desc && param) {
 		// Create the gpio description object for the device
-		new_gpio = (gpio_desc *)calloc(1, sizeof(gpio_desc)) ;
+		new_gpio = (gpio_desc *)desc_pool_alloc(&gpio_desc_pool);
 		if (!new_gpio) {
 			goto err_new_gpio;
 		}
@@ -51,8 +81,8 @@ int32_t gpio_get(struct gpio_desc **desc, const struct gpio_init_param *param)
 		new_gpio->number = param->number;
 
 		// Create the gpio extra descriptor object to store extra mbed gpio info
-		mbed_gpio_desc *gpio_desc_extra = (mbed_gpio_desc *)calloc(1,
-						  sizeof(mbed_gpio_desc));
+		mbed_gpio_desc *gpio_desc_extra = (mbed_gpio_desc *)desc_pool_alloc(
+				&mbed_gpio_desc_pool);
 		if (!gpio_desc_extra) {
 			goto err_gpio_desc_extra;
 		}
@@ -73,7 +103,7 @@ int32_t gpio_get(struct gpio_desc **desc, const struct gpio_init_param *param)
 	}
 
 err_gpio_desc_extra:
-	free(new_gpio);
+	desc_pool_free(&gpio_desc_pool, new_gpio);
 err_new_gpio:
 	// Nothing to free
 
@@ -113,12 +143,10 @@ int32_t gpio_remove(struct gpio_desc *desc)
 		}
 
 		// Free the gpio extra descriptor object
-		if((mbed_gpio_desc *)(desc->extra)) {
-			free((mbed_gpio_desc *)(desc->extra));
-		}
+		desc_pool_free(&mbed_gpio_desc_pool, desc->extra);
 
 		// Free the gpio descriptor object
-		free(desc);
+		desc_pool_free(&gpio_desc_pool, desc);
 
 		return SUCCESS;
 	}
@@ -284,6 +312,48 @@ int32_t gpio_get_value(struct gpio_desc *desc, uint8_t *value)
 	return FAILURE;
 }
 
+/**
+ * @brief Cache the mbed HAL GPIO object of GPIO for fast access.
+ * @param pin - The fast GPIO pin.
+ * @param desc - The GPIO descriptor (configured with gpio_get() and
+ *               gpio_direction_input/output()).
+ * @return SUCCESS in case of success, FAILURE otherwise.
+ * @note The HAL object of the pin instance is copied, the pin is not
+ *       initialized again (which would glitch an output to input).
+ */
+int32_t gpio_fast_get(struct gpio_fast_pin *pin, struct gpio_desc *desc)
+{
+	mbed_gpio_desc *gpio_desc_extra;    // pointer to gpio desc extra parameters
+
+	if (!pin || !desc || !desc->extra) {
+		return FAILURE;
+	}
+
+	gpio_desc_extra = (mbed_gpio_desc *)(desc->extra);
+	if (!gpio_desc_extra->gpio_pin) {
+		return FAILURE;
+	}
+
+	if (gpio_desc_extra->direction == GPIO_OUT) {
+		pin->gpio = *DigitalOutHal::get((DigitalOut *)gpio_desc_extra->gpio_pin);
+	} else {
+		pin->gpio = *DigitalInHal::get((DigitalIn *)gpio_desc_extra->gpio_pin);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * @brief Convert the time to core clock cycles for gpio_fast_delay_cycles().
+ * @param ns - Time in nsec.
+ * @return Number of core clock cycles (rounded up).
+ */
+uint32_t gpio_fast_ns_to_cycles(uint32_t ns)
+{
+	return (uint32_t)(((uint64_t)ns * SystemCoreClock + 999999999ull) /
+			  1000000000ull);
+}
+
 #ifdef __cplusplus
 }
 #endif //  _cplusplus
@@ -0,0 +1,102 @@
+/***************************************************************************//**
+ *   @file     gpio_fast.h
+ *   @brief:   Fast GPIO pin access for mbed platform
+ *   @details: The mbed HAL GPIO object of an already configured GPIO (port
+ *             register addresses and pin mask) is cached once, so that the
+ *             pin is written/read through the inline HAL accessors (a single
+ *             store/masked load on STM32 targets), instead of the DigitalOut
+ *             and DigitalIn objects, for timing critical pulses
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef GPIO_FAST_H
+#define GPIO_FAST_H
+
+// Platform support needs to be C-compatible to work with other drivers
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio_api.h"
+#include "gpio.h"
+
+/******************************************************************************/
+/********************** Variables and User defined data types *****************/
+/******************************************************************************/
+
+/**
+* @struct gpio_fast_pin
+* @brief Cached mbed HAL GPIO object of a GPIO pin.
+*/
+struct gpio_fast_pin {
+	gpio_t gpio;		// mbed HAL GPIO object
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+int32_t gpio_fast_get(struct gpio_fast_pin *pin, struct gpio_desc *desc);
+uint32_t gpio_fast_ns_to_cycles(uint32_t ns);
+
+/**
+ * @brief Drive the fast GPIO pin high.
+ * @param pin - The fast GPIO pin.
+ * @return None.
+ */
+static inline void gpio_fast_set(struct gpio_fast_pin *pin)
+{
+	gpio_write(&pin->gpio, 1);
+}
+
+/**
+ * @brief Drive the fast GPIO pin low.
+ * @param pin - The fast GPIO pin.
+ * @return None.
+ */
+static inline void gpio_fast_clear(struct gpio_fast_pin *pin)
+{
+	gpio_write(&pin->gpio, 0);
+}
+
+/**
+ * @brief Read the fast GPIO pin.
+ * @param pin - The fast GPIO pin.
+ * @return true if pin is high, else false.
+ */
+static inline bool gpio_fast_read(struct gpio_fast_pin *pin)
+{
+	return gpio_read(&pin->gpio) != 0;
+}
+
+/**
+ * @brief Busy wait for at least the given number of core clock cycles.
+ * @param cycles - Number of core clock cycles (refer gpio_fast_ns_to_cycles()).
+ * @return None.
+ * @note Every loop iteration takes more than one cycle, so the wait is
+ *       never shorter than requested.
+ */
+static inline void gpio_fast_delay_cycles(uint32_t cycles)
+{
+	for (volatile uint32_t i = cycles; i; i--) {
+	}
+}
+
+#ifdef __cplusplus // Closing extern c
+}
+#endif
+
+#endif /* GPIO_FAST_H */
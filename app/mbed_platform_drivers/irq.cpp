@@ -27,6 +27,7 @@ extern "C"
 #include "irq.h"
 #include "irq_extra.h"
 #include "uart_extra.h"
+#include "desc_pool.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -55,6 +56,10 @@ typedef void(*mbed_callback_func)(void);
 /* Mbed irq callback structure variable */
 static mbed_irq_callback_desc mbed_irq_callbacks;
 
+/* Static pools of irq controller descriptors */
+DESC_POOL_DEFINE(irq_desc_pool, irq_ctrl_desc, IRQ_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(mbed_irq_desc_pool, mbed_irq_desc, IRQ_DESC_POOL_SIZE);
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -171,12 +176,12 @@ int32_t irq_ctrl_init(struct irq_ctrl_desc **desc,
 		return FAILURE;
 	}
 
-	irq_ctrl_desc *new_desc = (irq_ctrl_desc *)malloc(sizeof(irq_ctrl_desc));
+	irq_ctrl_desc *new_desc = (irq_ctrl_desc *)desc_pool_alloc(&irq_desc_pool);
 	if (!new_desc) {
 		goto err_new_desc;
 	}
 
-	new_mbed_desc = (mbed_irq_desc *)malloc(sizeof(mbed_irq_desc));
+	new_mbed_desc = (mbed_irq_desc *)desc_pool_alloc(&mbed_irq_desc_pool);
 	if (!new_mbed_desc) {
 		goto err_new_mbed_desc;
 	}
@@ -234,9 +239,9 @@ int32_t irq_ctrl_init(struct irq_ctrl_desc **desc,
 	return SUCCESS;
 
 err_interrupt:
-	free(new_mbed_desc);
+	desc_pool_free(&mbed_irq_desc_pool, new_mbed_desc);
 err_new_mbed_desc:
-	free(new_desc);
+	desc_pool_free(&irq_desc_pool, new_desc);
 err_new_desc:
 	// Nothing to free
 
@@ -267,11 +272,8 @@ int32_t irq_ctrl_remove(struct irq_ctrl_desc *desc)
 			return FAILURE;
 	}
 
-	if ((irq_ctrl_desc *)desc->extra) {
-		free((irq_ctrl_desc *)desc->extra);
-	}
-
-	free(desc);
+	desc_pool_free(&mbed_irq_desc_pool, desc->extra);
+	desc_pool_free(&irq_desc_pool, desc);
 
 	return SUCCESS;
 }
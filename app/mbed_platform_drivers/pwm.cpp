@@ -28,6 +28,7 @@ extern "C"
 #include "pwm.h"
 #include "gpio.h"
 #include "pwm_extra.h"
+#include "desc_pool.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -37,6 +38,10 @@ extern "C"
 /********************** Variables and User defined data types *****************/
 /******************************************************************************/
 
+/* Static pools of PWM descriptors */
+DESC_POOL_DEFINE(pwm_desc_pool, struct pwm_desc, PWM_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(mbed_pwm_desc_pool, struct mbed_pwm_desc, PWM_DESC_POOL_SIZE);
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -62,14 +67,15 @@ int32_t pwm_init(struct pwm_desc **desc,
 		return FAILURE;
 	}
 
-	/* Allocate memory for general PWM descriptor */
-	new_pwm_desc = (pwm_desc *)malloc(sizeof(pwm_desc));
+	/* Allocate general PWM descriptor from the static pool */
+	new_pwm_desc = (pwm_desc *)desc_pool_alloc(&pwm_desc_pool);
 	if (!new_pwm_desc) {
 		goto err_new_pwm_desc;
 	}
 
 	new_pwm_desc->id = param->id;	// PWM Id
 	new_pwm_desc->period_ns = param->period_ns;	// PWM period
+	new_pwm_desc->duty_cycle_ns = param->duty_cycle_ns;	// PWM duty cycle
 
 	/* Create and initialize Mbed PWM object */
 	pwm = new PwmOut((PinName)((mbed_pwm_init_param *)(param->extra))->pwm_pin);
@@ -77,8 +83,8 @@ int32_t pwm_init(struct pwm_desc **desc,
 		goto err_pwm;
 	}
 
-	/* Allocate memory for Mbed specific PWM descriptor for future use */
-	new_mbed_pwm_desc = (mbed_pwm_desc *)malloc(sizeof(mbed_pwm_desc));
+	/* Allocate Mbed specific PWM descriptor from the static pool */
+	new_mbed_pwm_desc = (mbed_pwm_desc *)desc_pool_alloc(&mbed_pwm_desc_pool);
 	if (!new_mbed_pwm_desc) {
 		goto err_new_mbed_pwm_desc;
 	}
@@ -98,7 +104,7 @@ int32_t pwm_init(struct pwm_desc **desc,
 err_new_mbed_pwm_desc:
 	free(pwm);
 err_pwm:
-	free(new_pwm_desc);
+	desc_pool_free(&pwm_desc_pool, new_pwm_desc);
 err_new_pwm_desc:
 	// Nothing to free
 
@@ -170,7 +176,103 @@ int32_t pwm_remove(struct pwm_desc *desc)
 		delete((mbed::PwmOut *)((mbed_pwm_desc *)desc->extra)->pwm_obj);
 	}
 
-	free(desc);
+	desc_pool_free(&mbed_pwm_desc_pool, desc->extra);
+	desc_pool_free(&pwm_desc_pool, desc);
+
+	return SUCCESS;
+}
+
+
+/**
+ * @brief	Set the PWM period (duty cycle ratio is retained)
+ * @param	desc[in, out] - Pointer where the configured instance is stored
+ * @param	period_ns[in] - PWM period in nsec
+ * @return	SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t pwm_set_period(struct pwm_desc *desc, uint32_t period_ns)
+{
+	mbed::PwmOut *pwm;
+	uint32_t duty_cycle_ns;
+
+	if (!desc || !desc->period_ns || !period_ns) {
+		return FAILURE;
+	}
+
+	pwm = (mbed::PwmOut *)(((mbed_pwm_desc *)desc->extra)->pwm_obj);
+	if (!pwm) {
+		return FAILURE;
+	}
+
+	duty_cycle_ns = (uint32_t)(((uint64_t)desc->duty_cycle_ns * period_ns) /
+				   desc->period_ns);
+
+	pwm->period_us(period_ns / 1000);			// Period in usec
+	pwm->pulsewidth_us(duty_cycle_ns / 1000);	// Duty cycle in usec
+
+	desc->period_ns = period_ns;
+	desc->duty_cycle_ns = duty_cycle_ns;
+
+	return SUCCESS;
+}
+
+
+/**
+ * @brief	Get the PWM period
+ * @param	desc[in] - Pointer where the configured instance is stored
+ * @param	period_ns[out] - PWM period in nsec
+ * @return	SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t pwm_get_period(struct pwm_desc *desc, uint32_t *period_ns)
+{
+	if (!desc || !period_ns) {
+		return FAILURE;
+	}
+
+	*period_ns = desc->period_ns;
+
+	return SUCCESS;
+}
+
+
+/**
+ * @brief	Set the PWM duty cycle
+ * @param	desc[in, out] - Pointer where the configured instance is stored
+ * @param	duty_cycle_ns[in] - PWM duty cycle (high time) in nsec
+ * @return	SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t pwm_set_duty_cycle(struct pwm_desc *desc, uint32_t duty_cycle_ns)
+{
+	mbed::PwmOut *pwm;
+
+	if (!desc || duty_cycle_ns > desc->period_ns) {
+		return FAILURE;
+	}
+
+	pwm = (mbed::PwmOut *)(((mbed_pwm_desc *)desc->extra)->pwm_obj);
+	if (!pwm) {
+		return FAILURE;
+	}
+
+	pwm->pulsewidth_us(duty_cycle_ns / 1000);	// Duty cycle in usec
+	desc->duty_cycle_ns = duty_cycle_ns;
+
+	return SUCCESS;
+}
+
+
+/**
+ * @brief	Get the PWM duty cycle
+ * @param	desc[in] - Pointer where the configured instance is stored
+ * @param	duty_cycle_ns[out] - PWM duty cycle (high time) in nsec
+ * @return	SUCCESS in case of success, FAILURE otherwise.
+ */
+int32_t pwm_get_duty_cycle(struct pwm_desc *desc, uint32_t *duty_cycle_ns)
+{
+	if (!desc || !duty_cycle_ns) {
+		return FAILURE;
+	}
+
+	*duty_cycle_ns = desc->duty_cycle_ns;
 
 	return SUCCESS;
 }
@@ -27,6 +27,7 @@ extern "C"
 #include "spi.h"
 #include "gpio.h"
 #include "spi_extra.h"
+#include "desc_pool.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -38,6 +39,10 @@ extern "C"
 /********************** Variables and User defined data types *****************/
 /******************************************************************************/
 
+/* Static pools of SPI descriptors */
+DESC_POOL_DEFINE(spi_desc_pool, spi_desc, SPI_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(mbed_spi_desc_pool, mbed_spi_desc, SPI_DESC_POOL_SIZE);
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -63,7 +68,7 @@ int32_t spi_init_noos(struct spi_desc **desc,
 
 	if ((desc) && (param) && (param->extra)) {
 		// Create the spi description object for the device
-		new_desc = (spi_desc *)malloc(sizeof(spi_desc));
+		new_desc = (spi_desc *)desc_pool_alloc(&spi_desc_pool);
 		if (!new_desc) {
 			goto err_new_desc;
 		}
@@ -73,7 +78,7 @@ int32_t spi_init_noos(struct spi_desc **desc,
 		new_desc->max_speed_hz = param->max_speed_hz;
 
 		// Create the SPI extra descriptor object to store new SPI instances
-		mbed_desc = (mbed_spi_desc *)malloc(sizeof(mbed_spi_desc));
+		mbed_desc = (mbed_spi_desc *)desc_pool_alloc(&mbed_spi_desc_pool);
 		if (!mbed_desc) {
 			goto err_mbed_desc;
 		}
@@ -137,9 +142,9 @@ err_spi:
 	}
 err_csb:
 	free(spi);
-	free(mbed_desc);
+	desc_pool_free(&mbed_spi_desc_pool, mbed_desc);
 err_mbed_desc:
-	free(new_desc);
+	desc_pool_free(&spi_desc_pool, new_desc);
 err_new_desc:
 	// Nothing to free
 
@@ -168,12 +173,10 @@ int32_t spi_remove(struct spi_desc *desc)
 		}
 
 		// Free the SPI extra descriptor object
-		if ((mbed_spi_desc *)(desc->extra)) {
-			free((mbed_spi_desc *)(desc->extra));
-		}
+		desc_pool_free(&mbed_spi_desc_pool, desc->extra);
 
 		// Free the SPI descriptor object
-		free(desc);
+		desc_pool_free(&spi_desc_pool, desc);
 
 		return SUCCESS;
 	}
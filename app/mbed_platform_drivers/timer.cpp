@@ -26,12 +26,17 @@ extern "C"
 #include "timer.h"
 #include "error.h"
 #include "timer_extra.h"
+#include "desc_pool.h"
 using namespace std::chrono;
 
 /*****************************************************************************/
 /******************** Variables and User Defined Data Types ******************/
 /*****************************************************************************/
 
+/* Static pools of timer descriptors */
+DESC_POOL_DEFINE(timer_desc_pool, timer_desc, TIMER_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(mbed_timer_desc_pool, mbed_timer_desc, TIMER_DESC_POOL_SIZE);
+
 /*****************************************************************************/
 /************************** Functions Declarations ***************************/
 /*****************************************************************************/
@@ -54,7 +59,7 @@ int32_t timer_init(struct timer_desc **desc,
 	mbed::Timer *timer;				// Pointer to new Timer instance
 
 	if (desc && param) {
-		new_timer = (timer_desc *)malloc(sizeof(timer_desc));
+		new_timer = (timer_desc *)desc_pool_alloc(&timer_desc_pool);
 		if (!new_timer) {
 			goto err_new_desc;
 		}
@@ -62,7 +67,7 @@ int32_t timer_init(struct timer_desc **desc,
 		new_timer->id = param->id;
 		new_timer->load_value = param->load_value;
 
-		mbed_desc = (mbed_timer_desc *)malloc(sizeof(mbed_timer_desc));
+		mbed_desc = (mbed_timer_desc *)desc_pool_alloc(&mbed_timer_desc_pool);
 		if (!mbed_desc) {
 			goto err_mbed_desc;
 		}
@@ -81,10 +86,9 @@ int32_t timer_init(struct timer_desc **desc,
 	return FAILURE;
 
 err_timer_instance:
-	free(mbed_desc);
-	free(new_timer);
+	desc_pool_free(&mbed_timer_desc_pool, mbed_desc);
 err_mbed_desc:
-	free(new_timer);
+	desc_pool_free(&timer_desc_pool, new_timer);
 err_new_desc:
 	// Nothing to free
 
@@ -149,11 +153,9 @@ int32_t timer_remove(struct timer_desc *desc)
 			delete((Timer *)(((mbed_timer_desc *)(desc->extra))->timer));
 		}
 		// Free the extra descriptor object
-		if ((mbed_timer_desc *)(desc->extra)) {
-			free((mbed_timer_desc *)(desc->extra));
-		}
+		desc_pool_free(&mbed_timer_desc_pool, desc->extra);
 		// Free the Timer descriptor
-		free(desc);
+		desc_pool_free(&timer_desc_pool, desc);
 
 		return SUCCESS;
 	}
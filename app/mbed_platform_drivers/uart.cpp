@@ -27,6 +27,8 @@ extern "C"
 #include "delay.h"
 #include "uart.h"
 #include "uart_extra.h"
+#include "app_profile.h"
+#include "desc_pool.h"
 
 /******************************************************************************/
 /************************ Macros/Constants ************************************/
@@ -35,6 +37,9 @@ extern "C"
 /* Max size for USB CDC packet during transmit/receive */
 #define USB_CDC_MAX_PACKET_SIZE		(64)
 
+/* Size of each of the two USB CDC transmit buffers */
+#define USB_CDC_TX_BUFFER_SIZE		(2048)
+
 /* Max allowed length of USB serial number in characters */
 #define USB_SERIAL_NUM_MAX_LENGTH	(100)
 
@@ -48,6 +53,22 @@ class platform_usbcdc :public USBCDC
 private:
 	uint8_t usb_iserial_descriptor[(USB_SERIAL_NUM_MAX_LENGTH * 2) + 2];
 
+	/* Double buffered transmit: one buffer is filled by uart_write() while the
+	 * other one is sent out in back to back bulk packets from USB interrupt */
+	uint8_t tx_buffer[2][USB_CDC_TX_BUFFER_SIZE];
+	volatile uint32_t tx_length[2];	// Bytes queued in buffer (0 = buffer free)
+	uint8_t tx_wr_indx;				// Buffer being filled
+	uint32_t tx_wr_length;			// Bytes filled in tx_wr_indx buffer
+	uint8_t tx_rd_indx;				// Buffer being sent
+	uint32_t tx_rd_offset;			// Bytes of tx_rd_indx buffer sent so far
+	uint32_t tx_last_packet_size;	// Size of last bulk packet sent
+
+	void start_tx_packet(void);
+	void commit_tx_buffer(void);
+
+protected:
+	virtual void data_tx();
+
 public :
 	/* Call parent class (USBCDC) constructor explicitly */
 	platform_usbcdc(bool connect_blocking, uint16_t vendor_id, uint16_t product_id,
@@ -57,6 +78,14 @@ public :
 		uint8_t usb_iserial_len;	// USB serial number length
 		uint8_t i, j = 0;
 
+		tx_length[0] = 0;
+		tx_length[1] = 0;
+		tx_wr_indx = 0;
+		tx_wr_length = 0;
+		tx_rd_indx = 0;
+		tx_rd_offset = 0;
+		tx_last_packet_size = 0;
+
 		usb_iserial_len = strlen(serial_number);
 		if (usb_iserial_len > USB_SERIAL_NUM_MAX_LENGTH) {
 			usb_iserial_len = USB_SERIAL_NUM_MAX_LENGTH;
@@ -82,8 +111,17 @@ public :
 	void change_terminal_connection(bool connect_status);
 	bool data_received(uint32_t rx_size);
 	bool data_transmited(void);
+	void queue_tx_data(const uint8_t *data, uint32_t size);
 };
 
+/******************************************************************************/
+/********************** Variables and User defined data types *****************/
+/******************************************************************************/
+
+/* Static pools of UART descriptors */
+DESC_POOL_DEFINE(uart_desc_pool, uart_desc, UART_DESC_POOL_SIZE);
+DESC_POOL_DEFINE(mbed_uart_desc_pool, mbed_uart_desc, UART_DESC_POOL_SIZE);
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -138,6 +176,135 @@ bool platform_usbcdc::data_transmited(void)
 }
 
 
+/**
+ * @brief  Send the next bulk packet of queued transmit data
+ * @note   Must be called with USB device locked and no transmit in progress
+ */
+void platform_usbcdc::start_tx_packet(void)
+{
+	uint32_t size;
+
+	/* Release the completely sent buffer and move on to the other one */
+	if (tx_length[tx_rd_indx] && (tx_rd_offset >= tx_length[tx_rd_indx])) {
+		tx_length[tx_rd_indx] = 0;
+		tx_rd_indx ^= 1;
+		tx_rd_offset = 0;
+	}
+
+	if (!tx_length[tx_rd_indx]) {
+		/* Nothing more to send. A transfer ending with a full size packet is
+		 * terminated with a zero length packet, so that host completes it */
+		if (tx_last_packet_size == USB_CDC_MAX_PACKET_SIZE) {
+			tx_last_packet_size = 0;
+			if (write_start(_bulk_in, tx_buffer[tx_rd_indx], 0)) {
+				_tx_in_progress = true;
+			}
+		}
+		return;
+	}
+
+	size = tx_length[tx_rd_indx] - tx_rd_offset;
+	if (size > USB_CDC_MAX_PACKET_SIZE) {
+		size = USB_CDC_MAX_PACKET_SIZE;
+	}
+
+	if (write_start(_bulk_in, &tx_buffer[tx_rd_indx][tx_rd_offset], size)) {
+		_tx_in_progress = true;
+		tx_rd_offset += size;
+		tx_last_packet_size = size;
+	}
+}
+
+
+/**
+ * @brief  USB bulk IN packet sent callback (called from USB interrupt)
+ */
+void platform_usbcdc::data_tx()
+{
+	start_tx_packet();
+}
+
+
+/**
+ * @brief  Queue the filled transmit buffer and switch to the other buffer
+ */
+void platform_usbcdc::commit_tx_buffer(void)
+{
+	lock();
+
+	tx_length[tx_wr_indx] = tx_wr_length;
+	if (!_tx_in_progress) {
+		start_tx_packet();
+	}
+
+	unlock();
+
+	tx_wr_indx ^= 1;
+	tx_wr_length = 0;
+}
+
+
+/**
+ * @brief  Queue the data for USB transmit
+ * @param  data[in] - Data to be transmitted
+ * @param  size[in] - Number of bytes to transmit
+ * @note   Returns once data is copied into transmit buffers, so that new data
+ *         can be acquired while previous data is being sent
+ */
+void platform_usbcdc::queue_tx_data(const uint8_t *data, uint32_t size)
+{
+	volatile uint32_t *wr_buffer_length;
+	uint32_t copy_size;
+
+	while (size) {
+		wr_buffer_length = &tx_length[tx_wr_indx];
+		while (*wr_buffer_length) {
+			/* Wait until buffer is sent out */
+		}
+
+		copy_size = USB_CDC_TX_BUFFER_SIZE - tx_wr_length;
+		if (copy_size > size) {
+			copy_size = size;
+		}
+
+		memcpy(&tx_buffer[tx_wr_indx][tx_wr_length], data, copy_size);
+		tx_wr_length += copy_size;
+		data += copy_size;
+		size -= copy_size;
+
+		if (tx_wr_length == USB_CDC_TX_BUFFER_SIZE) {
+			commit_tx_buffer();
+		}
+	}
+
+	/* Send the partly filled buffer without waiting for more data */
+	if (tx_wr_length) {
+		commit_tx_buffer();
+	}
+}
+
+
+/**
+ * @brief Copy the pushed back character (if any) into read buffer
+ * @param mbed_desc - mbed UART descriptor
+ * @param data - Read buffer
+ * @param bytes_number - Number of bytes requested
+ * @return Number of bytes copied (0 or 1)
+ */
+static uint32_t uart_read_push_back(mbed_uart_desc *mbed_desc, uint8_t *data,
+				    uint32_t bytes_number)
+{
+	if (!bytes_number || !mbed_desc->rx_push_back_valid) {
+		return 0;
+	}
+
+	data[0] = mbed_desc->rx_push_back;
+	mbed_desc->rx_push_back_valid = false;
+
+	return 1;
+}
+
+
 /**
  * @brief Read data from UART device.
  * @param desc - Instance of UART.
@@ -147,30 +314,41 @@ bool platform_usbcdc::data_transmited(void)
  */
 int32_t uart_read(struct uart_desc *desc, uint8_t *data, uint32_t bytes_number)
 {
-	uint8_t cnt;
-	mbed::UnbufferedSerial *uart;	// pointer to UnbufferedSerial/UART instance
+	uint32_t cnt;
+	ssize_t size_rd_uart;
+	mbed::BufferedSerial *uart;	// pointer to BufferedSerial/UART instance
 	platform_usbcdc *usb_cdc_dev;	// Pointer to usb cdc device class instance
 	uint32_t size_rd;
 
 	if (desc && data) {
 		if (((mbed_uart_desc *)(desc->extra))->uart_port) {
+			/* Return the pushed back character first */
+			cnt = uart_read_push_back((mbed_uart_desc *)desc->extra, data,
+						  bytes_number);
+
 			if (((mbed_uart_desc *)desc->extra)->virtual_com_enable) {
 				usb_cdc_dev = (platform_usbcdc *)((mbed_uart_desc *)(
 						desc->extra))->uart_port;
 
-				while (!usb_cdc_dev->data_received(bytes_number)) {
-					/* Wait until new data is available */
-				}
+				if (cnt < bytes_number) {
+					while (!usb_cdc_dev->data_received(bytes_number - cnt)) {
+						/* Wait until new data is available */
+					}
 
-				/* Change terminal connection status manually */
-				usb_cdc_dev->change_terminal_connection(true);
+					/* Change terminal connection status manually */
+					usb_cdc_dev->change_terminal_connection(true);
 
-				usb_cdc_dev->receive_nb(data, bytes_number, &size_rd);
+					usb_cdc_dev->receive_nb(data + cnt, bytes_number - cnt, &size_rd);
+				}
 			} else {
-				uart = (UnbufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port);
+				uart = (BufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port);
 
-				for (cnt = 0; cnt < bytes_number; cnt++) {
-					uart->read(data + cnt, 1);
+				/* Copy out of Rx ring buffer as many bytes as available in one go */
+				while (cnt < bytes_number) {
+					size_rd_uart = uart->read(data + cnt, bytes_number - cnt);
+					if (size_rd_uart > 0) {
+						cnt += size_rd_uart;
+					}
 				}
 			}
 
@@ -192,10 +370,11 @@ int32_t uart_read(struct uart_desc *desc, uint8_t *data, uint32_t bytes_number)
 int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
 		   uint32_t bytes_number)
 {
-	mbed::UnbufferedSerial *uart;	// pointer to UnbufferedSerial/UART instance
+	mbed::BufferedSerial *uart;	// pointer to BufferedSerial/UART instance
 	platform_usbcdc *usb_cdc_dev;	// Pointer to usb cdc device class instance
-	uint32_t d_sz;
-	uint32_t indx = 0;
+	int32_t ret = FAILURE;
+
+	PROFILE_START(PROFILE_UART_WRITE);
 
 	if (desc && data) {
 		if (((mbed_uart_desc *)(desc->extra))->uart_port) {
@@ -203,65 +382,74 @@ int32_t uart_write(struct uart_desc *desc, const uint8_t *data,
 				usb_cdc_dev = (platform_usbcdc *)((mbed_uart_desc *)(
 						desc->extra))->uart_port;
 
-				while (bytes_number) {
-					while (!usb_cdc_dev->data_transmited()) {
-						/* Wait until old data is transmitted */
-					}
-
-					/* Make sure packet size is less than max CDC packet size during data transmit */
-					d_sz = (bytes_number > (USB_CDC_MAX_PACKET_SIZE - 1)) ?
-					       (USB_CDC_MAX_PACKET_SIZE - 1) :
-					       bytes_number;
-
-					/* Change terminal connection status manually */
-					usb_cdc_dev->change_terminal_connection(true);
-
-					usb_cdc_dev->send_nb((uint8_t *)&data[indx], d_sz, &d_sz);
+				/* Change terminal connection status manually */
+				usb_cdc_dev->change_terminal_connection(true);
 
-					bytes_number -= d_sz;
-					indx += d_sz;
-				}
+				usb_cdc_dev->queue_tx_data(data, bytes_number);
 
-				return bytes_number;
+				ret = bytes_number;
 			} else {
-				uart = (UnbufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port);
-				return uart->write(data, bytes_number);
+				uart = (BufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port);
+
+				/* Blocks only while Tx ring buffer is full (drained by Tx interrupt) */
+				ret = uart->write(data, bytes_number);
 			}
 		}
 	}
 
-	return FAILURE;
+	PROFILE_STOP(PROFILE_UART_WRITE);
+	return ret;
 }
 
 
 /**
- * @brief Submit reading buffer to the UART driver.
+ * @brief Read the data already received by the UART driver.
  *
- * Buffer is used until bytes_number bytes are read.
+ * Returns without waiting, with up to bytes_number bytes from Rx ring buffer.
  * @param desc:	Descriptor of the UART device
  * @param data:	Buffer where data will be read
- * @param bytes_number:	Number of bytes to be read.
- * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ * @param bytes_number:	Max number of bytes to be read.
+ * @return Number of bytes read in case of success, \ref FAILURE otherwise.
  */
 int32_t uart_read_nonblocking(struct uart_desc *desc,
 			      uint8_t *data,
 			      uint32_t bytes_number)
 {
-	mbed::UnbufferedSerial *uart;		// pointer to UnbufferedSerial/UART instance
+	mbed::BufferedSerial *uart;		// pointer to BufferedSerial/UART instance
+	platform_usbcdc *usb_cdc_dev;	// Pointer to usb cdc device class instance
+	ssize_t size_rd_uart;
+	uint32_t size_rd = 0;
+	uint32_t cnt;
 
-	if (desc) {
+	if (desc && data) {
 		if (((mbed_uart_desc *)(desc->extra))->uart_port) {
-			uart = (UnbufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port);
+			/* Return the pushed back character first */
+			cnt = uart_read_push_back((mbed_uart_desc *)desc->extra, data,
+						  bytes_number);
+			if (cnt == bytes_number) {
+				return cnt;
+			}
 
-			if (data) {
-				for (size_t i = 0; i < bytes_number; i++) {
-					if (uart->readable() > 0) {
-						uart->read(&data[i], 1);
-					}
-				}
+			if (((mbed_uart_desc *)desc->extra)->virtual_com_enable) {
+				usb_cdc_dev = (platform_usbcdc *)((mbed_uart_desc *)(
+						desc->extra))->uart_port;
+
+				/* Copies only the data already received */
+				usb_cdc_dev->receive_nb(data + cnt, bytes_number - cnt, &size_rd);
+
+				return cnt + size_rd;
+			}
+
+			uart = (BufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port);
 
-				return bytes_number;
+			if (!uart->readable()) {
+				return cnt;
 			}
+
+			/* Data is available, so read does not block */
+			size_rd_uart = uart->read(data + cnt, bytes_number - cnt);
+
+			return cnt + ((size_rd_uart > 0) ? size_rd_uart : 0);
 		}
 	}
 
@@ -269,32 +457,56 @@ int32_t uart_read_nonblocking(struct uart_desc *desc,
 }
 
 
+/**
+ * @brief Push back a received character to the UART driver.
+ *
+ * The character is returned again by next read, so that a received character
+ * can be peeked before handing over the Rx stream to another reader.
+ * @param desc:	Descriptor of the UART device
+ * @param data:	Character to push back
+ * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ */
+int32_t mbed_uart_push_back(struct uart_desc *desc, uint8_t data)
+{
+	if (!desc || ((mbed_uart_desc *)desc->extra)->rx_push_back_valid) {
+		return FAILURE;
+	}
+
+	((mbed_uart_desc *)desc->extra)->rx_push_back = data;
+	((mbed_uart_desc *)desc->extra)->rx_push_back_valid = true;
+
+	return SUCCESS;
+}
+
+
 /**
  * @brief Submit writting buffer to the UART driver.
  *
- * Data from the buffer is sent over the UART, the function returns imediatly.
+ * Data is copied into Tx ring buffer (as much as fits) and sent over the
+ * UART from Tx interrupt, the function returns imediatly.
  * @param desc:	Descriptor of the UART device
  * @param data:	Buffer where data will be written
  * @param bytes_number:	Number of bytes to be written.
- * @return \ref SUCCESS in case of success, \ref FAILURE otherwise.
+ * @return Number of bytes written in case of success, \ref FAILURE otherwise.
  */
 int32_t uart_write_nonblocking(struct uart_desc *desc,
 			       const uint8_t *data,
 			       uint32_t bytes_number)
 {
-	mbed::UnbufferedSerial *uart;		// pointer to UnbufferedSerial/UART instance
+	mbed::BufferedSerial *uart;		// pointer to BufferedSerial/UART instance
+	ssize_t size_wr_uart;
 
-	if (desc) {
-		if (((mbed_uart_desc *)(desc->extra))->uart_port) {
-			uart = (UnbufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port);
+	if (desc && data) {
+		if (((mbed_uart_desc *)(desc->extra))->uart_port
+		    && !((mbed_uart_desc *)desc->extra)->virtual_com_enable) {
+			uart = (BufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port);
 
-			if (data) {
-				for (size_t i = 0; i < bytes_number; i++) {
-					uart->write(&data[i], 1);
-				}
+			uart->set_blocking(false);
+			size_wr_uart = uart->write(data, bytes_number);
+			uart->set_blocking(true);
 
-				return bytes_number;
-			}
+			/* -EAGAIN is returned when Tx ring buffer is full */
+			return (size_wr_uart > 0) ? size_wr_uart : 0;
 		}
 	}
 
@@ -310,14 +522,14 @@ int32_t uart_write_nonblocking(struct uart_desc *desc,
  */
 int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 {
-	mbed::UnbufferedSerial *uart;	// Pointer to new UnbufferedSerial/UART instance
+	mbed::BufferedSerial *uart;	// Pointer to new BufferedSerial/UART instance
 	platform_usbcdc *usb_cdc_dev;	// Pointer to usb cdc device class instance
 	mbed_uart_desc *mbed_desc;  	// Pointer to mbed uart descriptor
 	uart_desc *new_desc;			// UART new descriptor
 
 	if (desc && param && param->extra) {
 		// Create the UART description object for the device
-		new_desc = (uart_desc *)malloc(sizeof(uart_desc));
+		new_desc = (uart_desc *)desc_pool_alloc(&uart_desc_pool);
 		if (!new_desc) {
 			goto err_new_desc;
 		}
@@ -334,8 +546,9 @@ int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 				goto err_usb_cdc_dev;
 			}
 		} else {
-			// Create and configure a new instance of UnbufferedSerial/UART port
-			uart = new UnbufferedSerial(
+			// Create and configure a new instance of BufferedSerial/UART port.
+			// Data is moved between UART and Rx/Tx ring buffers from interrupt
+			uart = new BufferedSerial(
 				(PinName)(((mbed_uart_init_param *)param->extra)->uart_tx_pin),
 				(PinName)(((mbed_uart_init_param *)param->extra)->uart_rx_pin),
 				(int)param->baud_rate);
@@ -346,7 +559,7 @@ int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 		}
 
 		// Create a new mbed descriptor to store new UART instances
-		mbed_desc = (mbed_uart_desc *)malloc(sizeof(mbed_uart_desc));
+		mbed_desc = (mbed_uart_desc *)desc_pool_alloc(&mbed_uart_desc_pool);
 		if (!mbed_desc) {
 			goto err_mbed_desc;
 		}
@@ -358,11 +571,12 @@ int32_t uart_init(struct uart_desc **desc, struct uart_init_param *param)
 			usb_cdc_dev->connect();
 			mdelay(2000);
 		} else {
-			mbed_desc->uart_port = (UnbufferedSerial *)uart;
+			mbed_desc->uart_port = (BufferedSerial *)uart;
 		}
 
 		mbed_desc->virtual_com_enable = ((mbed_uart_init_param *)
 						 param->extra)->virtual_com_enable;
+		mbed_desc->rx_push_back_valid = false;
 		new_desc->extra = (mbed_uart_desc *)mbed_desc;
 		*desc = new_desc;
 
@@ -378,7 +592,7 @@ err_mbed_desc:
 	}
 err_uart:
 err_usb_cdc_dev:
-	free(new_desc);
+	desc_pool_free(&uart_desc_pool, new_desc);
 err_new_desc:
 	// Nothing to free
 
@@ -400,18 +614,16 @@ int32_t uart_remove(struct uart_desc *desc)
 				delete((platform_usbcdc *)(platform_usbcdc *)((mbed_uart_desc *)
 						desc->extra)->uart_port);
 		} else {
-			if ((UnbufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port)) {
-				delete((UnbufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port));
+			if ((BufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port)) {
+				delete((BufferedSerial *)(((mbed_uart_desc *)(desc->extra))->uart_port));
 			}
 		}
 
 		// Free the UART extra descriptor object
-		if ((mbed_uart_desc *)(desc->extra)) {
-			free((mbed_uart_desc *)(desc->extra));
-		}
+		desc_pool_free(&mbed_uart_desc_pool, desc->extra);
 
 		// Free the UART descriptor object
-		free(desc);
+		desc_pool_free(&uart_desc_pool, desc);
 
 		return SUCCESS;
 	}
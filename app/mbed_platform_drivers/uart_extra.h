@@ -23,6 +23,7 @@ extern "C"
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 /******************************************************************************/
@@ -33,6 +34,8 @@ extern "C"
 /********************** Variables and User defined data types *****************/
 /******************************************************************************/
 
+struct uart_desc;
+
 /*
  * Note: The structure members are not strongly typed, as this file is included
  *       in application specific '.c' files. The mbed code structure does not
@@ -63,12 +66,16 @@ typedef struct {
 	void *uart_port; 			/* UART port instance */
 	bool virtual_com_enable; 	/* Flag that enables the selection between
 								 * Virtual COM Port Or standard UART link */
+	bool rx_push_back_valid;	/* Flag indicating a pushed back Rx character */
+	uint8_t rx_push_back;		/* Pushed back Rx character (returned first) */
 } mbed_uart_desc;
 
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
 
+int32_t mbed_uart_push_back(struct uart_desc *desc, uint8_t data);
+
 
 #ifdef __cplusplus // Closing extern c
 }
@@ -0,0 +1,263 @@
+/***************************************************************************//**
+ *   @file    ad70081z_frame_decoder.c
+ *   @brief   Host side decoder for AD70081z framed (CRC protected) ADC stream
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ad70081z_frame_decoder.h"
+#include "ad70081z_stream_decoder.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+#define AD70081Z_FRAME_CRC32_POLY	0x04C11DB7
+#define AD70081Z_FRAME_CRC32_SEED	0xFFFFFFFF
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Get the 16-bit little endian field.
+ * @param buf - Pointer to field.
+ * @return Field value.
+ */
+static uint16_t get_le16(const uint8_t *buf)
+{
+	return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+/**
+ * @brief Get the 32-bit little endian field.
+ * @param buf - Pointer to field.
+ * @return Field value.
+ */
+static uint32_t get_le32(const uint8_t *buf)
+{
+	return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+	       ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/**
+ * @brief Calculate the frame CRC32.
+ * @param buf - Data buffer.
+ * @param len - Data length in bytes (multiple of 4).
+ * @return CRC32 of the little endian 32-bit words of buffer, fed MSB first.
+ */
+uint32_t ad70081z_frame_crc32(const uint8_t *buf, size_t len)
+{
+	uint32_t crc = AD70081Z_FRAME_CRC32_SEED;
+
+	for (size_t indx = 0; indx + 4 <= len; indx += 4) {
+		crc ^= get_le32(&buf[indx]);
+		for (uint8_t bit = 0; bit < 32; bit++)
+			crc = (crc & 0x80000000) ? ((crc << 1) ^ AD70081Z_FRAME_CRC32_POLY) :
+			      (crc << 1);
+	}
+
+	return crc;
+}
+
+/**
+ * @brief Initialize the frame decoder.
+ * @param dec - Frame decoder.
+ * @return none
+ */
+void ad70081z_frame_decoder_init(struct ad70081z_frame_decoder *dec)
+{
+	if (dec)
+		memset(dec, 0, sizeof(*dec));
+}
+
+/**
+ * @brief Count the channels enabled in channel mask.
+ * @param chn_mask - Channel mask.
+ * @return Number of channels.
+ */
+static uint8_t count_chns(uint32_t chn_mask)
+{
+	uint8_t count = 0;
+
+	for (; chn_mask; chn_mask &= chn_mask - 1)
+		count++;
+
+	return count;
+}
+
+/**
+ * @brief Decode the payload of a frame (CRC already verified).
+ * @param dec - Frame decoder.
+ * @param frame - Frame header fields (samples pointer is set on success).
+ * @param flags - Frame flags.
+ * @param payload - Frame payload.
+ * @param payload_bytes - Size of payload.
+ * @return true if payload is consistent with header, else false.
+ */
+static bool decode_payload(struct ad70081z_frame_decoder *dec,
+			   struct ad70081z_frame *frame, uint8_t flags,
+			   const uint8_t *payload, size_t payload_bytes)
+{
+	size_t raw_bytes = (size_t)frame->num_of_scans * frame->num_of_chns * 2;
+	int32_t scans;
+
+	if (!frame->num_of_chns || !frame->num_of_scans
+	    || frame->num_of_scans > AD70081Z_FRAME_MAX_SCANS)
+		return false;
+
+	if (flags & AD70081Z_FRAME_FLAG_COMPRESSED) {
+		scans = ad70081z_stream_decode(payload, payload_bytes, frame->num_of_chns,
+					       dec->samples, AD70081Z_FRAME_MAX_SCANS, NULL);
+		if (scans != frame->num_of_scans)
+			return false;
+	} else {
+		if (payload_bytes != raw_bytes)
+			return false;
+
+		for (size_t indx = 0; indx < raw_bytes / 2; indx++)
+			dec->samples[indx] = get_le16(&payload[indx * 2]);
+	}
+
+	frame->samples = dec->samples;
+
+	return true;
+}
+
+/**
+ * @brief Parse the frames from start of internal buffer.
+ * @param dec - Frame decoder.
+ * @param cb - Callback invoked for every good frame.
+ * @param ctx - Callback context.
+ * @return Number of good frames decoded.
+ * @note Bytes not starting a good frame are dropped one at a time, so that
+ *       a sync word inside a corrupted frame does not hide the next frame.
+ */
+static int32_t parse_frames(struct ad70081z_frame_decoder *dec,
+			    ad70081z_frame_cb cb, void *ctx)
+{
+	struct ad70081z_frame frame;
+	size_t payload_bytes;
+	size_t frame_bytes;
+	size_t pos = 0;
+	int32_t count = 0;
+	uint8_t *hdr;
+
+	while (dec->len - pos >= AD70081Z_FRAME_HEADER_SIZE) {
+		hdr = &dec->buf[pos];
+
+		if (get_le32(hdr) != AD70081Z_FRAME_SYNC) {
+			dec->bytes_skipped++;
+			pos++;
+			continue;
+		}
+
+		payload_bytes = get_le16(&hdr[6]);
+		frame_bytes = AD70081Z_FRAME_HEADER_SIZE + ((payload_bytes + 3) & ~(size_t)3)
+			      + AD70081Z_FRAME_CRC_SIZE;
+
+		if (frame_bytes > AD70081Z_FRAME_MAX_SIZE) {
+			dec->frames_bad++;
+			dec->bytes_skipped++;
+			pos++;
+			continue;
+		}
+
+		/* Wait for rest of the frame */
+		if (dec->len - pos < frame_bytes)
+			break;
+
+		frame.seq = get_le16(&hdr[4]);
+		frame.chn_mask = get_le32(&hdr[8]);
+		frame.num_of_chns = count_chns(frame.chn_mask);
+		frame.num_of_scans = hdr[12];
+		frame.scan_index = get_le32(&hdr[16]);
+
+		if (ad70081z_frame_crc32(hdr, frame_bytes - AD70081Z_FRAME_CRC_SIZE) !=
+		    get_le32(&hdr[frame_bytes - AD70081Z_FRAME_CRC_SIZE])
+		    || !decode_payload(dec, &frame, hdr[13],
+				       &hdr[AD70081Z_FRAME_HEADER_SIZE], payload_bytes)) {
+			dec->frames_bad++;
+			dec->bytes_skipped++;
+			pos++;
+			continue;
+		}
+
+		frame.lost_before = dec->synced ? (uint16_t)(frame.seq - dec->next_seq) : 0;
+		dec->frames_lost += frame.lost_before;
+
+		/* Scan index going back means a new capture (no scans lost) */
+		if (dec->synced && frame.scan_index > dec->next_scan_index)
+			frame.scans_lost_before = frame.scan_index - dec->next_scan_index;
+		else
+			frame.scans_lost_before = 0;
+		dec->scans_lost += frame.scans_lost_before;
+
+		dec->frames_ok++;
+		dec->next_seq = frame.seq + 1;
+		dec->next_scan_index = frame.scan_index + frame.num_of_scans;
+		dec->synced = true;
+		count++;
+
+		if (cb)
+			cb(ctx, &frame);
+
+		pos += frame_bytes;
+	}
+
+	dec->len -= pos;
+	memmove(dec->buf, &dec->buf[pos], dec->len);
+
+	return count;
+}
+
+/**
+ * @brief Feed the stream data into frame decoder.
+ * @param dec - Frame decoder.
+ * @param data - Stream data, any chunk size.
+ * @param size - Size of data in bytes.
+ * @param cb - Callback invoked for every good frame.
+ * @param ctx - Callback context.
+ * @return Number of good frames decoded from data in case of success,
+ *         negative error code otherwise.
+ */
+int32_t ad70081z_frame_decoder_feed(struct ad70081z_frame_decoder *dec,
+				    const uint8_t *data, size_t size,
+				    ad70081z_frame_cb cb, void *ctx)
+{
+	int32_t count = 0;
+	size_t chunk;
+
+	if (!dec || (!data && size))
+		return AD70081Z_FRAME_ERR_PARAM;
+
+	while (size) {
+		chunk = sizeof(dec->buf) - dec->len;
+		if (chunk > size)
+			chunk = size;
+
+		memcpy(&dec->buf[dec->len], data, chunk);
+		dec->len += chunk;
+		data += chunk;
+		size -= chunk;
+
+		/* Buffer holds a max size frame, so parsing always frees space */
+		count += parse_frames(dec, cb, ctx);
+	}
+
+	return count;
+}
@@ -0,0 +1,149 @@
+/***************************************************************************//**
+ *   @file   ad70081z_frame_decoder.h
+ *   @brief  Host side decoder for AD70081z framed (CRC protected) ADC stream
+ *   @details Parses the ADC IIO buffers read with 'stream_framing' enabled on
+ *            the device (refer app/ad70081z_stream_frame.h for the frame
+ *            format). The decoder is fed with the stream in chunks of any
+ *            size, verifies the CRC32 of every frame, counts the frames lost
+ *            from sequence number gaps and the scans lost from scan index
+ *            gaps, and resynchronises on the next sync word after a
+ *            corrupted frame. Plain C99, usable from C and C++ host code
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_FRAME_DECODER_H_
+#define _AD70081Z_FRAME_DECODER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Frame format constants (must match the device firmware) */
+#define AD70081Z_FRAME_SYNC					0xF5A5AD70
+#define AD70081Z_FRAME_HEADER_SIZE			20
+#define AD70081Z_FRAME_CRC_SIZE				4
+#define AD70081Z_FRAME_FLAG_COMPRESSED		0x01
+#define AD70081Z_FRAME_MAX_SCANS			32
+#define AD70081Z_FRAME_MAX_CHNS				32
+
+/* Max size of a frame (largest raw payload plus compressed block header) */
+#define AD70081Z_FRAME_MAX_SIZE	(AD70081Z_FRAME_HEADER_SIZE + \
+	AD70081Z_FRAME_MAX_SCANS * AD70081Z_FRAME_MAX_CHNS * 2 + 4 + \
+	AD70081Z_FRAME_CRC_SIZE)
+
+/* Decoder error codes */
+#define AD70081Z_FRAME_ERR_PARAM		(-1)	/* Invalid parameter */
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/**
+ * @struct ad70081z_frame
+ * @brief Decoded frame passed to the frame callback.
+ */
+struct ad70081z_frame {
+	/* Sequence number of frame */
+	uint16_t seq;
+	/* Frames lost (sequence gap) just before this frame */
+	uint32_t lost_before;
+	/* Index of first scan of frame, counted since capture start */
+	uint32_t scan_index;
+	/* Scans lost (scan index gap) just before this frame */
+	uint32_t scans_lost_before;
+	/* IIO buffer channel mask */
+	uint32_t chn_mask;
+	/* Number of channels (set bits of channel mask) */
+	uint8_t num_of_chns;
+	/* Number of scans (samples per channel) */
+	uint8_t num_of_scans;
+	/* Decoded 16-bit samples (interleaved channels) */
+	const uint16_t *samples;
+};
+
+/* Callback invoked for every good frame */
+typedef void (*ad70081z_frame_cb)(void *ctx, const struct ad70081z_frame *frame);
+
+/**
+ * @struct ad70081z_frame_decoder
+ * @brief Frame decoder state and statistics. Initialize with
+ *        ad70081z_frame_decoder_init() before use.
+ */
+struct ad70081z_frame_decoder {
+	/* Good frames decoded */
+	uint32_t frames_ok;
+	/* Frames lost, from sequence number gaps */
+	uint32_t frames_lost;
+	/* Scans lost, from scan index gaps (includes the scans of lost frames
+	 * and the scans dropped on device when the link falls behind) */
+	uint32_t scans_lost;
+	/* Candidate frames dropped on bad CRC, length or payload */
+	uint32_t frames_bad;
+	/* Bytes skipped while searching sync word (includes zero padding at
+	 * end of IIO buffers) */
+	uint32_t bytes_skipped;
+
+	/* Internal state */
+	bool synced;
+	uint16_t next_seq;
+	uint32_t next_scan_index;
+	size_t len;
+	uint8_t buf[AD70081Z_FRAME_MAX_SIZE];
+	uint16_t samples[AD70081Z_FRAME_MAX_SCANS * AD70081Z_FRAME_MAX_CHNS];
+};
+
+/**
+ * @brief Initialize the frame decoder.
+ * @param dec - Frame decoder.
+ * @return none
+ */
+void ad70081z_frame_decoder_init(struct ad70081z_frame_decoder *dec);
+
+/**
+ * @brief Feed the stream data into frame decoder.
+ * @param dec - Frame decoder.
+ * @param data - Stream data (e.g. ADC IIO buffer), any chunk size.
+ * @param size - Size of data in bytes.
+ * @param cb - Callback invoked for every good frame.
+ * @param ctx - Callback context.
+ * @return Number of good frames decoded from data in case of success,
+ *         negative error code otherwise.
+ * @note Incomplete frame at end of data is kept until next call.
+ */
+int32_t ad70081z_frame_decoder_feed(struct ad70081z_frame_decoder *dec,
+				    const uint8_t *data, size_t size,
+				    ad70081z_frame_cb cb, void *ctx);
+
+/**
+ * @brief Calculate the frame CRC32.
+ * @param buf - Data buffer.
+ * @param len - Data length in bytes (multiple of 4).
+ * @return CRC32 (poly 0x04C11DB7, seed 0xFFFFFFFF, no final xor) of the
+ *         little endian 32-bit words of buffer, fed MSB first.
+ */
+uint32_t ad70081z_frame_crc32(const uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AD70081Z_FRAME_DECODER_H_ */
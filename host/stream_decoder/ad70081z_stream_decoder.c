@@ -0,0 +1,210 @@
+/***************************************************************************//**
+ *   @file    ad70081z_stream_decoder.c
+ *   @brief   Host side decoder for AD70081z compressed ADC data stream
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ad70081z_stream_decoder.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/*
+ *@struct	bit_reader_t
+ *@details	Structure holding the state of MSB first bit stream reader
+ **/
+typedef struct {
+	const uint8_t *buf;
+	uint32_t max_bits;
+	uint32_t bit_pos;
+	bool overrun;
+} bit_reader_t;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Read the bits from bit stream.
+ * @param br - Bit stream reader.
+ * @param nbits - Number of bits to read (max 32).
+ * @return Bits value (right aligned).
+ */
+static uint32_t get_bits(bit_reader_t *br, uint8_t nbits)
+{
+	uint32_t val = 0;
+
+	if (br->bit_pos + nbits > br->max_bits) {
+		br->overrun = true;
+		return 0;
+	}
+
+	while (nbits--) {
+		val = (val << 1) |
+		      ((br->buf[br->bit_pos >> 3] >> (7 - (br->bit_pos & 0x7))) & 0x1);
+		br->bit_pos++;
+	}
+
+	return val;
+}
+
+/**
+ * @brief Map the zig-zag value back to signed delta.
+ * @param val - Zig-zag value.
+ * @return Signed delta.
+ */
+static int32_t zigzag_decode(uint32_t val)
+{
+	return (int32_t)(val >> 1) ^ -(int32_t)(val & 0x1);
+}
+
+/**
+ * @brief Decode the Rice coded payload of a block.
+ * @param payload - Block payload.
+ * @param payload_bytes - Size of payload.
+ * @param num_of_scans - Number of samples per channel in block.
+ * @param num_of_chns - Number of channels.
+ * @param samples - Decoded samples of block (interleaved channels).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t decode_block(const uint8_t *payload, uint32_t payload_bytes,
+			    uint8_t num_of_scans, uint8_t num_of_chns,
+			    uint16_t *samples)
+{
+	bit_reader_t br = {
+		.buf = payload,
+		.max_bits = payload_bytes * 8,
+		.bit_pos = 0,
+		.overrun = false
+	};
+	uint32_t prev;
+	uint32_t val;
+	uint32_t q;
+	uint8_t k;
+
+	for (uint8_t chn = 0; chn < num_of_chns; chn++) {
+		k = (uint8_t)get_bits(&br, AD70081Z_STREAM_RICE_K_BITS);
+		prev = get_bits(&br, 16);
+		samples[chn] = (uint16_t)prev;
+
+		for (uint8_t scan = 1; scan < num_of_scans; scan++) {
+			/* Unary coded quotient */
+			q = 0;
+			while (q < AD70081Z_STREAM_RICE_ESCAPE && get_bits(&br, 1)) {
+				q++;
+			}
+
+			if (q == AD70081Z_STREAM_RICE_ESCAPE) {
+				val = get_bits(&br, AD70081Z_STREAM_ZIGZAG_BITS);
+			} else {
+				val = (q << k) | get_bits(&br, k);
+			}
+
+			if (br.overrun) {
+				return AD70081Z_STREAM_ERR_CORRUPT;
+			}
+
+			prev = (uint32_t)((int32_t)prev + zigzag_decode(val));
+			samples[scan * num_of_chns + chn] = (uint16_t)prev;
+		}
+	}
+
+	return br.overrun ? AD70081Z_STREAM_ERR_CORRUPT : 0;
+}
+
+/**
+ * @brief Decode the compressed ADC IIO buffer.
+ * @param buf - Compressed buffer as read from the ADC IIO device.
+ * @param buf_size - Size of buffer in bytes.
+ * @param num_of_chns - Number of channels enabled in the IIO buffer.
+ * @param samples - Decoded 16-bit samples (interleaved channels).
+ * @param max_scans - Capacity of samples buffer in scans.
+ * @param gaps - Gaps found in the decoded data (NULL if not needed).
+ * @return Number of decoded scans in case of success, negative error code
+ *         otherwise.
+ */
+int32_t ad70081z_stream_decode(const uint8_t *buf, size_t buf_size,
+			       uint8_t num_of_chns, uint16_t *samples,
+			       uint32_t max_scans, struct ad70081z_stream_gaps *gaps)
+{
+	size_t pos = 0;
+	uint32_t scans = 0;
+	uint32_t payload_bytes;
+	uint32_t raw_bytes;
+	uint8_t num_of_scans;
+	uint8_t flags;
+	int32_t ret;
+
+	if (!buf || !samples || !num_of_chns) {
+		return AD70081Z_STREAM_ERR_PARAM;
+	}
+
+	if (gaps) {
+		gaps->count = 0;
+	}
+
+	while (pos + AD70081Z_STREAM_BLOCK_HEADER_SIZE <= buf_size) {
+		payload_bytes = (uint32_t)buf[pos] | ((uint32_t)buf[pos + 1] << 8);
+		num_of_scans = buf[pos + 2];
+		flags = buf[pos + 3];
+
+		/* Zero header terminates the block sequence */
+		if (!payload_bytes) {
+			break;
+		}
+
+		pos += AD70081Z_STREAM_BLOCK_HEADER_SIZE;
+		if (!num_of_scans || pos + payload_bytes > buf_size) {
+			return AD70081Z_STREAM_ERR_CORRUPT;
+		}
+
+		if (scans + num_of_scans > max_scans) {
+			return AD70081Z_STREAM_ERR_NO_SPACE;
+		}
+
+		if ((flags & AD70081Z_STREAM_BLOCK_FLAG_GAP) && gaps) {
+			if (gaps->count < AD70081Z_STREAM_MAX_GAPS) {
+				gaps->scan[gaps->count] = scans;
+			}
+			gaps->count++;
+		}
+
+		if (flags & AD70081Z_STREAM_BLOCK_FLAG_RAW) {
+			raw_bytes = (uint32_t)num_of_scans * num_of_chns * 2;
+			if (payload_bytes != raw_bytes) {
+				return AD70081Z_STREAM_ERR_CORRUPT;
+			}
+
+			for (uint32_t i = 0; i < raw_bytes / 2; i++) {
+				samples[scans * num_of_chns + i] =
+					(uint16_t)(buf[pos + 2 * i] | (buf[pos + 2 * i + 1] << 8));
+			}
+		} else {
+			ret = decode_block(&buf[pos], payload_bytes, num_of_scans, num_of_chns,
+					   &samples[scans * num_of_chns]);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		pos += payload_bytes;
+		scans += num_of_scans;
+	}
+
+	return (int32_t)scans;
+}
@@ -0,0 +1,90 @@
+/***************************************************************************//**
+ *   @file   ad70081z_stream_decoder.h
+ *   @brief  Host side decoder for AD70081z compressed ADC data stream
+ *   @details Decodes the ADC IIO buffer read with 'stream_compression'
+ *            enabled on the device (refer app/ad70081z_compress.h for the
+ *            stream format). Plain C99, usable from C and C++ host code
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_STREAM_DECODER_H_
+#define _AD70081Z_STREAM_DECODER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Stream format constants (must match the device firmware) */
+#define AD70081Z_STREAM_BLOCK_HEADER_SIZE	4
+#define AD70081Z_STREAM_BLOCK_FLAG_RAW		0x01
+#define AD70081Z_STREAM_BLOCK_FLAG_GAP		0x02
+#define AD70081Z_STREAM_RICE_ESCAPE			16
+#define AD70081Z_STREAM_RICE_K_BITS			4
+#define AD70081Z_STREAM_ZIGZAG_BITS			17
+
+/* Max number of gap positions reported per decoded buffer */
+#define AD70081Z_STREAM_MAX_GAPS			16
+
+/* Decoder error codes */
+#define AD70081Z_STREAM_ERR_PARAM		(-1)	/* Invalid parameter */
+#define AD70081Z_STREAM_ERR_CORRUPT		(-2)	/* Malformed block */
+#define AD70081Z_STREAM_ERR_NO_SPACE	(-3)	/* Output buffer too small */
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+/**
+ * @struct ad70081z_stream_gaps
+ * @brief Gaps in the decoded data, from the blocks flagged with
+ *        AD70081Z_STREAM_BLOCK_FLAG_GAP (scans lost on the device before
+ *        the block, also across buffer reads).
+ */
+struct ad70081z_stream_gaps {
+	/* Number of gaps */
+	uint32_t count;
+	/* Decoded scan (index in samples buffer) following every gap, for the
+	 * first AD70081Z_STREAM_MAX_GAPS gaps */
+	uint32_t scan[AD70081Z_STREAM_MAX_GAPS];
+};
+
+/**
+ * @brief Decode the compressed ADC IIO buffer.
+ * @param buf - Compressed buffer as read from the ADC IIO device.
+ * @param buf_size - Size of buffer in bytes.
+ * @param num_of_chns - Number of channels enabled in the IIO buffer.
+ * @param samples - Decoded 16-bit samples (interleaved channels, same order
+ *                  as an uncompressed IIO buffer).
+ * @param max_scans - Capacity of samples buffer in scans (samples per channel).
+ * @param gaps - Gaps found in the decoded data (NULL if not needed). The
+ *               samples on both sides of a gap are not continuous.
+ * @return Number of decoded scans in case of success, negative error code
+ *         otherwise.
+ */
+int32_t ad70081z_stream_decode(const uint8_t *buf, size_t buf_size,
+			       uint8_t num_of_chns, uint16_t *samples,
+			       uint32_t max_scans, struct ad70081z_stream_gaps *gaps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AD70081Z_STREAM_DECODER_H_ */
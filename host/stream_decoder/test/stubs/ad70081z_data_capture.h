@@ -0,0 +1,24 @@
+/***************************************************************************//**
+ *   @file   ad70081z_data_capture.h
+ *   @brief  Host test stand-in for the AD70081z data capture interface,
+ *           implemented by test/test_capture.c
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_DATA_CAPTURE_H_
+#define _AD70081Z_DATA_CAPTURE_H_
+
+#include <stdint.h>
+
+int32_t read_stream_data(uint16_t *pbuf, uint32_t nb_of_samples,
+			 uint32_t *scan_index);
+uint8_t get_num_of_active_channels(void);
+uint32_t get_active_channel_mask(void);
+
+#endif /* _AD70081Z_DATA_CAPTURE_H_ */
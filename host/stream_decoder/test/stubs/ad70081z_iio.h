@@ -0,0 +1,19 @@
+/***************************************************************************//**
+ *   @file   ad70081z_iio.h
+ *   @brief  Host test stand-in for the AD70081z IIO interface header
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _AD70081Z_IIO_H_
+#define _AD70081Z_IIO_H_
+
+/* Number of ADC IIO channels (same as app/ad70081z_iio.h) */
+#define ADC_CHN_COUNT		23
+
+#endif /* _AD70081Z_IIO_H_ */
@@ -0,0 +1,23 @@
+/***************************************************************************//**
+ *   @file   app_config.h
+ *   @brief  Host test stand-in for the application configurations
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef APP_CONFIG_H
+#define APP_CONFIG_H
+
+#include <stdint.h>
+
+/* Stream CRC32 of the platform (implemented by test/test_capture.c) */
+#define stream_crc32 test_stream_crc32
+
+uint32_t test_stream_crc32(const uint8_t *buf, uint32_t len);
+
+#endif /* APP_CONFIG_H */
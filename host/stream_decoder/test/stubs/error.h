@@ -0,0 +1,22 @@
+/***************************************************************************//**
+ *   @file   error.h
+ *   @brief  Host test stand-in for the no-OS error definitions used by the
+ *           firmware stream encoders
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef ERROR_H_
+#define ERROR_H_
+
+#define SUCCESS		0
+#define FAILURE		-1
+
+#define IS_ERR_VALUE(x)	((x) < 0)
+
+#endif /* ERROR_H_ */
@@ -0,0 +1,190 @@
+/***************************************************************************//**
+ *   @file    test_capture.c
+ *   @brief   Synthetic ADC capture source for the host decoder tests
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "test_capture.h"
+#include "ad70081z_data_capture.h"
+#include "app_config.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Number of failed checks */
+uint32_t test_failures;
+
+/* Channels of capture */
+static uint32_t capture_chn_mask;
+static uint8_t capture_num_of_chns;
+
+/* All channels are noise */
+static bool capture_noise;
+
+/* Index of next scan to be read */
+static uint32_t capture_scan_index;
+
+/* Scans dropped (as on device ring overrun) before the given read */
+static uint32_t capture_reads;
+static uint32_t capture_drop_at_read;
+static uint32_t capture_drop_scans;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Start a new capture.
+ * @param chn_mask - Channel mask (as IIO buffer channel mask).
+ * @param noise - true to capture noise on all channels.
+ * @return none
+ */
+void test_capture_start(uint32_t chn_mask, bool noise)
+{
+	capture_chn_mask = chn_mask;
+	capture_noise = noise;
+	capture_num_of_chns = 0;
+	for (; chn_mask; chn_mask &= chn_mask - 1)
+		capture_num_of_chns++;
+
+	capture_scan_index = 0;
+	capture_reads = 0;
+	capture_drop_scans = 0;
+}
+
+/**
+ * @brief Drop the scans before a read, as the device does when the reader
+ *        falls behind.
+ * @param after_reads - Number of reads (from now) before the scans are dropped.
+ * @param num_of_scans - Number of scans to drop.
+ * @return none
+ */
+void test_capture_drop_scans(uint32_t after_reads, uint32_t num_of_scans)
+{
+	capture_drop_at_read = capture_reads + after_reads;
+	capture_drop_scans = num_of_scans;
+}
+
+/**
+ * @brief Get the sample of a scan.
+ * @param scan_index - Index of scan since capture start.
+ * @param chn - Channel (index in active channels).
+ * @return Sample value.
+ * @note Channel 0 is a slow ramp (compresses well), channel 1 is noise
+ *       (does not compress) and the rest are a triangle of channel dependent
+ *       slope. With noise capture, all channels are noise.
+ */
+uint16_t test_capture_sample(uint32_t scan_index, uint8_t chn)
+{
+	uint32_t val;
+
+	if (capture_noise)
+		chn = 1;
+
+	switch (chn) {
+	case 0:
+		return (uint16_t)(0x8000 + scan_index / 4);
+
+	case 1:
+		val = scan_index * 2654435761u;
+		return (uint16_t)(val >> 16);
+
+	default:
+		val = (scan_index * (chn + 1) * 37) & 0x1FFFF;
+		return (uint16_t)((val > 0xFFFF) ? (0x1FFFF - val) : val);
+	}
+}
+
+/**
+ * @brief Read the scans of capture (firmware data capture interface).
+ * @param pbuf - Samples (interleaved channels).
+ * @param nb_of_samples - Number of scans to read.
+ * @param scan_index - Index of first scan read.
+ * @return 0 (success).
+ */
+int32_t read_stream_data(uint16_t *pbuf, uint32_t nb_of_samples,
+			 uint32_t *scan_index)
+{
+	if (capture_drop_scans && capture_reads == capture_drop_at_read) {
+		capture_scan_index += capture_drop_scans;
+		capture_drop_scans = 0;
+	}
+	capture_reads++;
+
+	*scan_index = capture_scan_index;
+
+	for (uint32_t scan = 0; scan < nb_of_samples; scan++) {
+		for (uint8_t chn = 0; chn < capture_num_of_chns; chn++)
+			*pbuf++ = test_capture_sample(capture_scan_index, chn);
+
+		capture_scan_index++;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the number of active channels (firmware data capture interface).
+ * @return Number of channels.
+ */
+uint8_t get_num_of_active_channels(void)
+{
+	return capture_num_of_chns;
+}
+
+/**
+ * @brief Get the active channel mask (firmware data capture interface).
+ * @return Channel mask.
+ */
+uint32_t get_active_channel_mask(void)
+{
+	return capture_chn_mask;
+}
+
+/**
+ * @brief Calculate the stream CRC32 (platform interface of firmware).
+ * @param buf - Data buffer.
+ * @param len - Data length in bytes (multiple of 4).
+ * @return CRC32 of the little endian 32-bit words of buffer, fed MSB first.
+ * @note Table driven byte-wise CRC, as on mbed platform, so that it is an
+ *       independent check of the bit-wise CRC of host decoder.
+ */
+uint32_t test_stream_crc32(const uint8_t *buf, uint32_t len)
+{
+	static uint32_t table[256];
+	static bool table_populated;
+	uint32_t crc = 0xFFFFFFFF;
+	uint32_t val;
+
+	if (!table_populated) {
+		for (uint32_t indx = 0; indx < 256; indx++) {
+			val = indx << 24;
+			for (uint8_t bit = 0; bit < 8; bit++)
+				val = (val & 0x80000000) ? ((val << 1) ^ 0x04C11DB7) : (val << 1);
+			table[indx] = val;
+		}
+		table_populated = true;
+	}
+
+	for (uint32_t indx = 0; indx + 4 <= len; indx += 4) {
+		for (int8_t byte = 3; byte >= 0; byte--)
+			crc = (crc << 8) ^ table[(crc >> 24) ^ buf[indx + byte]];
+	}
+
+	return crc;
+}
@@ -0,0 +1,50 @@
+/***************************************************************************//**
+ *   @file   test_capture.h
+ *   @brief  Synthetic ADC capture source for the host decoder tests
+ *   @details Stands in for the device data capture (read_stream_data() and
+ *            the active channel queries) when the firmware stream encoders
+ *            are built on the host, so that the encoded streams can be fed
+ *            into the host decoders and checked against the known samples
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+#ifndef _TEST_CAPTURE_H_
+#define _TEST_CAPTURE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Check the condition, report and count the failure */
+#define TEST_CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			test_failures++; \
+		} \
+	} while (0)
+
+/******************************************************************************/
+/************************ Public Declarations *********************************/
+/******************************************************************************/
+
+extern uint32_t test_failures;
+
+void test_capture_start(uint32_t chn_mask, bool noise);
+void test_capture_drop_scans(uint32_t after_reads, uint32_t num_of_scans);
+uint16_t test_capture_sample(uint32_t scan_index, uint8_t chn);
+
+#endif /* _TEST_CAPTURE_H_ */
@@ -0,0 +1,196 @@
+/***************************************************************************//**
+ *   @file    test_frame_decoder.c
+ *   @brief   Round trip test of the framed ADC stream
+ *   @details Encodes the synthetic capture with the firmware framing code
+ *            (app/ad70081z_stream_frame.c) and decodes it with the host
+ *            frame decoder, with raw and compressed payloads, scans lost on
+ *            device, corrupted frames and any feed chunk size
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_capture.h"
+#include "ad70081z_iio.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_compress.h"
+#include "ad70081z_stream_frame.h"
+#include "ad70081z_frame_decoder.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Number of scans requested per IIO buffer read */
+#define TEST_BUFFER_SCANS		256
+
+/* Number of IIO buffer reads per test */
+#define TEST_BUFFER_READS		4
+
+/******************************************************************************/
+/********************** Variables and User Defined Data Types *****************/
+/******************************************************************************/
+
+/* Frames received by callback */
+struct test_frames {
+	/* Channel mask of capture */
+	uint32_t chn_mask;
+	/* Number of frames and scans received */
+	uint32_t frames;
+	uint32_t scans;
+	/* Frames with scans lost before them */
+	uint32_t gaps;
+	/* Frames with mismatching header or samples */
+	uint32_t bad;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Check the decoded frame against the synthetic capture.
+ * @param ctx - Received frames (struct test_frames).
+ * @param frame - Decoded frame.
+ * @return none
+ */
+static void check_frame(void *ctx, const struct ad70081z_frame *frame)
+{
+	struct test_frames *rx = ctx;
+
+	rx->frames++;
+	rx->scans += frame->num_of_scans;
+	if (frame->scans_lost_before)
+		rx->gaps++;
+
+	if (frame->chn_mask != rx->chn_mask ||
+	    frame->num_of_chns != get_num_of_active_channels()) {
+		rx->bad++;
+		return;
+	}
+
+	for (uint32_t scan = 0; scan < frame->num_of_scans; scan++) {
+		for (uint8_t chn = 0; chn < frame->num_of_chns; chn++) {
+			if (frame->samples[scan * frame->num_of_chns + chn] !=
+			    test_capture_sample(frame->scan_index + scan, chn)) {
+				rx->bad++;
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Encode the IIO buffers with firmware and decode them on host.
+ * @param chn_mask - Channel mask.
+ * @param compress - true to compress the frame payload.
+ * @param drop_after_reads - Frame reads before the scans are dropped.
+ * @param drop_scans - Number of scans dropped (0 for none).
+ * @param chunk - Feed chunk size in bytes (0 for whole buffer).
+ * @return none
+ */
+static void test_round_trip(uint32_t chn_mask, bool compress,
+			    uint32_t drop_after_reads, uint32_t drop_scans,
+			    size_t chunk)
+{
+	static uint8_t buf[TEST_BUFFER_SCANS * ADC_CHN_COUNT * sizeof(uint16_t)];
+	static struct ad70081z_frame_decoder dec;
+	struct test_frames rx = { .chn_mask = chn_mask };
+	size_t buf_size;
+	size_t size;
+
+	set_stream_compression(compress);
+	set_stream_framing(false);
+	set_stream_framing(true);
+	test_capture_start(chn_mask, false);
+	test_capture_drop_scans(drop_after_reads, drop_scans);
+	ad70081z_frame_decoder_init(&dec);
+
+	buf_size = TEST_BUFFER_SCANS * get_num_of_active_channels() * sizeof(uint16_t);
+
+	for (uint8_t read = 0; read < TEST_BUFFER_READS; read++) {
+		TEST_CHECK(read_framed_data(buf, TEST_BUFFER_SCANS) == 0);
+
+		for (size_t pos = 0; pos < buf_size; pos += size) {
+			size = (chunk && chunk < buf_size - pos) ? chunk : buf_size - pos;
+			TEST_CHECK(ad70081z_frame_decoder_feed(&dec, &buf[pos], size,
+							       check_frame, &rx) >= 0);
+		}
+	}
+
+	TEST_CHECK(rx.frames > 0 && rx.frames == dec.frames_ok);
+	TEST_CHECK(rx.bad == 0);
+	TEST_CHECK(dec.frames_bad == 0);
+	TEST_CHECK(dec.frames_lost == 0);
+	TEST_CHECK(dec.scans_lost == drop_scans);
+	TEST_CHECK(rx.gaps == (drop_scans ? 1 : 0));
+}
+
+/**
+ * @brief Check that a corrupted frame is dropped and the decoder recovers
+ *        on the next frame, reporting the lost frame and its scans.
+ * @return none
+ */
+static void test_corrupted_frame(void)
+{
+	static uint8_t buf[TEST_BUFFER_SCANS * 3 * sizeof(uint16_t)];
+	static struct ad70081z_frame_decoder dec;
+	struct test_frames rx = { .chn_mask = 0x7 };
+	uint32_t frame_bytes;
+
+	set_stream_compression(false);
+	set_stream_framing(false);
+	set_stream_framing(true);
+	test_capture_start(0x7, false);
+	ad70081z_frame_decoder_init(&dec);
+
+	TEST_CHECK(read_framed_data(buf, TEST_BUFFER_SCANS) == 0);
+
+	/* Corrupt a sample of second frame (raw frames of max scans) */
+	frame_bytes = AD70081Z_FRAME_HEADER_SIZE + STREAM_FRAME_SCANS * 3 * 2 +
+		      AD70081Z_FRAME_CRC_SIZE;
+	buf[frame_bytes + AD70081Z_FRAME_HEADER_SIZE + 5] ^= 0x10;
+
+	TEST_CHECK(ad70081z_frame_decoder_feed(&dec, buf, sizeof(buf),
+					       check_frame, &rx) > 0);
+
+	TEST_CHECK(rx.bad == 0);
+	TEST_CHECK(dec.frames_bad >= 1);
+	TEST_CHECK(dec.frames_lost == 1);
+	TEST_CHECK(dec.scans_lost == STREAM_FRAME_SCANS);
+	TEST_CHECK(rx.gaps == 1);
+}
+
+int main(void)
+{
+	/* Raw frames */
+	test_round_trip(0x7, false, 0, 0, 0);
+	test_round_trip(0x7, false, 5, 123, 0);
+
+	/* Compressed frames */
+	test_round_trip(0x5, true, 0, 0, 0);
+	test_round_trip(0x5, true, 9, 40, 0);
+
+	/* Frames split over feed chunks */
+	test_round_trip(0x7, false, 3, 7, 7);
+	test_round_trip(0x5, true, 0, 0, 1);
+
+	test_corrupted_frame();
+
+	printf("%s: %s\n", __FILE__, test_failures ? "FAILED" : "passed");
+
+	return test_failures ? 1 : 0;
+}
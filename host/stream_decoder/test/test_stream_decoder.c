@@ -0,0 +1,156 @@
+/***************************************************************************//**
+ *   @file    test_stream_decoder.c
+ *   @brief   Round trip test of the compressed ADC stream
+ *   @details Encodes the synthetic capture with the firmware compression
+ *            code (app/ad70081z_compress.c) and decodes it with the host
+ *            stream decoder, including the blocks flagged after lost scans
+********************************************************************************
+ * Copyright (c) 2021 Analog Devices, Inc.
+ * All rights reserved.
+ *
+ * This software is proprietary to Analog Devices, Inc. and its licensors.
+ * By using this software you agree to the terms of the associated
+ * Analog Devices Software License Agreement.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_capture.h"
+#include "ad70081z_iio.h"
+#include "ad70081z_data_capture.h"
+#include "ad70081z_compress.h"
+#include "ad70081z_stream_decoder.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definition ***********************/
+/******************************************************************************/
+
+/* Number of scans requested per IIO buffer read */
+#define TEST_BUFFER_SCANS		256
+
+/* Max number of scans decoded from an IIO buffer (compressed buffer holds
+ * more scans than requested) */
+#define TEST_MAX_SCANS			(TEST_BUFFER_SCANS * 16)
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Encode an IIO buffer with firmware and decode it on host.
+ * @param chn_mask - Channel mask.
+ * @param drop_after_reads - Block reads before the scans are dropped.
+ * @param drop_scans - Number of scans dropped (0 for none).
+ * @param noise - true to capture noise (blocks are expected to be stored raw).
+ * @return none
+ */
+static void test_round_trip(uint32_t chn_mask, uint32_t drop_after_reads,
+			    uint32_t drop_scans, bool noise)
+{
+	static uint8_t buf[TEST_BUFFER_SCANS * ADC_CHN_COUNT * sizeof(uint16_t)];
+	static uint16_t samples[TEST_MAX_SCANS * ADC_CHN_COUNT];
+	struct ad70081z_stream_gaps gaps;
+	uint8_t num_of_chns;
+	uint32_t scan_index;
+	int32_t scans;
+
+	test_capture_start(chn_mask, noise);
+	test_capture_drop_scans(drop_after_reads, drop_scans);
+	num_of_chns = get_num_of_active_channels();
+
+	memset(buf, 0xFF, sizeof(buf));
+	TEST_CHECK(read_compressed_data(buf, TEST_BUFFER_SCANS) == 0);
+	TEST_CHECK(!(buf[3] & COMPRESS_BLOCK_FLAG_RAW) == !noise);
+
+	scans = ad70081z_stream_decode(buf, TEST_BUFFER_SCANS * num_of_chns * 2,
+				       num_of_chns, samples, TEST_MAX_SCANS, &gaps);
+	TEST_CHECK(scans > 0);
+	if (scans <= 0)
+		return;
+
+	if (drop_scans) {
+		TEST_CHECK(gaps.count == 1);
+		TEST_CHECK(gaps.scan[0] == drop_after_reads * COMPRESS_BLOCK_SCANS);
+	} else {
+		TEST_CHECK(gaps.count == 0);
+	}
+
+	for (uint32_t scan = 0; scan < (uint32_t)scans; scan++) {
+		scan_index = scan;
+		if (drop_scans && gaps.count && scan >= gaps.scan[0])
+			scan_index += drop_scans;
+
+		for (uint8_t chn = 0; chn < num_of_chns; chn++) {
+			if (samples[scan * num_of_chns + chn] !=
+			    test_capture_sample(scan_index, chn)) {
+				TEST_CHECK(false);
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Check that the scans lost in between two buffer reads are reported
+ *        on the first block of next buffer.
+ * @return none
+ */
+static void test_gap_across_buffers(void)
+{
+	static uint8_t buf[TEST_BUFFER_SCANS * 2 * sizeof(uint16_t)];
+	static uint16_t samples[TEST_MAX_SCANS * 2];
+	struct ad70081z_stream_gaps gaps;
+	int32_t scans;
+
+	/* Ramp and triangle channels */
+	test_capture_start(0x5, false);
+
+	TEST_CHECK(read_compressed_data(buf, TEST_BUFFER_SCANS) == 0);
+	scans = ad70081z_stream_decode(buf, sizeof(buf), 2, samples, TEST_MAX_SCANS,
+				       &gaps);
+	TEST_CHECK(scans > 0 && gaps.count == 0);
+
+	/* Next buffer continues with the following scan */
+	TEST_CHECK(read_compressed_data(buf, TEST_BUFFER_SCANS) == 0);
+	TEST_CHECK(ad70081z_stream_decode(buf, sizeof(buf), 2, samples,
+					  TEST_MAX_SCANS, &gaps) > 0);
+	TEST_CHECK(gaps.count == 0);
+	TEST_CHECK(samples[0] == test_capture_sample((uint32_t)scans, 0));
+
+	test_capture_drop_scans(0, 100);
+
+	TEST_CHECK(read_compressed_data(buf, TEST_BUFFER_SCANS) == 0);
+	TEST_CHECK(ad70081z_stream_decode(buf, sizeof(buf), 2, samples,
+					  TEST_MAX_SCANS, &gaps) > 0);
+	TEST_CHECK(gaps.count == 1 && gaps.scan[0] == 0);
+	TEST_CHECK(buf[3] & AD70081Z_STREAM_BLOCK_FLAG_GAP);
+}
+
+int main(void)
+{
+	set_stream_compression(true);
+
+	/* Ramp and triangle channels compress */
+	test_round_trip(0x5, 0, 0, false);
+	test_round_trip(0x5, 3, 57, false);
+
+	/* Noise does not compress, blocks are stored raw */
+	test_round_trip(0x7, 0, 0, true);
+	test_round_trip(0x7, 2, 1000, true);
+
+	/* Noise channel with compressible ones */
+	test_round_trip(0x7, 1, 5, false);
+
+	test_gap_across_buffers();
+
+	printf("%s: %s\n", __FILE__, test_failures ? "FAILED" : "passed");
+
+	return test_failures ? 1 : 0;
+}